@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug procstats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug procstats',6,'Syntax: .debug procstats [reset]
+Show how many auras proc events visited through the proc flag index compared to a full applied aura scan. Use reset to clear the counters.');
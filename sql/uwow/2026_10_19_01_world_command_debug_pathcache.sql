@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug pathcache';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug pathcache',6,'Syntax: .debug pathcache
+Show the path cache of your current map: cached paths, hit rate, and how many random movement paths were deferred to a later map update and how long they waited.');
@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug opcodestats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug opcodestats',6,'Syntax: .debug opcodestats [count|reset]
+Show the client opcode handlers that took the most time since startup (10 by default): calls, total time, average, p50/p99 and longest call. Use reset to clear the times.');
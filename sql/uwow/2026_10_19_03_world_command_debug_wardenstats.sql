@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug wardenstats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug wardenstats',6,'Syntax: .debug wardenstats [reset]
+Show how many Warden responses and checks of every type were verified since startup and the time spent on them. Use reset to clear the counters.');
@@ -0,0 +1,20 @@
+DELETE FROM `command` WHERE `name` IN ('debug packetlog','debug packetlog start','debug packetlog stop','debug packetlog status','debug packetlog addaccount','debug packetlog removeaccount','debug packetlog addopcode','debug packetlog removeopcode','debug packetlog clear');
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug packetlog',6,'Syntax: .debug packetlog $subcommand
+Type .debug packetlog to see the list of possible subcommands or .help debug packetlog $subcommand to see info on subcommands'),
+('debug packetlog start',6,'Syntax: .debug packetlog start [$file]
+Start capturing packets to $file in the logs directory, PacketLogFile or World.pkt by default.'),
+('debug packetlog stop',6,'Syntax: .debug packetlog stop
+Stop the packet capture and close the file.'),
+('debug packetlog status',6,'Syntax: .debug packetlog status
+Show the capture file, the written and dropped packets and the account and opcode filters.'),
+('debug packetlog addaccount',6,'Syntax: .debug packetlog addaccount [$account]
+Capture the packets of $account or of the selected player\'s account. Without any account in the filter all accounts are captured.'),
+('debug packetlog removeaccount',6,'Syntax: .debug packetlog removeaccount [$account]
+Remove $account or the selected player\'s account from the capture filter.'),
+('debug packetlog addopcode',6,'Syntax: .debug packetlog addopcode #opcode
+Capture the packets with #opcode (decimal or 0x hex). Without any opcode in the filter all opcodes are captured.'),
+('debug packetlog removeopcode',6,'Syntax: .debug packetlog removeopcode #opcode
+Remove #opcode from the capture filter.'),
+('debug packetlog clear',6,'Syntax: .debug packetlog clear
+Clear the account and opcode filters, so all packets are captured.');
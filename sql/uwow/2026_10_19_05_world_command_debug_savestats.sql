@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug savestats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug savestats',6,'Syntax: .debug savestats [reset]
+Show how many players were saved since startup, the average and longest time a save held the map thread, the time spent on the `characters` rows on the thread pool and the autosaves delayed by busy maps. Use reset to clear the counters.');
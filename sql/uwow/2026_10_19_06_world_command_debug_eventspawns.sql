@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug eventspawns';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug eventspawns',6,'Syntax: .debug eventspawns
+Show the game event creature and gameobject spawns and despawns queued to the maps since startup, how many were applied or skipped and how many are still pending.');
@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name`='debug scheduler';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug scheduler',6,'Syntax: .debug scheduler [reset]
+Show the periodic world work and the manager deadlines registered with the world scheduler, ordered by when they are due next, with how often they ran and their average, longest and last run times. With reset the run times are cleared.');
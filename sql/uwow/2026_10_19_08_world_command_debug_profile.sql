@@ -0,0 +1,14 @@
+DELETE FROM `command` WHERE `name` IN ('debug profile','debug profile start','debug profile stop','debug profile status','debug profile top','debug profile export');
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug profile',6,'Syntax: .debug profile $subcommand
+Type .debug profile to see the list of possible subcommands or .help debug profile $subcommand to see info on subcommands'),
+('debug profile start',6,'Syntax: .debug profile start
+Start timing the world and map updates with the scoped timers, the counters start from zero.'),
+('debug profile stop',6,'Syntax: .debug profile stop
+Stop the scoped timers, the counters are kept.'),
+('debug profile status',6,'Syntax: .debug profile status
+Show whether the profiler runs, the lag spikes seen, the last export and the 10 stacks that took the most time since the last export.'),
+('debug profile top',6,'Syntax: .debug profile top map|creature|spell|opcode [$count]
+Show the maps, creature entries, spells or opcodes that took the most time since the last export, 10 by default.'),
+('debug profile export',6,'Syntax: .debug profile export
+Write the counters since the last export as folded stacks for flamegraph tools to profile_<time>.folded in the logs directory, with the time per map, creature entry, spell and opcode in profile_<time>.txt, and start the counters over.');
@@ -0,0 +1,10 @@
+DELETE FROM `command` WHERE `name` IN ('debug bots','debug bots add','debug bots remove','debug bots report');
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug bots',6,'Syntax: .debug bots $subcommand
+Type .debug bots to see the list of possible subcommands or .help debug bots $subcommand to see info on subcommands'),
+('debug bots add',6,'Syntax: .debug bots add $count [idle|move|cast|aoe|chat|auction|mixed]
+Log in $count simulated players at your position and in your phases, mixed behaviours by default. The bots are created in memory and never saved.'),
+('debug bots remove',6,'Syntax: .debug bots remove [$count]
+Log out the last $count bots logged in, all of them without $count.'),
+('debug bots report',6,'Syntax: .debug bots report [reset]
+Show the bots logged in, the packets they sent, the percentiles of the world update times, the memory of the process and the maps that took the most time in the profiler. With reset the counters start over.');
@@ -0,0 +1,10 @@
+DELETE FROM `command` WHERE `name` IN ('debug replay','debug replay start','debug replay stop','debug replay status');
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug replay',6,'Syntax: .debug replay $subcommand
+Type .debug replay to see the list of possible subcommands or .help debug replay $subcommand to see info on subcommands'),
+('debug replay start',6,'Syntax: .debug replay start $capture [$speed] [$baseline]
+Replay the client packets of a packet log capture in the logs directory, at their recorded times multiplied by $speed (1.0 by default). The characters log in from the database and are never saved. The world update times and the heap are written to replay_<time>.txt in the logs directory when the replay ends, compared with the $baseline report of another build.'),
+('debug replay stop',6,'Syntax: .debug replay stop
+Log the replayed sessions out without a report.'),
+('debug replay status',6,'Syntax: .debug replay status
+Show the progress of the running replay or the last report written.');
@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name` = 'debug packetpool';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug packetpool',6,'Syntax: .debug packetpool [threads]
+Show the allocations of packet buffers since the start, how many came from the free lists of the threads or from the heap, and the blocks moved through the shared depot. With threads the counters of every thread are listed.');
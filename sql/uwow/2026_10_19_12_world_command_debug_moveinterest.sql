@@ -0,0 +1,4 @@
+DELETE FROM `command` WHERE `name` = 'debug moveinterest';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('debug moveinterest',6,'Syntax: .debug moveinterest
+Show the distance bands of the movement relays, how many relays were held back for distant players and replaced by newer ones since the start, and the relays and bytes saved per second over the last seconds.');
@@ -21,9 +21,12 @@
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
 
+#include <atomic>
+#include <chrono>
 #include <set>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 #include <boost/filesystem.hpp>
 
 using G3D::Vector3;
@@ -44,6 +47,40 @@ namespace VMAP
         return memcmp(dest, compare, len) == 0;
     }
 
+    // calls func(i) for every i in [0, count) spread over the given number of threads,
+    // func must only touch data of its own index so the results do not depend on the scheduling
+    template<class Func>
+    void parallelFor(uint32 count, uint32 threads, Func func)
+    {
+        if (!threads)
+            threads = std::thread::hardware_concurrency();
+        if (threads > count)
+            threads = count;
+
+        if (threads <= 1)
+        {
+            for (uint32 i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+
+        std::atomic<uint32> next(0);
+        auto worker = [&next, &func, count]()
+        {
+            for (uint32 i = next++; i < count; i = next++)
+                func(i);
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < threads; ++i)
+            workers.push_back(std::thread(worker));
+
+        worker();
+
+        for (std::thread& thread : workers)
+            thread.join();
+    }
+
     G3D::Vector3 ModelPosition::transform(Vector3 const& pIn) const
     {
         G3D::Vector3 out = pIn * iScale;
@@ -54,7 +91,7 @@ namespace VMAP
     //=================================================================
 
     TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(nullptr), iCurrentUniqueNameId(0)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iFilterMethod(nullptr), iCurrentUniqueNameId(0), iThreads(1)
     {
         boost::filesystem::create_directory(iDestDir);
         //init();
@@ -78,12 +115,26 @@ namespace VMAP
             std::vector<ModelSpawn*> mapSpawns;
             UniqueEntryMap::iterator entry;
             printf("Calculating model bounds for map %u...\n", map_iter->first);
+
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            // every spawn reads its own model, so the bounds are calculated in parallel and collected in spawn order below
+            std::vector<ModelSpawn*> m2Spawns;
+            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+                if (entry->second.flags & MOD_M2)
+                    m2Spawns.push_back(&entry->second);
+
+            std::vector<char> boundCalculated(m2Spawns.size(), 0);
+            parallelFor(m2Spawns.size(), iThreads, [this, &m2Spawns, &boundCalculated](uint32 i)
+            {
+                boundCalculated[i] = calculateTransformedBound(*m2Spawns[i]);
+            });
+
+            uint32 m2Index = 0;
             for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
                 if (entry->second.flags & MOD_M2)
                 {
-                    if (!calculateTransformedBound(entry->second))
+                    if (!boundCalculated[m2Index++])
                         break;
                 }
                 else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
@@ -186,16 +237,33 @@ namespace VMAP
         exportGameobjectModels();
         // export objects
         std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        // every model is written to its own .vmo file, the conversion order does not change the output
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::atomic<uint32> convertedModels(0);
+        std::atomic<bool> convertFailed(false);
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        parallelFor(modelFiles.size(), iThreads, [this, &modelFiles, &convertedModels, &convertFailed](uint32 i)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
+            if (convertFailed)
+                return;
+
+            printf("Converting %s\n", modelFiles[i].c_str());
+            if (!convertRawFile(modelFiles[i]))
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                printf("error converting %s\n", modelFiles[i].c_str());
+                convertFailed = true;
+                return;
             }
-        }
+
+            ++convertedModels;
+        });
+
+        if (convertFailed)
+            success = false;
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        printf("Converted %u of %u model files in %.1f s (%.1f files/s)\n", uint32(convertedModels), uint32(modelFiles.size()),
+            elapsed, elapsed > 0.0 ? convertedModels / elapsed : 0.0);
 
         //cleanup:
         for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
@@ -100,6 +100,7 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            uint32 iThreads;
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -112,6 +113,8 @@ namespace VMAP
 
             bool convertRawFile(const std::string& pModelFilename);
             void setModelNameFilterMethod(bool (*pFilterMethod)(char *pName)) { iFilterMethod = pFilterMethod; }
+            // number of threads calculating model bounds and converting model files, 0 - all hardware threads
+            void setThreads(uint32 pThreads) { iThreads = pThreads; }
             std::string getDirEntryNameFromModName(unsigned int pMapId, const std::string& pModPosName);
     };
 
@@ -173,6 +173,9 @@ Battleground::Battleground()
     m_LevelMax          = 0;
     m_InBGFreeSlotQueue = false;
     m_SetDeleteThis     = false;
+    m_UpdateCount       = 0;
+    m_UpdateTimeMax     = 0;
+    m_UpdateTimeTotal   = 0;
 
     m_MaxPlayersPerTeam = 0;
     m_MaxPlayers        = 0;
@@ -311,6 +314,19 @@ Battleground::~Battleground()
         delete itr->second;
 }
 
+void Battleground::TimedUpdate(uint32 diff)
+{
+    uint64 startTime = getUSTime();
+
+    Update(diff);
+
+    uint32 elapsed = uint32(getUSTime() - startTime);
+    ++m_UpdateCount;
+    m_UpdateTimeTotal += elapsed;
+    if (elapsed > m_UpdateTimeMax)
+        m_UpdateTimeMax = elapsed;
+}
+
 void Battleground::Update(uint32 diff)
 {
     if (!PreUpdateImpl(diff))
@@ -1616,6 +1632,7 @@ void Battleground::AddToBGFreeSlotQueue()
     // make sure to add only once
     if (!m_InBGFreeSlotQueue && isBattleground())
     {
+        std::lock_guard<std::mutex> guard(sBattlegroundMgr->BGFreeSlotQueueLock);
         sBattlegroundMgr->BGFreeSlotQueue[m_TypeID].push_front(this);
         m_InBGFreeSlotQueue = true;
     }
@@ -1626,6 +1643,7 @@ void Battleground::RemoveFromBGFreeSlotQueue()
 {
     // set to be able to re-add if needed
     m_InBGFreeSlotQueue = false;
+    std::lock_guard<std::mutex> guard(sBattlegroundMgr->BGFreeSlotQueueLock);
     // uncomment this code when battlegrounds will work like instances
     for (BGFreeSlotQueueType::iterator itr = sBattlegroundMgr->BGFreeSlotQueue[m_TypeID].begin(); itr != sBattlegroundMgr->BGFreeSlotQueue[m_TypeID].end(); ++itr)
     {
@@ -370,6 +370,12 @@ class Battleground
         virtual ~Battleground();
 
         void Update(uint32 diff);
+        // Update() wrapped with the timing below, called from BattlegroundMap::Update or from BattlegroundMgr before the map exists
+        void TimedUpdate(uint32 diff);
+
+        uint32 GetUpdateCount() const { return m_UpdateCount; }
+        uint32 GetMaxUpdateTime() const { return m_UpdateTimeMax; }
+        uint32 GetAvgUpdateTime() const { return m_UpdateCount ? uint32(m_UpdateTimeTotal / m_UpdateCount) : 0; }
 
         virtual bool SetupBattleground()                    // must be implemented in BG subclass
         {
@@ -703,6 +709,9 @@ class Battleground
         uint8  m_JoinType;                                 // 2=2v2, 3=3v3, 5=5v5
         bool   m_InBGFreeSlotQueue;                         // used to make sure that BG is only once inserted into the BattlegroundMgr.BGFreeSlotQueue[bgTypeId] deque
         bool   m_SetDeleteThis;                             // used for safe deletion of the bg after end / all players leave
+        uint32 m_UpdateCount;                               // number of TimedUpdate() calls
+        uint32 m_UpdateTimeMax;                             // slowest Update() in microseconds
+        uint64 m_UpdateTimeTotal;                           // sum of Update() times in microseconds
         bool   m_IsArena;
         bool   m_needFirstUpdateVision;
         bool   m_needSecondUpdateVision;
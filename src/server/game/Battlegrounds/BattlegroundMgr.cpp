@@ -96,6 +96,8 @@ void BattlegroundMgr::DeleteAllBattlegrounds()
 }
 
 // used to update running battlegrounds, and delete finished ones
+// battlegrounds with a map are updated by BattlegroundMap::Update on the map threads,
+// here only the ones still waiting for their first player are driven
 void BattlegroundMgr::Update(uint32 diff)
 {
     BattlegroundSet::iterator itr, next;
@@ -109,12 +111,15 @@ void BattlegroundMgr::Update(uint32 diff)
         {
             next = itr;
             ++next;
-            itr->second->Update(diff);
+            if (!itr->second->GetBgMap())
+                itr->second->TimedUpdate(diff);
             // use the SetDeleteThis variable
             // direct deletion caused crashes
             if (itr->second->ToBeDeleted())
             {
                 Battleground* bg = itr->second;
+                TC_LOG_DEBUG("bg", "BattlegroundMgr: battleground %u (type %u) closed, %u updates, avg %u us, max %u us",
+                    bg->GetInstanceID(), bg->GetTypeID(), bg->GetUpdateCount(), bg->GetAvgUpdateTime(), bg->GetMaxUpdateTime());
                 m_Battlegrounds[i].erase(itr);
                 if (!m_ClientBattlegroundIds[i][bg->GetBracketId()].empty())
                     m_ClientBattlegroundIds[i][bg->GetBracketId()].erase(bg->GetClientInstanceID());
@@ -129,15 +134,15 @@ void BattlegroundMgr::Update(uint32 diff)
         m_BattlegroundQueues[qtype].UpdateEvents(diff);
 
     // update scheduled queues
-    if (!m_QueueUpdateScheduler.empty())
+    std::vector<QueueSchedulerItem*> scheduled;
+    {
+        //take the vector and leave the other empty
+        std::lock_guard<std::mutex> guard(m_QueueUpdateSchedulerLock);
+        scheduled.swap(m_QueueUpdateScheduler);
+    }
+
+    if (!scheduled.empty())
     {
-        std::vector<QueueSchedulerItem*> scheduled;
-        {
-            //copy vector and clear the other
-            scheduled = std::vector<QueueSchedulerItem*>(m_QueueUpdateScheduler);
-            m_QueueUpdateScheduler.clear();
-            //release lock
-        }
 
         for (uint8 i = 0; i < scheduled.size(); i++)
         {
@@ -1440,7 +1445,8 @@ void BattlegroundMgr::FillHolidayWorldStates(WorldPacket &data)
 
 void BattlegroundMgr::ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 arenaType, BattlegroundQueueTypeId bgQueueTypeId, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id)
 {
-    //This method must be atomic, TODO add mutex
+    //This method must be atomic, battlegrounds and sessions call it from the map threads
+    std::lock_guard<std::mutex> guard(m_QueueUpdateSchedulerLock);
     //we will use only 1 number created of bgTypeId and bracket_id
     QueueSchedulerItem* schedule_id = new QueueSchedulerItem(arenaMatchmakerRating, arenaType, bgQueueTypeId, bgTypeId, bracket_id);
     bool found = false;
@@ -25,6 +25,7 @@
 #include "BattlegroundQueue.h"
 #include "Object.h"
 #include <ace/Singleton.h>
+#include <mutex>
 
 typedef std::map<uint32, Battleground*> BattlegroundSet;
 
@@ -136,6 +137,8 @@ class BattlegroundMgr
         BattlegroundQueue m_BattlegroundQueues[MAX_BATTLEGROUND_QUEUE_TYPES]; // public, because we need to access them in BG handler code
 
         BGFreeSlotQueueType BGFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID];
+        // battlegrounds are updated by their maps, so several map threads may add or remove free slot entries at once
+        std::mutex BGFreeSlotQueueLock;
 
         void ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 arenaType, BattlegroundQueueTypeId bgQueueTypeId, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id);
         uint32 GetMaxRatingDifference() const;
@@ -182,6 +185,7 @@ class BattlegroundMgr
         BattlegroundSelectionWeightMap m_ArenaSelectionWeights;
         BattlegroundSelectionWeightMap m_BGSelectionWeights;
         std::vector<QueueSchedulerItem*> m_QueueUpdateScheduler;
+        std::mutex m_QueueUpdateSchedulerLock;
         std::set<uint32> m_ClientBattlegroundIds[MAX_BATTLEGROUND_TYPE_ID][MAX_BATTLEGROUND_BRACKETS]; //the instanceids just visible for the client
         uint32 m_NextRatedArenaUpdate;
         bool   m_ArenaTesting;
@@ -54,6 +54,7 @@ void BracketMgr::LoadCharacterBrackets()
 
 Bracket* BracketMgr::TryGetOrCreateBracket(uint64 guid, BracketType bType)
 {
+    std::lock_guard<std::mutex> guard(m_lock);
     BracketContainer::iterator itr = m_conteiner.find(guid);
     if (itr == m_conteiner.end())
     {
@@ -76,6 +77,7 @@ Bracket* BracketMgr::TryGetOrCreateBracket(uint64 guid, BracketType bType)
 
 void BracketMgr::DeleteBracketInfo(uint64 guid)
 {
+    std::lock_guard<std::mutex> guard(m_lock);
     BracketContainer::iterator itr = m_conteiner.find(guid);
     if (itr == m_conteiner.end())
         return;
@@ -7,6 +7,7 @@ uwow.biz
 
 #include "Bracket.h"
 #include "Player.h"
+#include <mutex>
 
 class BracketMgr
 {
@@ -24,6 +25,7 @@ class BracketMgr
 
     private:
         BracketContainer m_conteiner;
+        std::mutex m_lock;                                  // brackets of offline players are created from the battleground map threads
 };
 
 #define sBracketMgr ACE_Singleton<BracketMgr, ACE_Null_Mutex>::instance()
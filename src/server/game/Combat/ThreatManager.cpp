@@ -261,6 +261,41 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iThreatIndex.clear();
+    iChangedRefs.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatIndex[hostileRef->getUnitGuid()] = iThreatList.insert(iThreatList.end(), hostileRef);
+    iChangedRefs.insert(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    ThreatListIndex::iterator itr = iThreatIndex.find(hostileRef->getUnitGuid());
+    if (itr != iThreatIndex.end() && *itr->second == hostileRef)
+    {
+        iThreatList.erase(itr->second);
+        iThreatIndex.erase(itr);
+    }
+    else
+        iThreatList.remove(hostileRef);
+
+    iChangedRefs.erase(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::setChanged(HostileReference* hostileRef)
+{
+    ThreatListIndex::const_iterator itr = iThreatIndex.find(hostileRef->getUnitGuid());
+    if (itr != iThreatIndex.end() && *itr->second == hostileRef)
+        iChangedRefs.insert(hostileRef);
 }
 
 //============================================================
@@ -270,12 +305,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return NULL;
 
-    uint64 guid = victim->GetGUID();
-    for (std::list<HostileReference*>::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i) && (*i)->getUnitGuid() == guid)
-            return (*i);
-
-    return NULL;
+    ThreatListIndex::const_iterator itr = iThreatIndex.find(victim->GetGUID());
+    return itr != iThreatIndex.end() ? *itr->second : NULL;
 }
 
 //============================================================
@@ -302,10 +333,26 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+    if (!iDirty)
+        return;
 
     iDirty = false;
+    if (iChangedRefs.empty())
+        return;
+
+    // Only changed refs can be out of place: pull them out, sort them and merge them back
+    // list iterators stay valid across splice and merge, so the index doesn't need to be touched
+    std::list<HostileReference*> changed;
+    for (std::unordered_set<HostileReference*>::const_iterator itr = iChangedRefs.begin(); itr != iChangedRefs.end(); ++itr)
+    {
+        ThreatListIndex::const_iterator itIndex = iThreatIndex.find((*itr)->getUnitGuid());
+        if (itIndex != iThreatIndex.end() && *itIndex->second == *itr)
+            changed.splice(changed.end(), iThreatList, itIndex->second);
+    }
+    iChangedRefs.clear();
+
+    changed.sort(Trinity::ThreatOrderPred());
+    iThreatList.merge(changed, Trinity::ThreatOrderPred());
 }
 
 //============================================================
@@ -391,7 +438,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
 //=================== ThreatManager ==========================
 //============================================================
 
-ThreatManager::ThreatManager(Unit* owner) : iCurrentVictim(NULL), iOwner(owner), iUpdateTimer(THREAT_UPDATE_INTERVAL)
+ThreatManager::ThreatManager(Unit* owner) : iCurrentVictim(NULL), iOwner(owner), iUpdateTimer(THREAT_UPDATE_INTERVAL), iClientUpdateNeeded(false)
 {
 }
 
@@ -403,6 +450,7 @@ void ThreatManager::clearReferences()
     iThreatOfflineContainer.clearReferences();
     iCurrentVictim = NULL;
     iUpdateTimer = THREAT_UPDATE_INTERVAL;
+    iClientUpdateNeeded = false;
 }
 
 //============================================================
@@ -550,10 +598,13 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     threatRefStatusChangeEvent->setThreatManager(this);     // now we can set the threat manager
 
     HostileReference* hostilRef = threatRefStatusChangeEvent->getReference();
+    iClientUpdateNeeded = true;
 
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            iThreatContainer.setChanged(hostilRef);
+            iThreatOfflineContainer.setChanged(hostilRef);
             if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
                 (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -601,6 +652,10 @@ bool ThreatManager::isNeedUpdateToClient(uint32 time)
     if (time >= iUpdateTimer)
     {
         iUpdateTimer = THREAT_UPDATE_INTERVAL;
+        if (!iClientUpdateNeeded)
+            return false;
+
+        iClientUpdateNeeded = false;
         return true;
     }
     iUpdateTimer -= time;
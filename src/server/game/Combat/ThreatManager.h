@@ -25,6 +25,8 @@
 #include "UnitEvents.h"
 
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 //==============================================================
 
@@ -143,15 +145,22 @@ class ThreatManager;
 class ThreatContainer
 {
     private:
+        typedef std::unordered_map<uint64, std::list<HostileReference*>::iterator> ThreatListIndex;
+
         std::list<HostileReference*> iThreatList;
+        ThreatListIndex iThreatIndex;                       // victim guid -> position in iThreatList
+        std::unordered_set<HostileReference*> iChangedRefs; // refs whose position may be wrong, the rest stays sorted
         bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* hostileRef) { iThreatList.remove(hostileRef); }
-        void addReference(HostileReference* hostileRef) { iThreatList.push_back(hostileRef); }
+        void remove(HostileReference* hostileRef);
+        void addReference(HostileReference* hostileRef);
         void clearReferences();
 
+        // Remember a threat change, the ref is moved on the next sort
+        void setChanged(HostileReference* hostileRef);
+
         // Sort the list if necessary
         void update();
     public:
@@ -202,6 +211,7 @@ class ThreatManager
 
         void processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusChangeEvent);
 
+        // Send the threat list only when the interval passed and something changed since the last one
         bool isNeedUpdateToClient(uint32 time);
 
         HostileReference* getCurrentVictim() { return iCurrentVictim; }
@@ -251,6 +261,7 @@ class ThreatManager
         HostileReference* iCurrentVictim;
         Unit* iOwner;
         uint32 iUpdateTimer;
+        bool iClientUpdateNeeded;                           // threat list changed since the last SMSG_THREAT_UPDATE
         ThreatContainer iThreatContainer;
         ThreatContainer iThreatOfflineContainer;
 };
@@ -83,6 +83,33 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
     }
 }
 
+bool LfgCompatibilityKey::HasSlot(uint32 slot) const
+{
+    for (uint8 i = 0; i < size; ++i)
+        if (slots[i] == slot)
+            return true;
+    return false;
+}
+
+bool LfgCompatibilityKey::operator==(LfgCompatibilityKey const& right) const
+{
+    return size == right.size && !memcmp(slots, right.slots, size * sizeof(uint32));
+}
+
+size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
+{
+    size_t hash = key.size;
+    for (uint8 i = 0; i < key.size; ++i)
+        hash ^= key.slots[i] + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+#define LFG_INVALID_QUEUE_SLOT 0xFFFFFFFF
+
+LFGQueue::LFGQueue(): currentQueueOrder(0)
+{
+}
+
 void LFGQueue::AddToQueue(uint64 guid)
 {
     LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
@@ -99,25 +126,9 @@ void LFGQueue::RemoveFromQueue(uint64 guid)
 {
     RemoveFromNewQueue(guid);
     RemoveFromCurrentQueue(guid);
-    RemoveFromCompatibles(guid);
-
-    std::ostringstream o;
-    o << guid;
-    std::string sguid = o.str();
-
-    LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
-    for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
-        if (itr->first != guid)
-        {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
-            {
-                itr->second.bestCompatible.clear();
-                FindBestCompatibleInQueue(itr);
-            }
-        }
-        else
-            itDelete = itr;
+    ReleaseQueueSlot(guid);
 
+    LfgQueueDataContainer::iterator itDelete = QueueDataStore.find(guid);
     if (itDelete != QueueDataStore.end())
         QueueDataStore.erase(itDelete);
 }
@@ -135,26 +146,300 @@ void LFGQueue::RemoveFromNewQueue(uint64 guid)
 void LFGQueue::AddToCurrentQueue(uint64 guid)
 {
     currentQueueStore.push_back(guid);
+    AddToDungeonQueues(guid);
 }
 
 void LFGQueue::RemoveFromCurrentQueue(uint64 guid)
 {
     currentQueueStore.remove(guid);
+    RemoveFromDungeonQueues(guid);
 }
 
 void LFGQueue::AddQueueData(uint64 guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
 {
     QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    GetQueueSlot(guid);
     AddToQueue(guid);
 }
 
 void LFGQueue::RemoveQueueData(uint64 guid)
 {
+    ReleaseQueueSlot(guid);
+
     LfgQueueDataContainer::iterator it = QueueDataStore.find(guid);
     if (it != QueueDataStore.end())
         QueueDataStore.erase(it);
 }
 
+/**
+   Get the queue slot of a guid, assigning a free one if needed
+
+   @param[in]     guid Queued guid
+   @returns Small integer used for the guid in compatibility keys
+*/
+uint32 LFGQueue::GetQueueSlot(uint64 guid)
+{
+    LfgQueueSlotContainer::const_iterator itr = QueueSlotStore.find(guid);
+    if (itr != QueueSlotStore.end())
+        return itr->second;
+
+    uint32 slot;
+    if (!FreeSlotStore.empty())
+    {
+        slot = FreeSlotStore.back();
+        FreeSlotStore.pop_back();
+        SlotGuidStore[slot] = guid;
+    }
+    else
+    {
+        slot = uint32(SlotGuidStore.size());
+        SlotGuidStore.push_back(guid);
+        SlotKeysStore.push_back(LfgCompatibilityKeyList());
+    }
+
+    QueueSlotStore[guid] = slot;
+    return slot;
+}
+
+uint32 LFGQueue::FindQueueSlot(uint64 guid) const
+{
+    LfgQueueSlotContainer::const_iterator itr = QueueSlotStore.find(guid);
+    return itr != QueueSlotStore.end() ? itr->second : LFG_INVALID_QUEUE_SLOT;
+}
+
+/**
+   Frees the queue slot of a guid, dropping every cached combination that contains it
+
+   @param[in]     guid Guid leaving the queue
+*/
+void LFGQueue::ReleaseQueueSlot(uint64 guid)
+{
+    LfgQueueSlotContainer::iterator itr = QueueSlotStore.find(guid);
+    if (itr == QueueSlotStore.end())
+        return;
+
+    uint32 slot = itr->second;
+    QueueSlotStore.erase(itr);
+
+    RemoveFromCompatibles(slot);
+
+    for (LfgQueueDataContainer::iterator itQueue = QueueDataStore.begin(); itQueue != QueueDataStore.end(); ++itQueue)
+    {
+        if (itQueue->first != guid && itQueue->second.bestCompatible.HasSlot(slot))
+        {
+            itQueue->second.bestCompatible = LfgCompatibilityKey();
+            FindBestCompatibleInQueue(itQueue);
+        }
+    }
+
+    SlotGuidStore[slot] = 0;
+    FreeSlotStore.push_back(slot);
+}
+
+/**
+   Builds the compatibility cache key of a list of guids
+
+   @param[in]     check list of guids
+   @returns Queue slots of the guids in ascending order, empty if any guid is not queued
+*/
+LfgCompatibilityKey LFGQueue::MakeCompatibilityKey(LfgGuidList const& check) const
+{
+    LfgCompatibilityKey key;
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && key.size < LFG_MAX_COMPATIBILITY_KEY_SIZE; ++it)
+    {
+        uint32 slot = FindQueueSlot(*it);
+        if (slot == LFG_INVALID_QUEUE_SLOT)
+            return LfgCompatibilityKey();
+
+        uint8 pos = key.size++;
+        for (; pos > 0 && key.slots[pos - 1] > slot; --pos)
+            key.slots[pos] = key.slots[pos - 1];
+        key.slots[pos] = slot;
+    }
+    return key;
+}
+
+std::string LFGQueue::GetKeyString(LfgCompatibilityKey const& key) const
+{
+    LfgGuidList guids;
+    for (uint8 i = 0; i < key.size; ++i)
+        guids.push_back(key.slots[i] < SlotGuidStore.size() ? SlotGuidStore[key.slots[i]] : 0);
+    return ConcatenateGuids(guids);
+}
+
+/**
+   Adds a guid of the current queue to the buckets of its selected dungeons
+
+   @param[in]     guid Guid added to the current queue
+*/
+void LFGQueue::AddToDungeonQueues(uint64 guid)
+{
+    LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue == QueueDataStore.end() || DungeonQueueEntryStore.find(guid) != DungeonQueueEntryStore.end())
+        return;
+
+    LfgQueueData const& queueData = itQueue->second;
+    LfgDungeonQueueEntry& entry = DungeonQueueEntryStore[guid];
+    entry.dungeons = queueData.dungeons;
+    entry.order = currentQueueOrder++;
+    entry.players = uint8(queueData.roles.size());
+    entry.lfgGroup = sLFGMgr->IsLfgGroup(guid);
+    for (LfgRolesMap::const_iterator it = queueData.roles.begin(); it != queueData.roles.end(); ++it)
+    {
+        if (it->second & PLAYER_ROLE_TANK)
+            ++entry.tanks;
+        if (it->second & PLAYER_ROLE_HEALER)
+            ++entry.healers;
+        if (it->second & PLAYER_ROLE_DAMAGE)
+            ++entry.dps;
+    }
+
+    for (LfgDungeonSet::const_iterator it = entry.dungeons.begin(); it != entry.dungeons.end(); ++it)
+    {
+        LfgDungeonQueue& dungeonQueue = DungeonQueueStore[*it];
+        dungeonQueue.queued.push_back(guid);
+        dungeonQueue.players += entry.players;
+        dungeonQueue.tanks += entry.tanks;
+        dungeonQueue.healers += entry.healers;
+        dungeonQueue.dps += entry.dps;
+        if (entry.lfgGroup)
+            ++dungeonQueue.lfgGroups;
+    }
+}
+
+void LFGQueue::RemoveFromDungeonQueues(uint64 guid)
+{
+    LfgDungeonQueueEntryContainer::iterator itEntry = DungeonQueueEntryStore.find(guid);
+    if (itEntry == DungeonQueueEntryStore.end())
+        return;
+
+    LfgDungeonQueueEntry const& entry = itEntry->second;
+    for (LfgDungeonSet::const_iterator it = entry.dungeons.begin(); it != entry.dungeons.end(); ++it)
+    {
+        LfgDungeonQueueContainer::iterator itDungeon = DungeonQueueStore.find(*it);
+        if (itDungeon == DungeonQueueStore.end())
+            continue;
+
+        LfgDungeonQueue& dungeonQueue = itDungeon->second;
+        dungeonQueue.queued.remove(guid);
+        if (dungeonQueue.queued.empty())
+        {
+            DungeonQueueStore.erase(itDungeon);
+            continue;
+        }
+
+        dungeonQueue.players -= entry.players;
+        dungeonQueue.tanks -= entry.tanks;
+        dungeonQueue.healers -= entry.healers;
+        dungeonQueue.dps -= entry.dps;
+        if (entry.lfgGroup)
+            --dungeonQueue.lfgGroups;
+    }
+
+    DungeonQueueEntryStore.erase(itEntry);
+}
+
+/**
+   Checks if a new guid and the queued guids of one dungeon have enough players
+   and roles to form a full group. Only necessary conditions are checked, a true
+   result still needs CheckCompatibility
+
+   @param[in]     guid New guid
+   @param[in]     queueData Queue data of the new guid
+   @param[in]     dungeonQueue Queued guids of one of the selected dungeons
+   @return false if no new group can be formed with that dungeon
+*/
+bool LFGQueue::CanFormFullGroup(uint64 guid, LfgQueueData const& queueData, LfgDungeonQueue const& dungeonQueue) const
+{
+    // Groups smaller than a full one are allowed in these cases
+    if (sWorld->getBoolConfig(CONFIG_LFG_DEBUG_JOIN) || sWorld->getBoolConfig(CONFIG_LFG_FORCE_MINPLAYERS))
+        return true;
+
+    if (dungeonQueue.lfgGroups || sLFGMgr->IsLfgGroup(guid) || queueData.dungeons.empty())
+        return true;
+
+    // Same dungeon data CheckCompatibility takes sizes and roles from
+    uint32 maxGroupSize = MAXGROUPSIZE;
+    if (LFGDungeonData const* dungeon = sLFGMgr->GetLFGDungeon(*queueData.dungeons.begin()))
+        maxGroupSize = dungeon->dbc->GetMaxGroupSize();
+
+    // Raids can't be filled by FindNewGroups anyway, keep them for best compatible tracking
+    if (maxGroupSize > MAXGROUPSIZE)
+        return true;
+
+    uint32 players = dungeonQueue.players + queueData.roles.size();
+    if (players < maxGroupSize)
+        return false;
+
+    // CheckGroupRoles caps every role, a full group then needs all of them
+    LfgRoleData roleData(*queueData.dungeons.begin() & 0xFFFFF);
+    if (uint32(roleData.tanksNeeded) + roleData.healerNeeded + roleData.dpsNeeded != maxGroupSize)
+        return true;
+
+    uint32 tanks = dungeonQueue.tanks;
+    uint32 healers = dungeonQueue.healers;
+    uint32 dps = dungeonQueue.dps;
+    for (LfgRolesMap::const_iterator it = queueData.roles.begin(); it != queueData.roles.end(); ++it)
+    {
+        if (it->second & PLAYER_ROLE_TANK)
+            ++tanks;
+        if (it->second & PLAYER_ROLE_HEALER)
+            ++healers;
+        if (it->second & PLAYER_ROLE_DAMAGE)
+            ++dps;
+    }
+
+    return tanks >= roleData.tanksNeeded && healers >= roleData.healerNeeded && dps >= roleData.dpsNeeded;
+}
+
+/**
+   Gets the queued guids a new guid could form a group with: those sharing one of
+   its dungeons, skipping dungeons that can't provide a full group. Keeps the order
+   of the current queue
+
+   @param[in]     guid New guid
+   @param[out]    candidates Queued guids to match against
+   @return true if some dungeon bucket was skipped
+*/
+bool LFGQueue::GetMatchCandidates(uint64 guid, LfgGuidList& candidates) const
+{
+    LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue == QueueDataStore.end())
+    {
+        candidates = currentQueueStore;
+        return false;
+    }
+
+    bool pruned = false;
+    std::vector<std::pair<uint32, uint64> > ordered;
+    for (LfgDungeonSet::const_iterator it = itQueue->second.dungeons.begin(); it != itQueue->second.dungeons.end(); ++it)
+    {
+        LfgDungeonQueueContainer::const_iterator itDungeon = DungeonQueueStore.find(*it);
+        if (itDungeon == DungeonQueueStore.end())
+            continue;
+
+        if (!CanFormFullGroup(guid, itQueue->second, itDungeon->second))
+        {
+            pruned = true;
+            continue;
+        }
+
+        for (LfgGuidList::const_iterator itGuid = itDungeon->second.queued.begin(); itGuid != itDungeon->second.queued.end(); ++itGuid)
+        {
+            LfgDungeonQueueEntryContainer::const_iterator itEntry = DungeonQueueEntryStore.find(*itGuid);
+            if (itEntry != DungeonQueueEntryStore.end() && *itGuid != guid)
+                ordered.push_back(std::make_pair(itEntry->second.order, *itGuid));
+        }
+    }
+
+    std::sort(ordered.begin(), ordered.end());
+    ordered.erase(std::unique(ordered.begin(), ordered.end()), ordered.end());
+    for (std::vector<std::pair<uint32, uint64> >::const_iterator it = ordered.begin(); it != ordered.end(); ++it)
+        candidates.push_back(it->second);
+
+    return pruned;
+}
+
 void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
 {
     LfgWaitTime &wt = waitTimesAvgStore[dungeonId];
@@ -184,49 +469,60 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 }
 
 /**
-   Remove from cached compatible dungeons any entry that contains the given guid
+   Remove from cached compatible dungeons any entry that contains the given queue slot
 
-   @param[in]     guid Guid to remove from compatible cache
+   @param[in]     slot Queue slot to remove from compatible cache
 */
-void LFGQueue::RemoveFromCompatibles(uint64 guid)
+void LFGQueue::RemoveFromCompatibles(uint32 slot)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
+    if (slot >= SlotKeysStore.size())
+        return;
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
-    {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
-    }
+    TC_LOG_DEBUG("lfg", "LFGQueue::RemoveFromCompatibles: Removing [" UI64FMTD "]", SlotGuidStore[slot]);
+
+    // Keys are registered in every slot they contain, copies left in other slots are skipped once missing from the cache
+    LfgCompatibilityKeyList& keys = SlotKeysStore[slot];
+    for (LfgCompatibilityKeyList::const_iterator it = keys.begin(); it != keys.end(); ++it)
+        CompatibleMapStore.erase(*it);
+    keys.clear();
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted queue slots of the guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
-    data.compatibility = compatibles;
+    SetCompatibilityData(key, LfgCompatibilityData(compatibles));
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    // some guid of the combination left the queue, nothing to drop the entry with later
+    if (key.empty())
+        return;
+
+    std::pair<LfgCompatibleContainer::iterator, bool> result = CompatibleMapStore.insert(LfgCompatibleContainer::value_type(key, data));
+    if (!result.second)
+    {
+        result.first->second = data;
+        return;
+    }
+
+    for (uint8 i = 0; i < key.size; ++i)
+        if (key.slots[i] < SlotKeysStore.size())
+            SlotKeysStore[key.slots[i]].push_back(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted queue slots of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -235,7 +531,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -246,6 +542,10 @@ LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
 
 uint8 LFGQueue::FindGroups()
 {
+    if (newToQueueStore.empty())
+        return 0;
+
+    uint64 startTime = getUSTime();
     uint8 proposals = 0;
     LfgGuidList firstNew;
     while (!newToQueueStore.empty())
@@ -256,14 +556,25 @@ uint8 LFGQueue::FindGroups()
         firstNew.push_back(frontguid);
         RemoveFromNewQueue(frontguid);
 
-        LfgGuidList temporalList = currentQueueStore;
-        LfgCompatibility compatibles = FindNewGroups(firstNew, temporalList);
+        // Only queued guids sharing a dungeon that can still provide a full group
+        LfgGuidList candidates;
+        if (GetMatchCandidates(frontguid, candidates) && candidates.empty())
+            ++Stats.prunedEntrants;
+        ++Stats.entrants;
+
+        LfgCompatibility compatibles = FindNewGroups(firstNew, candidates);
 
         if (compatibles == LFG_COMPATIBLES_MATCH)
             ++proposals;
         else
             AddToCurrentQueue(frontguid);                  // Lfg group not found, add this group to the queue.
     }
+
+    uint64 elapsed = getUSTime() - startTime;
+    ++Stats.passes;
+    Stats.proposals += proposals;
+    Stats.totalTime += elapsed;
+    Stats.maxTime = std::max(Stats.maxTime, elapsed);
     return proposals;
 }
 
@@ -279,17 +590,19 @@ LfgCompatibility LFGQueue::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
     if (check.empty() || check.size() > MAXGROUPSIZE)
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
 
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibilityKey key = MakeCompatibilityKey(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
+    TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s): %s - all(%s)", ConcatenateGuids(check).c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
+    else
+        ++Stats.cacheHits;
 
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", ConcatenateGuids(check).c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -318,7 +631,7 @@ LfgCompatibility LFGQueue::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    ++Stats.checks;
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -340,12 +653,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     bool forceMinPlayers = sWorld->getBoolConfig(CONFIG_LFG_FORCE_MINPLAYERS) || sWorld->getBoolConfig(CONFIG_LFG_DEBUG_JOIN);
 
     // Check for correct size
-    if (check.size() > maxGroupSize || check.empty())
+    if (check.size() > maxGroupSize || check.size() > LFG_MAX_COMPATIBILITY_KEY_SIZE || check.empty())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", ConcatenateGuids(check).c_str());
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
+    LfgCompatibilityKey key = MakeCompatibilityKey(check);
+
     // Check all-but-new compatiblitity
     if (check.size() > 2)
     {
@@ -356,8 +671,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", ConcatenateGuids(check).c_str(), ConcatenateGuids(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -397,7 +712,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // Group with less that MAXGROUPSIZE members always compatible
     if (check.size() == 1 && numPlayers < (proposal.isNew && !forceMinPlayers ? maxGroupSize : minGroupSize))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) sigle group. Compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) sigle group. Compatibles", ConcatenateGuids(check).c_str());
         LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(check.front());
 
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
@@ -405,22 +720,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         uint32 n = 0;
         LFGMgr::CheckGroupRoles(data.roles, LfgRoleData(*itQueue->second.dungeons.begin() & 0xFFFFF), n);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", ConcatenateGuids(check).c_str(), numLfgGroups);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > maxGroupSize)
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", ConcatenateGuids(check).c_str(), numPlayers);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -450,8 +765,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", strGuids.c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", ConcatenateGuids(check).c_str(), playersize);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -468,8 +783,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
             for (LfgRolesMap::const_iterator it = debugRoles.begin(); it != debugRoles.end(); ++it)
                 o << ", " << it->first << ": " << GetRolesString(it->second);
 
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", ConcatenateGuids(check).c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -486,8 +801,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
         if (proposalDungeons.empty())
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", ConcatenateGuids(check).c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -504,15 +819,15 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // Enough players?
     if (numPlayers < (proposal.isNew && !forceMinPlayers ? maxGroupSize : minGroupSize))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u)", strGuids.c_str(), numPlayers);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u)", ConcatenateGuids(check).c_str(), numPlayers);
 
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
         data.roles = proposalRoles;
 
         for (LfgGuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -520,8 +835,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
     if (!sLFGMgr->AllQueued(check))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", ConcatenateGuids(check).c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -569,8 +884,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
     sLFGMgr->AddProposal(proposal);
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", ConcatenateGuids(check).c_str());
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -721,7 +1036,10 @@ std::string LFGQueue::DumpQueueInfo() const
         }
     }
     std::ostringstream o;
-    o << "Queued Players: " << players << " (in group: " << playersInGroup << ") Groups: " << groups << "\n";
+    o << "Queued Players: " << players << " (in group: " << playersInGroup << ") Groups: " << groups << " Dungeon buckets: " << DungeonQueueStore.size() << "\n";
+    o << "Matchmaking: passes " << Stats.passes << ", entrants " << Stats.entrants << " (" << Stats.prunedEntrants << " without partners)"
+      << ", checks " << Stats.checks << ", cache hits " << Stats.cacheHits << ", proposals " << Stats.proposals
+      << ", time " << Stats.totalTime << " us (max " << Stats.maxTime << " us)\n";
     return o.str();
 }
 
@@ -731,7 +1049,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+            o << "(" << GetKeyString(itr->first) << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
 
     return o.str();
 }
@@ -739,32 +1057,37 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg", "LFGQueue::FindBestCompatibleInQueue: " UI64FMTD, itrQueue->first);
-    std::ostringstream o;
-    o << itrQueue->first;
-    std::string sguid = o.str();
+    uint32 slot = FindQueueSlot(itrQueue->first);
+    if (slot >= SlotKeysStore.size())
+        return;
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
+    LfgCompatibilityKeyList& keys = SlotKeysStore[slot];
+    for (size_t i = 0; i < keys.size();)
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(keys[i]);
+        if (itr == CompatibleMapStore.end())
         {
-            UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
+            // dropped together with another slot of the key
+            keys[i] = keys.back();
+            keys.pop_back();
+            continue;
         }
+
+        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
+            UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
+        ++i;
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size <= queueData.bestCompatible.size)
         return;
 
     TC_LOG_DEBUG("lfg", "LFGQueue::UpdateBestCompatibleInQueue: Changed (%s) to (%s) as best compatible group for " UI64FMTD,
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first);
+        GetKeyString(queueData.bestCompatible).c_str(), GetKeyString(key).c_str(), itrQueue->first);
 
     queueData.bestCompatible = key;
     queueData.tanks = queueData.tanksNeeded;
@@ -19,6 +19,7 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <unordered_map>
 
 namespace lfg
 {
@@ -48,6 +49,26 @@ struct LfgCompatibilityData
     LfgRolesMap roles;
 };
 
+#define LFG_MAX_COMPATIBILITY_KEY_SIZE 5                   // MAXGROUPSIZE, FindNewGroups never checks bigger combinations
+
+/// Sorted queue slots of a combination of queued guids (compatibility cache key)
+struct LfgCompatibilityKey
+{
+    LfgCompatibilityKey(): size(0) { memset(slots, 0, sizeof(slots)); }
+
+    bool empty() const { return size == 0; }
+    bool HasSlot(uint32 slot) const;
+    bool operator==(LfgCompatibilityKey const& right) const;
+
+    uint8 size;                                            ///< Number of used slots
+    uint32 slots[LFG_MAX_COMPATIBILITY_KEY_SIZE];          ///< Queue slots in ascending order
+};
+
+struct LfgCompatibilityKeyHash
+{
+    size_t operator()(LfgCompatibilityKey const& key) const;
+};
+
 /// Stores player or group queue info
 struct LfgQueueData
 {
@@ -62,7 +83,7 @@ struct LfgQueueData
     LfgRolesMap roles;                                     ///< Selected Player Role/s
     uint8 type;                                            ///< Queue dungeon type
     uint8 subType;                                         ///< Queue dungeon subtype
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
 
     uint8 tanksNeeded;
     uint8 healerNeeded;
@@ -79,9 +100,55 @@ struct LfgWaitTime
     uint32 number;                                         ///< Number of people used to get that wait time
 };
 
+/// Queued guids (players or groups) in the current queue selecting one dungeon
+struct LfgDungeonQueue
+{
+    LfgDungeonQueue(): players(0), tanks(0), healers(0), dps(0), lfgGroups(0) { }
+
+    LfgGuidList queued;                                    ///< Queued guids in join order
+    uint32 players;                                        ///< Players in queued guids
+    uint32 tanks;                                          ///< Players able to tank
+    uint32 healers;                                        ///< Players able to heal
+    uint32 dps;                                            ///< Players able to deal damage
+    uint32 lfgGroups;                                      ///< Already formed lfg groups looking for replacements
+};
+
+/// Dungeon bucket membership of a guid in the current queue
+struct LfgDungeonQueueEntry
+{
+    LfgDungeonQueueEntry(): order(0), players(0), tanks(0), healers(0), dps(0), lfgGroup(false) { }
+
+    LfgDungeonSet dungeons;                                ///< Buckets the guid was added to
+    uint32 order;                                          ///< Position in the current queue
+    uint8 players;
+    uint8 tanks;
+    uint8 healers;
+    uint8 dps;
+    bool lfgGroup;
+};
+
+/// Matchmaking counters, shown by .lfg queue
+struct LfgQueueStats
+{
+    LfgQueueStats(): passes(0), entrants(0), prunedEntrants(0), checks(0), cacheHits(0), proposals(0), totalTime(0), maxTime(0) { }
+
+    uint64 passes;                                         ///< FindGroups calls with new entrants
+    uint64 entrants;                                       ///< New entrants processed
+    uint64 prunedEntrants;                                 ///< Entrants whose dungeon buckets can't form a group
+    uint64 checks;                                         ///< Compatibility checks calculated
+    uint64 cacheHits;                                      ///< Compatibility checks answered by cache
+    uint64 proposals;                                      ///< Proposals created
+    uint64 totalTime;                                      ///< Microseconds spent in FindGroups
+    uint64 maxTime;                                        ///< Longest FindGroups call in microseconds
+};
+
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> LfgCompatibleContainer;
 typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
+typedef std::map<uint32, LfgDungeonQueue> LfgDungeonQueueContainer;
+typedef std::unordered_map<uint64, LfgDungeonQueueEntry> LfgDungeonQueueEntryContainer;
+typedef std::unordered_map<uint64, uint32> LfgQueueSlotContainer;
+typedef std::vector<LfgCompatibilityKey> LfgCompatibilityKeyList;
 
 /**
     Stores all data related to queue
@@ -89,6 +156,7 @@ typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
 class LFGQueue
 {
     public:
+        LFGQueue();
 
         // Add/Remove from queue
         void AddToQueue(uint64 guid);
@@ -126,14 +194,27 @@ class LFGQueue
         void RemoveFromNewQueue(uint64 guid);
         void RemoveFromCurrentQueue(uint64 guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
-        void RemoveFromCompatibles(uint64 guid);
-
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        // Queue slots - small integers identifying queued guids in compatibility keys
+        uint32 GetQueueSlot(uint64 guid);
+        uint32 FindQueueSlot(uint64 guid) const;
+        void ReleaseQueueSlot(uint64 guid);
+        LfgCompatibilityKey MakeCompatibilityKey(LfgGuidList const& check) const;
+        std::string GetKeyString(LfgCompatibilityKey const& key) const;
+
+        // Dungeon buckets of the current queue
+        void AddToDungeonQueues(uint64 guid);
+        void RemoveFromDungeonQueues(uint64 guid);
+        bool CanFormFullGroup(uint64 guid, LfgQueueData const& queueData, LfgDungeonQueue const& dungeonQueue) const;
+        bool GetMatchCandidates(uint64 guid, LfgGuidList& candidates) const;
+
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
+        void RemoveFromCompatibles(uint32 slot);
+
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(LfgGuidList& check, LfgGuidList& all);
         LfgCompatibility CheckCompatibility(LfgGuidList check);
@@ -148,6 +229,17 @@ class LFGQueue
         LfgWaitTimesContainer waitTimesDpsStore;           ///< Average wait time to find a group queuing as dps
         LfgGuidList currentQueueStore;                     ///< Ordered list. Used to find groups
         LfgGuidList newToQueueStore;                       ///< New groups to add to queue
+
+        LfgDungeonQueueContainer DungeonQueueStore;        ///< Current queue split by selected dungeon
+        LfgDungeonQueueEntryContainer DungeonQueueEntryStore; ///< Dungeon buckets each queued guid is in
+        uint32 currentQueueOrder;                          ///< Next position in the current queue
+
+        LfgQueueSlotContainer QueueSlotStore;              ///< Queue slot of each queued guid
+        std::vector<uint64> SlotGuidStore;                 ///< Guid using each queue slot
+        std::vector<LfgCompatibilityKeyList> SlotKeysStore; ///< Cached compatibility keys containing each slot
+        std::vector<uint32> FreeSlotStore;                 ///< Released queue slots
+
+        LfgQueueStats Stats;                               ///< Matchmaking counters
 };
 
 } // namespace lfg
@@ -51,6 +51,7 @@
 #include "MoveSplineInit.h"
 #include "MoveSpline.h"
 #include "ObjectVisitors.hpp"
+#include "Profiler.h"
 // apply implementation of the singletons
 
 TrainerSpell const* TrainerSpellData::Find(uint32 spell_id) const
@@ -662,6 +663,8 @@ void Creature::Update(uint32 diff)
 
             if (!IsInEvadeMode() && IsAIEnabled && i_AI)
             {
+                PROFILE_SCOPE("CreatureAI::UpdateAI", PROFILE_CREATURE, GetEntry());
+
                 // do not allow the AI to be changed during update
                 m_AI_locked = true;
                 i_AI->UpdateAI(diff);
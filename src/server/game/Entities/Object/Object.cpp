@@ -2890,6 +2890,19 @@ void WorldObject::SendMessageToSet(WorldPacket* data, Player const* skipped_rcvr
     Trinity::VisitNearbyWorldObject(this, CalcVisibilityRange(), notifier);
 }
 
+void WorldObject::SendMovementMessageToSet(WorldPacket* data, bool self, Player const* skipped_rcvr)
+{
+    if (!IsInWorld())
+        return;
+
+    if (self && GetTypeId() == TYPEID_PLAYER && skipped_rcvr != this)
+        ToPlayer()->GetSession()->SendPacket(data);
+
+    float dist = CalcVisibilityRange();
+    Trinity::MessageDistDeliverer notifier(this, data, dist, false, skipped_rcvr, true);
+    Trinity::VisitNearbyWorldObject(this, dist, notifier);
+}
+
 void WorldObject::SendObjectDeSpawnAnim(uint64 guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8 + 1);
@@ -1013,6 +1013,8 @@ class WorldObject : public Object, public WorldLocation
         virtual void SendMessageToSet(WorldPacket* data, bool self);
         virtual void SendMessageToSetInRange(WorldPacket* data, float dist, bool self);
         virtual void SendMessageToSet(WorldPacket* data, Player const* skipped_rcvr);
+        // movement relays, throttled by distance for the players around, see MovementInterest.h
+        void SendMovementMessageToSet(WorldPacket* data, bool self, Player const* skipped_rcvr = NULL);
 
         virtual uint8 getLevelForTarget(WorldObject const* /*target*/) const { return 1; }
 
@@ -84,6 +84,11 @@
 #include "AuctionHouseMgr.h"
 #include "ScenarioMgr.h"
 #include "ObjectVisitors.hpp"
+#include "PlayerSaveTask.h"
+#include "ThreadPoolMgr.hpp"
+#include "Profiler.h"
+
+#include <chrono>
 
 
 #define ZONE_UPDATE_INTERVAL (1*IN_MILLISECONDS)
@@ -302,7 +307,7 @@ bool PlayerTaxi::LoadTaxiDestinationsFromString(const std::string& values, uint3
     return true;
 }
 
-std::string PlayerTaxi::SaveTaxiDestinationsToString()
+std::string PlayerTaxi::SaveTaxiDestinationsToString() const
 {
     if (m_TaxiDestinations.empty())
         return "";
@@ -705,7 +710,7 @@ void KillRewarder::Reward()
 #ifdef _MSC_VER
 #pragma warning(disable:4355)
 #endif
-Player::Player(WorldSession* session) : Unit(true), m_achievementMgr(this), m_reputationMgr(this), phaseMgr(this), m_battlePetMgr(this), m_anticheatMgr(this)
+Player::Player(WorldSession* session) : Unit(true), m_achievementMgr(this), m_reputationMgr(this), phaseMgr(this), m_battlePetMgr(this), m_anticheatMgr(this), m_movementInterest(this)
 {
 #ifdef _MSC_VER
 #pragma warning(default:4355)
@@ -1778,11 +1783,16 @@ void Player::Update(uint32 p_time)
     if (!IsInWorld() || plrUpdate)
         return;
 
+    PROFILE_SCOPE("Player::Update");
+
     plrUpdate = true;
 
     // tick update server-side anticheat module - highest priority
     GetAnticheatMgr()->Update(p_time);
 
+    // movement relays held back for the distance of their mover
+    m_movementInterest.Update();
+
     m_sellItemTimer += p_time;
     if (m_sellItemTimer > 1000)
     {
@@ -2123,9 +2133,18 @@ void Player::Update(uint32 p_time)
     {
         if (p_time >= m_nextSave)
         {
-            // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            TC_LOG_DEBUG("player", "Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            // spread the autosaves of a crowded map over several updates
+            if (GetMap()->ConsumeAutosave())
+            {
+                // m_nextSave reseted in SaveToDB call
+                SaveToDB();
+                TC_LOG_DEBUG("player", "Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
+            else
+            {
+                ++PlayerSaveTask::Stats.DelayedAutosaves;
+                m_nextSave = 1;
+            }
         }
         else
             m_nextSave -= p_time;
@@ -21547,8 +21566,13 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 
 void Player::SaveToDB(bool create /*=false*/)
 {
-    // delay auto save at any saves (manual, in code, or autosave)
-    m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    // delay auto save at any saves (manual, in code, or autosave), the players saved together drift apart
+    uint32 saveInterval = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_nextSave = urand(saveInterval * (100 - AUTOSAVE_SPREAD) / 100, saveInterval * (100 + AUTOSAVE_SPREAD) / 100);
+
+    // bots of the BotMgr are created in memory and have no rows to save to
+    if (GetSession()->IsBot())
+        return;
 
     //lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -21557,6 +21581,11 @@ void Player::SaveToDB(bool create /*=false*/)
         return;
     }
 
+    std::chrono::steady_clock::time_point saveStart = std::chrono::steady_clock::now();
+
+    // the previous save of the player must be committed before this one
+    FlushPendingSave();
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -21585,276 +21614,117 @@ void Player::SaveToDB(bool create /*=false*/)
         CharacterDatabase.Execute(ps.str().c_str());
     }
 
-    PreparedStatement* stmt = NULL;
-    uint8 index = 0;
-
-    if (create)
-    {
-        //! Insert query
-        //! TO DO: Filter out more redundant fields that can take their default value at player create
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER);
-        stmt->setUInt32(index++, GetGUIDLow());
-        stmt->setUInt32(index++, GetSession()->GetAccountId());
-        stmt->setString(index++, GetName());
-        stmt->setUInt8(index++, getRace());
-        stmt->setUInt8(index++, getClass());
-        stmt->setUInt8(index++, getGender());
-        stmt->setUInt8(index++, getLevel());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_XP));
-        stmt->setUInt64(index++, GetMoney());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES_2));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FLAGS));
-        stmt->setUInt16(index++, (uint16)GetMapId());
-        stmt->setUInt32(index++, (uint32)GetInstanceId());
-        stmt->setUInt32(index++, (uint16(GetDungeonDifficulty()) | uint16(GetRaidDifficulty()) << 16));
-        stmt->setFloat(index++, finiteAlways(GetPositionX()));
-        stmt->setFloat(index++, finiteAlways(GetPositionY()));
-        stmt->setFloat(index++, finiteAlways(GetPositionZ()));
-        stmt->setFloat(index++, finiteAlways(GetOrientation()));
-
-        std::ostringstream ss;
-        ss << m_taxi;
-        stmt->setString(index++, ss.str());
-        stmt->setUInt8(index++, m_cinematic);
-        stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_TOTAL]);
-        stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_LEVEL]);
-        stmt->setFloat(index++, finiteAlways(m_rest_bonus));
-        stmt->setUInt32(index++, uint32(time(NULL)));
-        stmt->setUInt8(index++,  (HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0));
-        //save, far from tavern/city
-        //save, but in tavern/city
-        stmt->setUInt32(index++, GetTalentResetCost());
-        stmt->setUInt32(index++, GetTalentResetTime());
-
-        ss.str("");
-        for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
-            ss << uint32(0) << " ";
-        stmt->setString(index++, ss.str());
-        stmt->setUInt16(index++, (uint16)m_ExtraFlags);
-        stmt->setUInt8(index++,  m_stableSlots);
-        stmt->setUInt16(index++, (uint16)m_atLoginFlags);
-        stmt->setUInt16(index++, m_zoneUpdateId);
-        stmt->setUInt32(index++, uint32(m_deathExpireTime));
-
-        ss.str("");
-        ss << m_taxi.SaveTaxiDestinationsToString();
-
-        stmt->setString(index++, ss.str());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 0));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 1));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_CHOSEN_TITLE));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
-        stmt->setUInt8(index++, GetDrunkValue());
-        stmt->setUInt32(index++, GetHealth());
-
-        uint32 storedPowers = 0;
-        for (uint32 i = 0; i < MAX_POWERS; ++i)
-        {
-            if (GetPowerIndexByClass(Powers(i), getClass()) != MAX_POWERS)
-            {
-                stmt->setUInt32(index++, GetUInt32Value(UNIT_FIELD_POWER1 + storedPowers));
-                if (++storedPowers >= MAX_POWERS_PER_CLASS)
-                    break;
-            }
-        }
-
-        for (; storedPowers < MAX_POWERS_PER_CLASS; ++storedPowers)
-            stmt->setUInt32(index++, 0);
-
-        stmt->setUInt32(index++, GetSession()->GetLatency());
-
-        stmt->setUInt8(index++, GetSpecsCount());
-        stmt->setUInt8(index++, GetActiveSpec());
-
-        stmt->setUInt32(index++, 0);
-        stmt->setUInt32(index++, 0);
-
-        ss.str("");
-        for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
-            ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << ' ';
-        stmt->setString(index++, ss.str());
-
-        ss.str("");
-        // cache equipment...
-        for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
-            ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << ' ';
-
-        // ...and bags for enum opcode
-        for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-        {
-            if (Item* item = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                ss << item->GetEntry();
-            else
-                ss << '0';
-            ss << " 0 ";
-        }
-        stmt->setString(index++, ss.str());
-
-        ss.str("");
-        for (uint32 i = 0; i < KNOWN_TITLES_SIZE*2; ++i)
-            ss << GetUInt32Value(PLAYER_FIELD_KNOWN_TITLES + i) << ' ';
-        stmt->setString(index++, ss.str());
-
-        stmt->setUInt8(index++, GetByteValue(PLAYER_FIELD_BYTES, 2));
-        stmt->setInt32(index++, m_currentPetNumber);
-
-        ss.str("");
-        for (uint32 i = 0; i < PET_SLOT_LAST; ++i)
-            ss << m_PetSlots[i] << ' ';
-
-        stmt->setString(index++, ss.str());
-
-
-        stmt->setUInt32(index++, m_grantableLevels);
+    // the `characters` row is built and the transaction committed on the thread pool
+    std::shared_ptr<PlayerSaveTask> task = std::make_shared<PlayerSaveTask>(CharacterDatabase.BeginTransaction());
+    PlayerSaveSnapshot& snapshot = task->Snapshot;
+
+    snapshot.Create = create;
+    snapshot.Guid = GetGUIDLow();
+    snapshot.AccountId = GetSession()->GetAccountId();
+    snapshot.Name = GetName();
+    snapshot.Race = getRace();
+    snapshot.Class = getClass();
+    snapshot.Gender = getGender();
+    snapshot.Level = getLevel();
+    snapshot.XP = GetUInt32Value(PLAYER_XP);
+    snapshot.Money = GetMoney();
+    snapshot.Bytes = GetUInt32Value(PLAYER_BYTES);
+    snapshot.Bytes2 = GetUInt32Value(PLAYER_BYTES_2);
+    snapshot.Flags = GetUInt32Value(PLAYER_FLAGS);
+
+    if (create || !IsBeingTeleported())
+    {
+        snapshot.MapId = uint16(GetMapId());
+        snapshot.InstanceId = GetInstanceId();
+        snapshot.PositionX = GetPositionX();
+        snapshot.PositionY = GetPositionY();
+        snapshot.PositionZ = GetPositionZ();
+        snapshot.Orientation = GetOrientation();
     }
     else
     {
-        // Update query
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER);
-        stmt->setString(index++, GetName());
-        stmt->setUInt8(index++, getRace());
-        stmt->setUInt8(index++, getClass());
-        stmt->setUInt8(index++, getGender());
-        stmt->setUInt8(index++, getLevel());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_XP));
-        stmt->setUInt64(index++, GetMoney());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES_2));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FLAGS));
-
-        if (!IsBeingTeleported())
-        {
-            stmt->setUInt16(index++, (uint16)GetMapId());
-            stmt->setUInt32(index++, (uint32)GetInstanceId());
-            stmt->setUInt32(index++, (uint16(GetDungeonDifficulty()) | uint16(GetRaidDifficulty()) << 16));
-            stmt->setFloat(index++, finiteAlways(GetPositionX()));
-            stmt->setFloat(index++, finiteAlways(GetPositionY()));
-            stmt->setFloat(index++, finiteAlways(GetPositionZ()));
-            stmt->setFloat(index++, finiteAlways(GetOrientation()));
-        }
-        else
-        {
-            stmt->setUInt16(index++, (uint16)GetTeleportDest().GetMapId());
-            stmt->setUInt32(index++, (uint32)0);
-            stmt->setUInt32(index++, (uint16(GetDungeonDifficulty()) | uint16(GetRaidDifficulty()) << 16));
-            stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionX()));
-            stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionY()));
-            stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionZ()));
-            stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetOrientation()));
-        }
-
-        std::ostringstream ss;
-        ss << m_taxi;
-        stmt->setString(index++, ss.str());
-        stmt->setUInt8(index++, m_cinematic);
-        stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_TOTAL]);
-        stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_LEVEL]);
-        stmt->setFloat(index++, finiteAlways(m_rest_bonus));
-        stmt->setUInt32(index++, uint32(time(NULL)));
-        stmt->setUInt8(index++,  (HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0));
-        //save, far from tavern/city
-        //save, but in tavern/city
-        stmt->setUInt32(index++, GetTalentResetCost());
-        stmt->setUInt32(index++, GetTalentResetTime());
-
-        ss.str("");
-        for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
-            ss << uint32(0) << " ";
-        stmt->setString(index++, ss.str());
-        stmt->setUInt16(index++, (uint16)m_ExtraFlags);
-        stmt->setUInt8(index++,  m_stableSlots);
-        stmt->setUInt16(index++, (uint16)m_atLoginFlags);
-        stmt->setUInt16(index++, m_zoneUpdateId);
-        stmt->setUInt32(index++, uint32(m_deathExpireTime));
-
-        ss.str("");
-        ss << m_taxi.SaveTaxiDestinationsToString();
-
-        stmt->setString(index++, ss.str());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 0));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 1));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_CHOSEN_TITLE));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
-        stmt->setUInt8(index++, GetDrunkValue());
-        stmt->setUInt32(index++, GetHealth());
-
-        uint32 storedPowers = 0;
-        for (uint32 i = 0; i < MAX_POWERS; ++i)
-        {
-            if (GetPowerIndexByClass(Powers(i), getClass()) != MAX_POWERS)
-            {
-                stmt->setUInt32(index++, GetUInt32Value(UNIT_FIELD_POWER1 + storedPowers));
-                if (++storedPowers >= MAX_POWERS_PER_CLASS)
-                    break;
-            }
+        snapshot.MapId = uint16(GetTeleportDest().GetMapId());
+        snapshot.InstanceId = 0;
+        snapshot.PositionX = GetTeleportDest().GetPositionX();
+        snapshot.PositionY = GetTeleportDest().GetPositionY();
+        snapshot.PositionZ = GetTeleportDest().GetPositionZ();
+        snapshot.Orientation = GetTeleportDest().GetOrientation();
+    }
+
+    snapshot.Difficulty = uint16(GetDungeonDifficulty()) | uint16(GetRaidDifficulty()) << 16;
+    snapshot.Taxi = m_taxi;
+    snapshot.Cinematic = m_cinematic;
+    snapshot.TotalTime = m_Played_time[PLAYED_TIME_TOTAL];
+    snapshot.LevelTime = m_Played_time[PLAYED_TIME_LEVEL];
+    snapshot.RestBonus = m_rest_bonus;
+    snapshot.LogoutTime = uint32(time(NULL));
+    //save, far from tavern/city
+    //save, but in tavern/city
+    snapshot.Resting = HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0;
+    snapshot.TalentResetCost = GetTalentResetCost();
+    snapshot.TalentResetTime = GetTalentResetTime();
+    snapshot.ExtraFlags = uint16(m_ExtraFlags);
+    snapshot.StableSlots = uint8(m_stableSlots);
+    snapshot.AtLoginFlags = uint16(m_atLoginFlags);
+    snapshot.ZoneId = uint16(m_zoneUpdateId);
+    snapshot.DeathExpireTime = uint32(m_deathExpireTime);
+    snapshot.TotalKills = GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS);
+    snapshot.TodayKills = GetUInt16Value(PLAYER_FIELD_KILLS, 0);
+    snapshot.YesterdayKills = GetUInt16Value(PLAYER_FIELD_KILLS, 1);
+    snapshot.ChosenTitle = GetUInt32Value(PLAYER_CHOSEN_TITLE);
+    snapshot.WatchedFaction = GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX);
+    snapshot.Drunk = GetDrunkValue();
+    snapshot.Health = GetHealth();
+
+    uint32 storedPowers = 0;
+    for (uint32 i = 0; i < MAX_POWERS; ++i)
+    {
+        if (GetPowerIndexByClass(Powers(i), getClass()) != MAX_POWERS)
+        {
+            snapshot.Powers[storedPowers] = GetUInt32Value(UNIT_FIELD_POWER1 + storedPowers);
+            if (++storedPowers >= MAX_POWERS_PER_CLASS)
+                break;
         }
+    }
 
-        for (; storedPowers < MAX_POWERS_PER_CLASS; ++storedPowers)
-            stmt->setUInt32(index++, 0);
-
-        stmt->setUInt32(index++, GetSession()->GetLatency());
-
-        stmt->setUInt8(index++, GetSpecsCount());
-        stmt->setUInt8(index++, GetActiveSpec());
-
-        stmt->setUInt32(index++, GetSpecializationId(0));
-        stmt->setUInt32(index++, GetSpecializationId(1));
-
-        ss.str("");
-        for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
-            ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << ' ';
-        stmt->setString(index++, ss.str());
-
-        ss.str("");
-        // cache equipment...
-        for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
-            ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << ' ';
-
-        // ...and bags for enum opcode
-        for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-        {
-            if (Item* item = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                ss << item->GetEntry();
-            else
-                ss << '0';
-            ss << " 0 ";
-        }
+    for (; storedPowers < MAX_POWERS_PER_CLASS; ++storedPowers)
+        snapshot.Powers[storedPowers] = 0;
 
-        stmt->setString(index++, ss.str());
+    snapshot.Latency = GetSession()->GetLatency();
+    snapshot.SpecsCount = GetSpecsCount();
+    snapshot.ActiveSpec = GetActiveSpec();
 
-        ss.str("");
-        for (uint32 i = 0; i < KNOWN_TITLES_SIZE*2; ++i)
-            ss << GetUInt32Value(PLAYER_FIELD_KNOWN_TITLES + i) << ' ';
+    for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
+        snapshot.Specializations[i] = create ? 0 : GetSpecializationId(i);
 
-        stmt->setString(index++, ss.str());
-        stmt->setUInt8(index++, GetByteValue(PLAYER_FIELD_BYTES, 2));
-        stmt->setInt32(index++, m_currentPetNumber);
+    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
+        snapshot.ExploredZones[i] = GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i);
 
-        ss.str("");
-        for (uint32 i = 0; i < PET_SLOT_LAST; ++i)
-            ss << m_PetSlots[i] << ' ';
+    for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
+        snapshot.VisibleItems[i] = GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i);
 
-        stmt->setString(index++, ss.str());
+    for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+    {
+        Item* item = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
+        snapshot.Bags[i - INVENTORY_SLOT_BAG_START] = item ? item->GetEntry() : 0;
+    }
 
-        stmt->setUInt32(index++, m_grantableLevels);
+    for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
+        snapshot.KnownTitles[i] = GetUInt32Value(PLAYER_FIELD_KNOWN_TITLES + i);
 
-        stmt->setUInt8(index++, IsInWorld() ? 1 : 0);
+    snapshot.ActionBars = GetByteValue(PLAYER_FIELD_BYTES, 2);
+    snapshot.CurrentPetNumber = m_currentPetNumber;
 
-        stmt->setUInt32(index++, GetSpecializationResetCost());
-        stmt->setUInt32(index++, GetSpecializationResetTime());
+    for (uint32 i = 0; i < PET_SLOT_LAST; ++i)
+        snapshot.PetSlots[i] = m_PetSlots[i];
 
-        stmt->setUInt32(index++, GetLfgBonusFaction());
+    snapshot.GrantableLevels = m_grantableLevels;
+    snapshot.Online = IsInWorld() ? 1 : 0;
+    snapshot.SpecializationResetCost = GetSpecializationResetCost();
+    snapshot.SpecializationResetTime = GetSpecializationResetTime();
+    snapshot.LfgBonusFaction = GetLfgBonusFaction();
 
-        // Index
-        stmt->setUInt32(index++, GetGUIDLow());
-    }
-
-    SQLTransaction trans = CharacterDatabase.BeginTransaction();
-
-    trans->Append(stmt);
+    SQLTransaction& trans = task->Trans;
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
@@ -21891,11 +21761,29 @@ void Player::SaveToDB(bool create /*=false*/)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // new characters and logouts are committed right away, the character can be loaded again just after
+    if (create || !IsInWorld() || m_session->isLogingOut())
+        task->Run();
+    else
+    {
+        m_pendingSave = task;
+        sThreadPoolMgr->schedule([task]() { task->Run(); });
+    }
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB();
+
+    PlayerSaveTask::Stats.AddSave(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - saveStart).count()));
+}
+
+void Player::FlushPendingSave()
+{
+    if (!m_pendingSave)
+        return;
+
+    m_pendingSave->Wait();
+    m_pendingSave.reset();
 }
 
 bool Player::HandleChangeSlotModel(uint16 visSlot, uint32 newItem, uint16 pos)
@@ -22037,6 +21925,10 @@ void Player::HandleAltVisSwitch()
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB(SQLTransaction& trans)
 {
+    // the handlers of bots save here too, bypassing SaveToDB
+    if (GetSession()->IsBot())
+        return;
+
     _SaveInventory(trans);
     _SaveCurrency(trans);
     SaveGoldToDB(trans);
@@ -22044,6 +21936,12 @@ void Player::SaveInventoryAndGoldToDB(SQLTransaction& trans)
 
 void Player::SaveGoldToDB(SQLTransaction& trans)
 {
+    if (GetSession()->IsBot())
+        return;
+
+    // an older money value must not be committed after this one
+    FlushPendingSave();
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UDP_CHAR_MONEY);
     stmt->setUInt64(0, GetMoney());
     stmt->setUInt32(1, GetGUIDLow());
@@ -26780,7 +26678,7 @@ void Player::SendAurasForTarget(Unit* target)
     ObjectGuid targetGuid = target->GetObjectGuid();
     Unit::VisibleAuraMap const* visibleAuras = target->GetVisibleAuras();
 
-    WorldPacket data(SMSG_AURA_UPDATE);
+    WorldPacket data(SMSG_AURA_UPDATE, 16 + 48 * visibleAuras->size());
     data.WriteGuidMask<0>(targetGuid);
     data.WriteBit(0);   // has power unit
     data.WriteBit(1);   // full update
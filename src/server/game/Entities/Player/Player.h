@@ -31,6 +31,7 @@
 #include "ItemPrototype.h"
 #include "Item.h"
 #include "MapReference.h"
+#include "MovementInterest.h"
 #include "NPCHandler.h"
 #include "Pet.h"
 #include "QuestDef.h"
@@ -49,6 +50,7 @@
 #include<vector>
 
 struct Mail;
+class PlayerSaveTask;
 struct ItemExtendedCostEntry;
 class Channel;
 class Creature;
@@ -1106,7 +1108,7 @@ class PlayerTaxi
 
         // Destinations
         bool LoadTaxiDestinationsFromString(const std::string& values, uint32 team);
-        std::string SaveTaxiDestinationsToString();
+        std::string SaveTaxiDestinationsToString() const;
 
         void ClearTaxiDestinations() { m_TaxiDestinations.clear(); }
         void AddTaxiDestination(uint32 dest) { m_TaxiDestinations.push_back(dest); }
@@ -2033,6 +2035,7 @@ class Player : public Unit, public GridObject<Player>
 
         void SaveToDB(bool create = false);
         void SaveInventoryAndGoldToDB(SQLTransaction& trans);                    // fast save function for item/money cheating preventing
+        void FlushPendingSave();                                                // commits the save still queued on the thread pool
         void SaveGoldToDB(SQLTransaction& trans);
 
         static void SetUInt32ValueInArray(Tokenizer& data, uint16 index, uint32 value);
@@ -3453,6 +3456,7 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 m_team;
         uint32 m_nextSave;
+        std::shared_ptr<PlayerSaveTask> m_pendingSave;      // last save, until the thread pool committed it
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
@@ -3604,6 +3608,9 @@ class Player : public Unit, public GridObject<Player>
         AnticheatMgr* GetAnticheatMgr() { return &m_anticheatMgr; }
         const AnticheatMgr* GetAnticheatMgr() const { return &m_anticheatMgr; }
 
+        // movement relays of the movers around, thinned out by distance
+        MovementInterest* GetMovementInterest() { return &m_movementInterest; }
+
         bool MovementCheckPassed(uint32 opcode, float delta, MovementInfo const& movementInfo);
         bool OldMovementCheckPassed(uint32 opcode, float delta, MovementInfo const& movementInfo);
         bool CheckZAxis(uint32 opcode, float delta, float new_x, float new_y, float new_z, uint32 cur_mflags, uint32 new_mflags);
@@ -3722,6 +3729,7 @@ class Player : public Unit, public GridObject<Player>
         ReputationMgr  m_reputationMgr;
         BattlePetMgr   m_battlePetMgr;
         AnticheatMgr  m_anticheatMgr;
+        MovementInterest m_movementInterest;
 
         RPPMSpellCooldowns m_rppmspellCooldowns;
         SpellCooldowns m_spellCooldowns;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveTask.h"
+
+#include <chrono>
+#include <thread>
+
+PlayerSaveStats PlayerSaveTask::Stats;
+
+PreparedStatement* PlayerSaveSnapshot::BuildStatement()
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(Create ? CHAR_INS_CHARACTER : CHAR_UPD_CHARACTER);
+    uint8 index = 0;
+
+    if (Create)
+    {
+        stmt->setUInt32(index++, Guid);
+        stmt->setUInt32(index++, AccountId);
+    }
+
+    stmt->setString(index++, Name);
+    stmt->setUInt8(index++, Race);
+    stmt->setUInt8(index++, Class);
+    stmt->setUInt8(index++, Gender);
+    stmt->setUInt8(index++, Level);
+    stmt->setUInt32(index++, XP);
+    stmt->setUInt64(index++, Money);
+    stmt->setUInt32(index++, Bytes);
+    stmt->setUInt32(index++, Bytes2);
+    stmt->setUInt32(index++, Flags);
+    stmt->setUInt16(index++, MapId);
+    stmt->setUInt32(index++, InstanceId);
+    stmt->setUInt32(index++, Difficulty);
+    stmt->setFloat(index++, finiteAlways(PositionX));
+    stmt->setFloat(index++, finiteAlways(PositionY));
+    stmt->setFloat(index++, finiteAlways(PositionZ));
+    stmt->setFloat(index++, finiteAlways(Orientation));
+
+    std::ostringstream ss;
+    ss << Taxi;
+    stmt->setString(index++, ss.str());
+    stmt->setUInt8(index++, Cinematic);
+    stmt->setUInt32(index++, TotalTime);
+    stmt->setUInt32(index++, LevelTime);
+    stmt->setFloat(index++, finiteAlways(RestBonus));
+    stmt->setUInt32(index++, LogoutTime);
+    stmt->setUInt8(index++, Resting);
+    stmt->setUInt32(index++, TalentResetCost);
+    stmt->setUInt32(index++, TalentResetTime);
+
+    ss.str("");
+    for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
+        ss << uint32(0) << " ";
+    stmt->setString(index++, ss.str());
+    stmt->setUInt16(index++, ExtraFlags);
+    stmt->setUInt8(index++, StableSlots);
+    stmt->setUInt16(index++, AtLoginFlags);
+    stmt->setUInt16(index++, ZoneId);
+    stmt->setUInt32(index++, DeathExpireTime);
+
+    stmt->setString(index++, Taxi.SaveTaxiDestinationsToString());
+    stmt->setUInt32(index++, TotalKills);
+    stmt->setUInt16(index++, TodayKills);
+    stmt->setUInt16(index++, YesterdayKills);
+    stmt->setUInt32(index++, ChosenTitle);
+    stmt->setUInt32(index++, WatchedFaction);
+    stmt->setUInt8(index++, Drunk);
+    stmt->setUInt32(index++, Health);
+
+    for (uint32 i = 0; i < MAX_POWERS_PER_CLASS; ++i)
+        stmt->setUInt32(index++, Powers[i]);
+
+    stmt->setUInt32(index++, Latency);
+
+    stmt->setUInt8(index++, SpecsCount);
+    stmt->setUInt8(index++, ActiveSpec);
+
+    for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
+        stmt->setUInt32(index++, Specializations[i]);
+
+    ss.str("");
+    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
+        ss << ExploredZones[i] << ' ';
+    stmt->setString(index++, ss.str());
+
+    ss.str("");
+    // cache equipment...
+    for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
+        ss << VisibleItems[i] << ' ';
+
+    // ...and bags for enum opcode
+    for (uint32 i = 0; i < INVENTORY_SLOT_BAG_END - INVENTORY_SLOT_BAG_START; ++i)
+        ss << Bags[i] << " 0 ";
+    stmt->setString(index++, ss.str());
+
+    ss.str("");
+    for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
+        ss << KnownTitles[i] << ' ';
+    stmt->setString(index++, ss.str());
+
+    stmt->setUInt8(index++, ActionBars);
+    stmt->setInt32(index++, CurrentPetNumber);
+
+    ss.str("");
+    for (uint32 i = 0; i < PET_SLOT_LAST; ++i)
+        ss << PetSlots[i] << ' ';
+    stmt->setString(index++, ss.str());
+
+    stmt->setUInt32(index++, GrantableLevels);
+
+    if (!Create)
+    {
+        stmt->setUInt8(index++, Online);
+
+        stmt->setUInt32(index++, SpecializationResetCost);
+        stmt->setUInt32(index++, SpecializationResetTime);
+
+        stmt->setUInt32(index++, LfgBonusFaction);
+
+        // Index
+        stmt->setUInt32(index++, Guid);
+    }
+
+    return stmt;
+}
+
+void PlayerSaveStats::AddSave(uint32 time)
+{
+    ++Saves;
+    MapThreadTime += time;
+
+    uint32 maxTime = MaxMapThreadTime;
+    while (time > maxTime && !MaxMapThreadTime.compare_exchange_weak(maxTime, time));
+}
+
+void PlayerSaveStats::Reset()
+{
+    Saves = 0;
+    MapThreadTime = 0;
+    MaxMapThreadTime = 0;
+    Serialized = 0;
+    SerializeTime = 0;
+    DelayedAutosaves = 0;
+}
+
+void PlayerSaveTask::Run()
+{
+    uint8 state = STATE_QUEUED;
+    if (!_state.compare_exchange_strong(state, STATE_RUNNING))
+        return;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    Trans->Append(Snapshot.BuildStatement());
+    CharacterDatabase.CommitTransaction(Trans);
+
+    ++Stats.Serialized;
+    Stats.SerializeTime += uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    _state.store(STATE_DONE, std::memory_order_release);
+}
+
+void PlayerSaveTask::Wait()
+{
+    Run();
+
+    while (_state.load(std::memory_order_acquire) != STATE_DONE)
+        std::this_thread::yield();
+}
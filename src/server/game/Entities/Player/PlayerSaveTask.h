@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PLAYER_SAVE_TASK_H
+#define _PLAYER_SAVE_TASK_H
+
+#include "Player.h"
+#include "DatabaseEnv.h"
+
+#include <atomic>
+
+#define MAX_AUTOSAVES_PER_MAP_UPDATE    5                   // more players due to be saved on a map wait for the next update
+#define AUTOSAVE_SPREAD                 10                  // percent of PlayerSaveInterval the next save time varies by
+
+// the `characters` row of a player, copied on the map thread
+struct PlayerSaveSnapshot
+{
+    bool Create;
+    uint32 Guid;
+    uint32 AccountId;
+    std::string Name;
+    uint8 Race;
+    uint8 Class;
+    uint8 Gender;
+    uint8 Level;
+    uint32 XP;
+    uint64 Money;
+    uint32 Bytes;
+    uint32 Bytes2;
+    uint32 Flags;
+    uint16 MapId;
+    uint32 InstanceId;
+    uint32 Difficulty;
+    float PositionX;
+    float PositionY;
+    float PositionZ;
+    float Orientation;
+    PlayerTaxi Taxi;
+    uint8 Cinematic;
+    uint32 TotalTime;
+    uint32 LevelTime;
+    float RestBonus;
+    uint32 LogoutTime;
+    uint8 Resting;
+    uint32 TalentResetCost;
+    uint32 TalentResetTime;
+    uint16 ExtraFlags;
+    uint8 StableSlots;
+    uint16 AtLoginFlags;
+    uint16 ZoneId;
+    uint32 DeathExpireTime;
+    uint32 TotalKills;
+    uint16 TodayKills;
+    uint16 YesterdayKills;
+    uint32 ChosenTitle;
+    uint32 WatchedFaction;
+    uint8 Drunk;
+    uint32 Health;
+    uint32 Powers[MAX_POWERS_PER_CLASS];
+    uint32 Latency;
+    uint8 SpecsCount;
+    uint8 ActiveSpec;
+    uint32 Specializations[MAX_TALENT_SPECS];
+    uint32 ExploredZones[PLAYER_EXPLORED_ZONES_SIZE];
+    uint32 VisibleItems[EQUIPMENT_SLOT_END * 2];
+    uint32 Bags[INVENTORY_SLOT_BAG_END - INVENTORY_SLOT_BAG_START];
+    uint32 KnownTitles[KNOWN_TITLES_SIZE * 2];
+    uint8 ActionBars;
+    uint32 CurrentPetNumber;
+    uint32 PetSlots[PET_SLOT_LAST];
+    uint8 GrantableLevels;
+    uint8 Online;
+    uint32 SpecializationResetCost;
+    uint32 SpecializationResetTime;
+    uint32 LfgBonusFaction;
+
+    PreparedStatement* BuildStatement();
+};
+
+struct PlayerSaveStats
+{
+    PlayerSaveStats() { Reset(); }
+
+    std::atomic<uint64> Saves;
+    std::atomic<uint64> MapThreadTime;                      // microseconds SaveToDB() held the map thread
+    std::atomic<uint32> MaxMapThreadTime;
+    std::atomic<uint64> Serialized;                         // `characters` rows built and committed, by the pool or inline
+    std::atomic<uint64> SerializeTime;
+    std::atomic<uint64> DelayedAutosaves;                   // moved to a later update of a busy map
+
+    void AddSave(uint32 time);
+    void Reset();
+};
+
+/*
+ * A save of a player waiting for its `characters` row statement, built from the
+ * snapshot on the thread pool and committed with the rest of the transaction.
+ *
+ * Run() is called by the pool job, or by the map thread when the player is saved
+ * again before the job got to it, whichever comes first. Player::FlushPendingSave()
+ * waits for it, so the transactions of a player are committed in order.
+ */
+class PlayerSaveTask
+{
+    public:
+        explicit PlayerSaveTask(SQLTransaction trans) : Trans(trans), _state(STATE_QUEUED) { }
+
+        void Run();
+        void Wait();
+
+        PlayerSaveSnapshot Snapshot;
+        SQLTransaction Trans;
+
+        static PlayerSaveStats Stats;
+
+    private:
+        enum State
+        {
+            STATE_QUEUED,
+            STATE_RUNNING,
+            STATE_DONE
+        };
+
+        std::atomic<uint8> _state;
+};
+
+#endif
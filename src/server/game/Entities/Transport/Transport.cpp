@@ -242,6 +242,7 @@ void Transport::AddToWorld()
         //    m_zoneScript->OnGameObjectCreate(this); // TEMPORAIRE, OnTransportCreate(this); a creer
 
         sObjectAccessor->AddObject(this);
+        GetMap()->AddTransport(this);
 
         if (m_model)
             GetMap()->InsertGameObjectModel(*m_model);
@@ -262,6 +263,7 @@ void Transport::RemoveFromWorld()
             if (GetMap()->ContainsGameObjectModel(*m_model))
                 GetMap()->RemoveGameObjectModel(*m_model);
 
+        GetMap()->RemoveTransport(this);
         WorldObject::RemoveFromWorld();
         sObjectAccessor->RemoveObject(this);
     }
@@ -581,14 +583,14 @@ void Transport::Update(uint32 p_diff)
         // first check help in case client-server transport coordinates de-synchronization
         if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
         {
-            TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
-        }
-        else
-        {
-            Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
-            UpdateNPCPositions(); // COME BACK MARKER
+            // we are updated from our map task, leaving it has to wait until all maps are done
+            sMapMgr->ScheduleTransportTeleport(this);
+            return;
         }
 
+        Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
+        UpdateNPCPositions(); // COME BACK MARKER
+
         sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
 
         m_nextNodeTime = m_curr->first;
@@ -602,6 +604,17 @@ void Transport::Update(uint32 p_diff)
     sScriptMgr->OnTransportUpdate(this, p_diff);
 }
 
+void Transport::DoWaypointTeleport()
+{
+    TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+
+    sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+
+    m_nextNodeTime = m_curr->first;
+
+    TC_LOG_DEBUG("transport", "%s teleported to %d %f %f %f %d", m_name.c_str(), m_curr->second.id, m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+}
+
 void Transport::UpdateForMap(Map const* targetMap)
 {
     Map::PlayerList const& player = targetMap->GetPlayers();
@@ -37,6 +37,7 @@ class Transport : public GameObject, public TransportBase
         void RemoveFromWorld();
         bool GenerateWaypoints(uint32 pathid, std::set<uint32> &mapids);
         void Update(uint32 p_time);
+        void DoWaypointTeleport();                          // called by MapManager once the map threads are joined
         bool AddPassenger(Player* passenger);
         bool RemovePassenger(Player* passenger);
 
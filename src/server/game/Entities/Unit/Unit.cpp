@@ -60,6 +60,7 @@
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "ObjectVisitors.hpp"
+#include "Profiler.h"
 #include <math.h>
 
 float baseMoveSpeed[MAX_MOVE_TYPE] =
@@ -233,6 +234,8 @@ Unit::Unit(bool isWorldObject): WorldObject(isWorldObject)
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_interruptMask = 0;
+    m_procAurasMask = 0;
+    m_procAurasCounter = 0;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -374,6 +377,8 @@ Unit::~Unit()
 
 void Unit::Update(uint32 p_time)
 {
+    PROFILE_SCOPE("Unit::Update");
+
     // WARNING! Order of execution here is important, do not change.
     // Spells must be processed with event system BEFORE they go to _UpdateSpells.
     // Or else we may have some SPELL_STATE_FINISHED spells stalled in pointers, that is bad.
@@ -3949,6 +3954,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddProcAura(aurApp);
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -4039,6 +4045,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAura(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -4114,6 +4121,93 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
         i = m_appliedAuras.begin();
 }
 
+void Unit::_AddProcAura(AuraApplication* aurApp)
+{
+    uint32 procFlags = sSpellMgr->GetSpellProcFlagsMask(aurApp->GetBase()->GetSpellInfo());
+    if (!procFlags)
+        return;
+
+    // same ordering as m_appliedAuras: by spell id, then by insertion
+    uint64 key = (uint64(aurApp->GetBase()->GetId()) << 32) | m_procAurasCounter++;
+    for (uint8 i = 0; i < 32; ++i)
+        if (procFlags & (1 << i))
+            m_procAuras[i].insert(AuraApplicationProcMap::value_type(key, aurApp));
+
+    m_procAurasMask |= procFlags;
+}
+
+void Unit::_RemoveProcAura(AuraApplication* aurApp)
+{
+    if (!m_procAurasMask)
+        return;
+
+    // proc data may have been reloaded since the aura was indexed, so look in every used bucket
+    uint64 firstKey = uint64(aurApp->GetBase()->GetId()) << 32;
+    uint64 lastKey = firstKey | 0xFFFFFFFF;
+    for (AuraApplicationProcIndex::iterator bucket = m_procAuras.begin(); bucket != m_procAuras.end();)
+    {
+        AuraApplicationProcMap& auras = bucket->second;
+        for (AuraApplicationProcMap::iterator itr = auras.lower_bound(firstKey); itr != auras.end() && itr->first <= lastKey; ++itr)
+        {
+            if (itr->second == aurApp)
+            {
+                auras.erase(itr);
+                break;
+            }
+        }
+
+        if (auras.empty())
+        {
+            m_procAurasMask &= ~(1 << bucket->first);
+            m_procAuras.erase(bucket++);
+        }
+        else
+            ++bucket;
+    }
+}
+
+void Unit::GetProcAuraCandidates(uint32 procFlag, std::vector<AuraApplication*>& candidates) const
+{
+    uint32 usedFlags = procFlag & m_procAurasMask;
+    if (!usedFlags)
+        return;
+
+    // common case - single bucket is already ordered and unique
+    if (!(usedFlags & (usedFlags - 1)))
+    {
+        uint8 bit = 0;
+        while (!(usedFlags & (1 << bit)))
+            ++bit;
+
+        AuraApplicationProcIndex::const_iterator bucket = m_procAuras.find(bit);
+        if (bucket == m_procAuras.end())
+            return;
+
+        candidates.reserve(bucket->second.size());
+        for (AuraApplicationProcMap::const_iterator itr = bucket->second.begin(); itr != bucket->second.end(); ++itr)
+            candidates.push_back(itr->second);
+        return;
+    }
+
+    std::vector<std::pair<uint64, AuraApplication*> > merged;
+    for (AuraApplicationProcIndex::const_iterator bucket = m_procAuras.begin(); bucket != m_procAuras.end(); ++bucket)
+        if (usedFlags & (1 << bucket->first))
+            merged.insert(merged.end(), bucket->second.begin(), bucket->second.end());
+
+    std::sort(merged.begin(), merged.end());
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+    candidates.reserve(merged.size());
+    for (std::vector<std::pair<uint64, AuraApplication*> >::const_iterator itr = merged.begin(); itr != merged.end(); ++itr)
+        candidates.push_back(itr->second);
+}
+
+ProcEvaluationStats& Unit::GetProcEvaluationStats()
+{
+    static ProcEvaluationStats stats;
+    return stats;
+}
+
 void Unit::_UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode)
 {
     // aura can be removed from unit only if it's applied on it, shouldn't happen
@@ -18183,14 +18277,24 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     HealInfo healInfo = HealInfo(actor, actionTarget, dmgInfoProc->GetDamage(), procSpell, procSpell ? SpellSchoolMask(procSpell->SchoolMask) : SPELL_SCHOOL_MASK_NORMAL);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, NULL, dmgInfoProc, &healInfo);
 
+    // Only auras whose proc flags intersect this event can be triggered, see IsSpellProcEventCanTriggeredBy
+    std::vector<AuraApplication*> procCandidates;
+    GetProcAuraCandidates(procFlag, procCandidates);
+
+    ProcEvaluationStats& procStats = GetProcEvaluationStats();
+    ++procStats.Events;
+    procStats.AppliedAuras += GetAppliedAuras().size();
+    procStats.Candidates += procCandidates.size();
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    for (std::vector<AuraApplication*>::const_iterator itr = procCandidates.begin(); itr != procCandidates.end(); ++itr)
     {
+        AuraApplication* aurApp = *itr;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == aurApp->GetBase()->GetId())
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         SpellInfo const* spellProto = triggerData.aura->GetSpellInfo();
 
         if (getLevel() < spellProto->SpellLevel)
@@ -18229,7 +18333,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         // Custom MoP Script
         // Breath of Fire DoT shoudn't remove Breath of Fire disorientation - Hack Fix
-        if (procSpell && procSpell->Id == 123725 && itr->first == 123393)
+        if (procSpell && procSpell->Id == 123725 && aurApp->GetBase()->GetId() == 123393)
             continue;
 
         if (procSpell && !(procSpell->AuraInterruptFlags & (AURA_INTERRUPT_FLAG_TAKE_DAMAGE)))
@@ -18267,11 +18371,11 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
                 if (!IsTriggeredAtSpellProcEvent(target, spellProto, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent, i, triggerData.aura->GetCastItemGUID()))
                     continue;
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -18310,6 +18414,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     //TC_LOG_DEBUG("spell", "ProcDamageAndSpell: procSpell %u procTriggered %u procFlag %u procExtra %u isVictim %u guid %u target %u GetDamage %i",
     //procSpell ? procSpell->Id : 0, procTriggered.size(), procFlag, procExtra, isVictim, GetGUIDLow(), target ? target->GetGUIDLow() : 0, dmgInfoProc->GetDamage());
 
+    procStats.Triggered += procTriggered.size();
+
     // Nothing found
     if (procTriggered.empty())
         return;
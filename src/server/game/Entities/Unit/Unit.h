@@ -40,6 +40,7 @@
 #include "Timer.h"
 #include <list>
 #include <mutex>
+#include <atomic>
 #include "../DynamicObject/DynamicObject.h"
 
 #define WORLD_TRIGGER   12999
@@ -1057,6 +1058,19 @@ public:
     HealInfo* GetHealInfo() const { return _healInfo; }
 };
 
+// Process-wide counters of Unit::ProcDamageAndSpellFor work, shown by .debug procstats
+struct ProcEvaluationStats
+{
+    ProcEvaluationStats() : Events(0), AppliedAuras(0), Candidates(0), Triggered(0) { }
+
+    std::atomic<uint64> Events;                             // proc events that reached the aura scan
+    std::atomic<uint64> AppliedAuras;                       // applied auras a full scan would have visited
+    std::atomic<uint64> Candidates;                         // auras visited through the proc flag index
+    std::atomic<uint64> Triggered;                          // auras added to the triggered list
+
+    void Reset() { Events = 0; AppliedAuras = 0; Candidates = 0; Triggered = 0; }
+};
+
 // Struct for use in Unit::CalculateMeleeDamage
 // Need create structure like in SMSG_ATTACKERSTATEUPDATE opcode
 struct CalcDamageInfo
@@ -1391,6 +1405,8 @@ class Unit : public WorldObject
         typedef std::list<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication *> AuraApplicationList;
+        typedef std::map<uint64, AuraApplication*> AuraApplicationProcMap;              // key: spell id << 32 | insertion order
+        typedef std::map<uint8, AuraApplicationProcMap> AuraApplicationProcIndex;       // key: proc flag bit
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32> ComboPointHolderSet;
         typedef std::vector<SoulSwapDOT> AuraIdList;
@@ -1970,6 +1986,10 @@ class Unit : public WorldObject
         void _RemoveNoStackAuraApplicationsDueToAura(Aura* aura);
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void _AddProcAura(AuraApplication* aurApp);
+        void _RemoveProcAura(AuraApplication* aurApp);
+        void GetProcAuraCandidates(uint32 procFlag, std::vector<AuraApplication*>& candidates) const;
+        static ProcEvaluationStats& GetProcEvaluationStats();
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -2683,6 +2703,9 @@ class Unit : public WorldObject
         AuraList m_my_Auras;                       // casted auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        AuraApplicationProcIndex m_procAuras;      // applied auras that can proc, by proc flag bit, in m_appliedAuras order
+        uint32 m_procAurasMask;                    // proc flag bits with at least one aura in m_procAuras
+        uint32 m_procAurasCounter;                 // insertion counter used to order m_procAuras entries
         uint32 m_interruptMask;
         AuraIdList _SoulSwapDOTList;
 
@@ -1159,6 +1159,9 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    // the objects in loaded grids are spawned by their maps, batch by batch
+    GameEventSpawnBatches batches;
+
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
@@ -1167,18 +1170,17 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
             sObjectMgr->AddCreatureToGrid(*itr, data);
 
             // Spawn if necessary (loaded grids only)
-            Map* map = sMapMgr->CreateBaseMap(data->mapid);
-            // We use spawn coords to spawn
-            if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
+            MapEntry const* mapEntry = sMapStore.LookupEntry(data->mapid);
+            if (mapEntry && !mapEntry->Instanceable())
             {
-                Creature* creature = new Creature;
-                //TC_LOG_DEBUG("server", "Spawning creature %u", *itr);
-                if (!creature->LoadCreatureFromDB(*itr, map))
-                    delete creature;
+                GameEventSpawnRequest request = { *itr, data->id, event_id, false, true };
+                batches[data->mapid].push_back(request);
             }
         }
     }
 
+    QueueSpawnBatches(event_id, batches);
+
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventGameobjectGuids.size()))
     {
         TC_LOG_ERROR("events", "GameEventMgr::GameEventSpawn attempt access to out of range mGameEventGameobjectGuids element %i (size: " SIZEFMTD ")",
@@ -1192,26 +1194,19 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         if (GameObjectData const* data = sObjectMgr->GetGOData(*itr))
         {
             sObjectMgr->AddGameobjectToGrid(*itr, data);
+
             // Spawn if necessary (loaded grids only)
-            // this base map checked as non-instanced and then only existed
-            Map* map = sMapMgr->CreateBaseMap(data->mapid);
-            // We use current coords to unspawn, not spawn coords since creature can have changed grid
-            if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
+            MapEntry const* mapEntry = sMapStore.LookupEntry(data->mapid);
+            if (mapEntry && !mapEntry->Instanceable())
             {
-                GameObject* pGameobject = new GameObject;
-                //TC_LOG_DEBUG("server", "Spawning gameobject %u", *itr);
-                //TODO: find out when it is add to map
-                if (!pGameobject->LoadGameObjectFromDB(*itr, map, false))
-                    delete pGameobject;
-                else
-                {
-                    if (pGameobject->isSpawnedByDefault())
-                        map->AddToMap(pGameobject);
-                }
+                GameEventSpawnRequest request = { *itr, data->id, event_id, true, true };
+                batches[data->mapid].push_back(request);
             }
         }
     }
 
+    QueueSpawnBatches(event_id, batches);
+
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventPoolIds.size()))
     {
         TC_LOG_ERROR("events", "GameEventMgr::GameEventSpawn attempt access to out of range mGameEventPoolIds element %u (size: " SIZEFMTD ")",
@@ -1234,6 +1229,9 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    // the objects on continents are despawned by their maps, batch by batch
+    GameEventSpawnBatches batches;
+
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1244,11 +1242,19 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         {
             sObjectMgr->RemoveCreatureFromGrid(*itr, data);
 
-            if (Creature* creature = ObjectAccessor::GetObjectInWorld(MAKE_NEW_GUID(*itr, data->id, HIGHGUID_UNIT), (Creature*)NULL))
+            MapEntry const* mapEntry = sMapStore.LookupEntry(data->mapid);
+            if (mapEntry && !mapEntry->Instanceable())
+            {
+                GameEventSpawnRequest request = { *itr, data->id, event_id, false, false };
+                batches[data->mapid].push_back(request);
+            }
+            else if (Creature* creature = ObjectAccessor::GetObjectInWorld(MAKE_NEW_GUID(*itr, data->id, HIGHGUID_UNIT), (Creature*)NULL))
                 creature->AddObjectToRemoveList();
         }
     }
 
+    QueueSpawnBatches(event_id, batches);
+
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventGameobjectGuids.size()))
     {
         TC_LOG_ERROR("events", "GameEventMgr::GameEventUnspawn attempt access to out of range mGameEventGameobjectGuids element %i (size: " SIZEFMTD ")",
@@ -1266,10 +1272,19 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         {
             sObjectMgr->RemoveGameobjectFromGrid(*itr, data);
 
-            if (GameObject* pGameobject = ObjectAccessor::GetObjectInWorld(MAKE_NEW_GUID(*itr, data->id, HIGHGUID_GAMEOBJECT), (GameObject*)NULL))
+            MapEntry const* mapEntry = sMapStore.LookupEntry(data->mapid);
+            if (mapEntry && !mapEntry->Instanceable())
+            {
+                GameEventSpawnRequest request = { *itr, data->id, event_id, true, false };
+                batches[data->mapid].push_back(request);
+            }
+            else if (GameObject* pGameobject = ObjectAccessor::GetObjectInWorld(MAKE_NEW_GUID(*itr, data->id, HIGHGUID_GAMEOBJECT), (GameObject*)NULL))
                 pGameobject->AddObjectToRemoveList();
         }
     }
+
+    QueueSpawnBatches(event_id, batches);
+
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventPoolIds.size()))
     {
         TC_LOG_ERROR("events", "GameEventMgr::GameEventUnspawn attempt access to out of range mGameEventPoolIds element %u (size: " SIZEFMTD ")", internal_event_id, mGameEventPoolIds.size());
@@ -1282,6 +1297,25 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
     }
 }
 
+void GameEventMgr::QueueSpawnBatches(int16 event_id, GameEventSpawnBatches& batches)
+{
+    for (GameEventSpawnBatches::const_iterator itr = batches.begin(); itr != batches.end(); ++itr)
+    {
+        // a continent without its base map has no grid loaded, nothing to despawn either
+        Map* map = itr->second.front().Spawn ? sMapMgr->CreateBaseMap(itr->first) : sMapMgr->FindBaseNonInstanceMap(itr->first);
+        if (!map)
+            continue;
+
+        map->QueueGameEventSpawns(itr->second);
+        _spawnStats.Queued += itr->second.size();
+
+        TC_LOG_DEBUG("events", "GameEventMgr: event %i queued " SIZEFMTD " %s to map %u", event_id, itr->second.size(),
+            itr->second.front().Spawn ? "spawns" : "despawns", itr->first);
+    }
+
+    batches.clear();
+}
+
 void GameEventMgr::ChangeEquipOrModel(int16 event_id, bool activate)
 {
     for (ModelEquipList::iterator itr = mGameEventModelEquip[event_id].begin(); itr != mGameEventModelEquip[event_id].end(); ++itr)
@@ -23,6 +23,7 @@
 #include "SharedDefines.h"
 #include "Define.h"
 #include <ace/Singleton.h>
+#include <atomic>
 
 #define max_ge_check_delay DAY  // 1 day in seconds
 
@@ -88,9 +89,20 @@ struct NPCVendorEntry
     uint8 Type;                                             // 1 item, 2 currency
 };
 
+// progress of the spawns and despawns queued to the maps
+struct GameEventSpawnStats
+{
+    GameEventSpawnStats() : Queued(0), Applied(0), Skipped(0) { }
+
+    std::atomic<uint64> Queued;
+    std::atomic<uint64> Applied;
+    std::atomic<uint64> Skipped;                            // grid not loaded, already spawned or the event changed again
+};
+
 class Player;
 class Creature;
 class Quest;
+struct GameEventSpawnRequest;
 
 class GameEventMgr
 {
@@ -121,6 +133,7 @@ class GameEventMgr
         uint32 GetNPCFlag(Creature* cr);
         uint32 GetNpcTextId(uint32 guid);
         uint16 GetEventIdForQuest(Quest const* quest) const;
+        GameEventSpawnStats& GetSpawnStats() { return _spawnStats; }
     private:
         void SendWorldStateUpdate(Player* player, uint16 event_id);
         void AddActiveEvent(uint16 event_id) { m_ActiveEvents.insert(event_id); }
@@ -143,6 +156,9 @@ class GameEventMgr
         bool hasCreatureActiveEventExcept(uint32 creature_guid, uint16 event_id);
         bool hasGameObjectActiveEventExcept(uint32 go_guid, uint16 event_id);
 
+        typedef std::map<uint32 /*map id*/, std::vector<GameEventSpawnRequest>> GameEventSpawnBatches;
+        void QueueSpawnBatches(int16 event_id, GameEventSpawnBatches& batches);
+
         typedef std::list<uint32> GuidList;
         typedef std::list<uint32> IdList;
         typedef std::vector<GuidList> GameEventGuidMap;
@@ -173,6 +189,7 @@ class GameEventMgr
         ActiveEvents m_ActiveEvents;
         std::unordered_map<uint32, uint16> _questToEventLinks;
         bool isSystemInit;
+        GameEventSpawnStats _spawnStats;
     public:
         GameEventGuidMap  mGameEventCreatureGuids;
         GameEventGuidMap  mGameEventGameobjectGuids;
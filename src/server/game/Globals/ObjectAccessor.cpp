@@ -37,6 +37,7 @@
 #include "MapInstanced.h"
 #include "World.h"
 #include "ThreadPoolMgr.hpp"
+#include "Profiler.h"
 
 #include <cmath>
 
@@ -51,6 +52,8 @@ public:
 
     void operator()()
     {
+        PROFILE_SCOPE("ObjectAccessor::BuildValuesUpdate");
+
         UpdateDataMapType update_players;
         m_obj->BuildUpdate(update_players);
 
@@ -407,6 +410,8 @@ void ObjectAccessor::RemoveOldCorpses()
 
 void ObjectAccessor::Update(uint32 /*diff*/)
 {
+    PROFILE_SCOPE("ObjectAccessor::Update");
+
     decltype(i_objects) objectsToUpdate;
 
     {
@@ -429,7 +429,7 @@ void ObjectMgr::LoadCreatureTemplates()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0         1            2          3         4         5
-    QueryResult result = WorldDatabase.Query("SELECT entry, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("creature_template", "SELECT entry, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
     //                                           6       7       8        9           10           11        12     13      14        15        16         17         18        19         20
                                              "modelid4, name, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, exp_unk, faction, npcflag, npcflag2, speed_walk, speed_run, "
     //                                             21      22    23     24     25        26           27            28              29               30            31         32           33
@@ -452,7 +452,6 @@ void ObjectMgr::LoadCreatureTemplates()
         return;
     }
 
-    _creatureTemplateStore.rehash(result->GetRowCount());
     uint32 count = 0;
     do
     {
@@ -549,6 +548,13 @@ void ObjectMgr::LoadCreatureTemplates()
     }
     while (result->NextRow());
 
+    // a failed query stops the startup as well, the world must not run on a part of the table
+    if (result->HasError())
+    {
+        TC_LOG_ERROR("server", ">> Streaming `creature_template` failed after %u creature definitions, aborting.", count);
+        exit(1);
+    }
+
     // Checking needs to be done after loading because of the difficulty self referencing
     for (CreatureTemplateContainer::const_iterator itr = _creatureTemplateStore.begin(); itr != _creatureTemplateStore.end(); ++itr)
         CheckCreatureTemplate(&itr->second);
@@ -1402,7 +1408,7 @@ void ObjectMgr::LoadCreatures()
     uint32 oldMSTime = getMSTime();
 
     //                                               0              1   2       3      4       5           6           7           8            9            10            11          12
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, zoneId, areaId, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("creature", "SELECT creature.guid, id, map, zoneId, areaId, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
     //        13            14         15       16            17         18         19          20          21                22                   23                     24                    25
         "currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.npcflag2, creature.unit_flags, creature.dynamicflags, creature.isActive "
         "FROM creature "
@@ -1423,7 +1429,7 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _creatureDataStore.rehash(result->GetRowCount());
+    std::vector<CellSpawn> gridSpawns;
     uint32 count = 0;
     do
     {
@@ -1527,7 +1533,7 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
-            AddCreatureToGrid(guid, &data);
+            AppendCellSpawns(gridSpawns, guid, data.mapid, data.spawnMask, data.posX, data.posY);
 
         if (!data.zoneId || !data.areaId)
         {
@@ -1541,6 +1547,15 @@ void ObjectMgr::LoadCreatures()
         ++count;
 
     } while (result->NextRow());
+
+    if (result->HasError())
+    {
+        TC_LOG_ERROR("server", ">> Streaming `creature` failed after %u creatures, aborting.", count);
+        exit(1);
+    }
+
+    AddCellSpawnsToGrid(gridSpawns, &CellObjectGuids::creatures);
+
     TC_LOG_INFO("server", ">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1693,34 +1708,166 @@ void ObjectMgr::LoadPersonalLootTemplate()
     TC_LOG_INFO("server", ">> Loaded %u personal loot in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
-void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
+static void InsertCellGuid(CellGuidSet& guids, uint32 guid)
 {
-    uint32 mask = data->spawnMask;
-    for (uint32 i = 0; mask != 0; i++, mask >>= 1)
+    // spawns added in game get the highest guids
+    if (guids.empty() || guids.back() < guid)
     {
-        if (mask & 1)
+        guids.push_back(guid);
+        return;
+    }
+
+    CellGuidSet::iterator itr = std::lower_bound(guids.begin(), guids.end(), guid);
+    if (*itr != guid)
+        guids.insert(itr, guid);
+}
+
+static void EraseCellGuid(CellGuidSet& guids, uint32 guid)
+{
+    CellGuidSet::iterator itr = std::lower_bound(guids.begin(), guids.end(), guid);
+    if (itr != guids.end() && *itr == guid)
+        guids.erase(itr);
+}
+
+CellObjectGuids const* ObjectMgr::FindCellObjectGuids(CellObjectGuidsMap const& cells, uint32 cellId)
+{
+    CellObjectGuidsMap::const_iterator itr = std::lower_bound(cells.begin(), cells.end(), cellId,
+        [](CellObjectGuidsMap::value_type const& cell, uint32 id) { return cell.first < id; });
+    if (itr == cells.end() || itr->first != cellId)
+        return nullptr;
+
+    return &itr->second;
+}
+
+CellObjectGuids& ObjectMgr::GetOrCreateCellObjectGuids(CellObjectGuidsMap& cells, uint32 cellId)
+{
+    CellObjectGuidsMap::iterator itr = std::lower_bound(cells.begin(), cells.end(), cellId,
+        [](CellObjectGuidsMap::value_type const& cell, uint32 id) { return cell.first < id; });
+    if (itr == cells.end() || itr->first != cellId)
+        itr = cells.emplace(itr, cellId, CellObjectGuids());
+
+    return itr->second;
+}
+
+void ObjectMgr::AppendCellSpawns(std::vector<CellSpawn>& spawns, uint32 guid, uint16 mapId, uint32 spawnMask, float x, float y)
+{
+    uint32 cellId = Trinity::ComputeCellCoord(x, y).GetId();
+    for (uint32 i = 0; spawnMask != 0; i++, spawnMask >>= 1)
+    {
+        if (spawnMask & 1)
         {
-            CellCoord cellCoord = Trinity::ComputeCellCoord(data->posX, data->posY);
-            MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.insert(guid);
+            CellSpawn spawn = { MAKE_PAIR32(mapId, i), cellId, guid };
+            spawns.push_back(spawn);
         }
     }
 }
 
-void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
+void ObjectMgr::AddCellSpawnsToGrid(std::vector<CellSpawn>& spawns, CellGuidSet CellObjectGuids::* guids)
 {
-    uint32 mask = data->spawnMask;
-    for (uint32 i = 0; mask != 0; i++, mask >>= 1)
+    std::sort(spawns.begin(), spawns.end());
+
+    MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
+
+    std::vector<CellSpawn>::const_iterator spawn = spawns.begin();
+    while (spawn != spawns.end())
     {
-        if (mask & 1)
+        uint32 mapKey = spawn->mapKey;
+        std::vector<CellSpawn>::const_iterator mapEnd = spawn;
+        uint32 newCells = 0;
+        for (; mapEnd != spawns.end() && mapEnd->mapKey == mapKey; ++mapEnd)
+            if (mapEnd == spawn || mapEnd->cellId != (mapEnd - 1)->cellId)
+                ++newCells;
+
+        // merge with the cells already stored, the loader of the other spawn type may have filled them meanwhile
+        CellObjectGuidsMap& cells = _mapObjectGuidsStore[mapKey];
+        CellObjectGuidsMap merged;
+        merged.reserve(cells.size() + newCells);
+
+        CellObjectGuidsMap::iterator cell = cells.begin();
+        while (spawn != mapEnd)
         {
-            CellCoord cellCoord = Trinity::ComputeCellCoord(data->posX, data->posY);
-            MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.erase(guid);
+            uint32 cellId = spawn->cellId;
+            for (; cell != cells.end() && cell->first < cellId; ++cell)
+                merged.push_back(std::move(*cell));
+
+            if (cell != cells.end() && cell->first == cellId)
+                merged.push_back(std::move(*cell++));
+            else
+                merged.emplace_back(cellId, CellObjectGuids());
+
+            std::vector<CellSpawn>::const_iterator cellEnd = spawn;
+            while (cellEnd != mapEnd && cellEnd->cellId == cellId)
+                ++cellEnd;
+
+            CellGuidSet& cellGuids = merged.back().second.*guids;
+            std::size_t oldSize = cellGuids.size();
+            cellGuids.reserve(oldSize + (cellEnd - spawn));
+            for (; spawn != cellEnd; ++spawn)
+                cellGuids.push_back(spawn->guid);
+
+            // only on reload, the guids added before are sorted as well
+            if (oldSize)
+            {
+                std::inplace_merge(cellGuids.begin(), cellGuids.begin() + oldSize, cellGuids.end());
+                cellGuids.erase(std::unique(cellGuids.begin(), cellGuids.end()), cellGuids.end());
+            }
+        }
+
+        for (; cell != cells.end(); ++cell)
+            merged.push_back(std::move(*cell));
+
+        cells.swap(merged);
+    }
+}
+
+void ObjectMgr::LogCellObjectGuidsMemory() const
+{
+    MapObjectReadGuard guard(_mapObjectGuidsStoreLock);
+
+    uint64 cellCount = 0;
+    uint64 guidCount = 0;
+    uint64 size = 0;
+    for (MapObjectGuids::const_iterator itr = _mapObjectGuidsStore.begin(); itr != _mapObjectGuidsStore.end(); ++itr)
+    {
+        cellCount += itr->second.size();
+        size += itr->second.capacity() * sizeof(CellObjectGuidsMap::value_type);
+        for (CellObjectGuidsMap::const_iterator cell = itr->second.begin(); cell != itr->second.end(); ++cell)
+        {
+            guidCount += cell->second.creatures.size() + cell->second.gameobjects.size();
+            size += (cell->second.creatures.capacity() + cell->second.gameobjects.capacity()) * sizeof(uint32);
         }
     }
+
+    // the node based layout had a hash node (next link, cell id, two std::set and the corpse map) and a bucket per cell,
+    // and a red-black tree node (color, three links, guid) per guid
+    uint64 nodeCellSize = 2 * sizeof(void*) + sizeof(uint64) + 2 * sizeof(std::set<uint32>) + sizeof(CellCorpseMap);
+    uint64 nodeGuidSize = 4 * sizeof(void*) + sizeof(uint64);
+    uint64 nodeSize = cellCount * nodeCellSize + guidCount * nodeGuidSize;
+
+    TC_LOG_INFO("server", ">> Spawn grid store: %u maps, " UI64FMTD " cells, " UI64FMTD " guids in " UI64FMTD " KB (node based layout: about " UI64FMTD " KB)",
+        uint32(_mapObjectGuidsStore.size()), cellCount, guidCount, size / 1024, nodeSize / 1024);
+}
+
+void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
+{
+    uint32 cellId = Trinity::ComputeCellCoord(data->posX, data->posY).GetId();
+    MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
+
+    uint32 mask = data->spawnMask;
+    for (uint32 i = 0; mask != 0; i++, mask >>= 1)
+        if (mask & 1)
+            InsertCellGuid(GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)], cellId).creatures, guid);
+}
+
+void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
+{
+    uint32 cellId = Trinity::ComputeCellCoord(data->posX, data->posY).GetId();
+    MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
+
+    uint32 mask = data->spawnMask;
+    for (uint32 i = 0; mask != 0; i++, mask >>= 1)
+        if (mask & 1)
+            EraseCellGuid(GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)], cellId).creatures, guid);
 }
 
 uint32 ObjectMgr::AddGOData(uint32 entry, uint32 mapId, float x, float y, float z, float o, uint32 spawntimedelay, float rotation0, float rotation1, float rotation2, float rotation3)
@@ -1867,7 +2014,7 @@ void ObjectMgr::LoadGameobjects()
     uint32 count = 0;
 
     //                                                0                1   2    3         4           5           6        7           8
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, zoneId, areaId, position_x, position_y, position_z, orientation, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("gameobject", "SELECT gameobject.guid, id, map, zoneId, areaId, position_x, position_y, position_z, orientation, "
     //      9          10         11          12         13          14             15      16         17         18        19          20
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, isActive, spawnMask, phaseMask, eventEntry, pool_entry "
         "FROM gameobject LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
@@ -1888,7 +2035,8 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _gameObjectDataStore.rehash(result->GetRowCount());
+    std::vector<CellSpawn> gridSpawns;
+
     do
     {
         Field* fields = result->Fetch();
@@ -2003,41 +2151,41 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
-            AddGameobjectToGrid(guid, &data);
+            AppendCellSpawns(gridSpawns, guid, data.mapid, data.spawnMask, data.posX, data.posY);
         ++count;
     } while (result->NextRow());
 
+    if (result->HasError())
+    {
+        TC_LOG_ERROR("server", ">> Streaming `gameobject` failed after %u gameobjects, aborting.", count);
+        exit(1);
+    }
+
+    AddCellSpawnsToGrid(gridSpawns, &CellObjectGuids::gameobjects);
+
     TC_LOG_INFO("server", ">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
 void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
 {
+    uint32 cellId = Trinity::ComputeCellCoord(data->posX, data->posY).GetId();
+    MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
-    {
         if (mask & 1)
-        {
-            CellCoord cellCoord = Trinity::ComputeCellCoord(data->posX, data->posY);
-            MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.insert(guid);
-        }
-    }
+            InsertCellGuid(GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)], cellId).gameobjects, guid);
 }
 
 void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data)
 {
+    uint32 cellId = Trinity::ComputeCellCoord(data->posX, data->posY).GetId();
+    MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
+
     uint32 mask = data->spawnMask;
     for (uint32 i = 0; mask != 0; i++, mask >>= 1)
-    {
         if (mask & 1)
-        {
-            CellCoord cellCoord = Trinity::ComputeCellCoord(data->posX, data->posY);
-            MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.erase(guid);
-        }
-    }
+            EraseCellGuid(GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)], cellId).gameobjects, guid);
 }
 
 Player* ObjectMgr::GetPlayerByLowGUID(uint32 lowguid) const
@@ -7573,7 +7721,7 @@ void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_gui
     MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
 
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
+    CellObjectGuids& cell_guids = GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)], cellid);
     cell_guids.corpses[player_guid] = instance;
 }
 
@@ -7582,7 +7730,7 @@ void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_
     MapObjectWriteGuard guard(_mapObjectGuidsStoreLock);
 
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
+    CellObjectGuids& cell_guids = GetOrCreateCellObjectGuids(_mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)], cellid);
     cell_guids.corpses.erase(player_guid);
 }
 
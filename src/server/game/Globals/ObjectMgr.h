@@ -383,7 +383,7 @@ struct AreaTriggerStruct
     float  target_Orientation;
 };
 
-typedef std::set<uint32> CellGuidSet;
+typedef std::vector<uint32> CellGuidSet;                                        // sorted guids
 typedef std::map<uint32/*player guid*/, uint32/*instance*/> CellCorpseMap;
 struct CellObjectGuids
 {
@@ -391,9 +391,27 @@ struct CellObjectGuids
     CellGuidSet gameobjects;
     CellCorpseMap corpses;
 };
-typedef std::unordered_map<uint32/*cell_id*/, CellObjectGuids> CellObjectGuidsMap;
+// the cells of a (map, spawnMode) sorted by cell id, a grid load scans contiguous arrays instead of tree nodes
+typedef std::vector<std::pair<uint32/*cell_id*/, CellObjectGuids>> CellObjectGuidsMap;
 typedef std::unordered_map<uint32/*(mapid, spawnMode) pair*/, CellObjectGuidsMap> MapObjectGuids;
 
+// one spawn of a bulk load, sorted by (map, spawnMode) and cell before merging into MapObjectGuids
+struct CellSpawn
+{
+    uint32 mapKey;
+    uint32 cellId;
+    uint32 guid;
+
+    bool operator<(CellSpawn const& right) const
+    {
+        if (mapKey != right.mapKey)
+            return mapKey < right.mapKey;
+        if (cellId != right.cellId)
+            return cellId < right.cellId;
+        return guid < right.guid;
+    }
+};
+
 // Trinity string ranges
 #define MIN_TRINITY_STRING_ID           1                    // 'trinity_string'
 #define MAX_TRINITY_STRING_ID           2000000000
@@ -1301,21 +1319,26 @@ class ObjectMgr
             return NULL;
         }
 
-        CellObjectGuids const * GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id) const
+        // copies the guids of the cell, the store may be reallocated by another thread once the lock is released.
+        // Reuse the same guids object for several cells so the copies don't allocate
+        bool GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id, CellObjectGuids& guids) const
         {
             MapObjectReadGuard guard(_mapObjectGuidsStoreLock);
 
             MapObjectGuids::const_iterator i = _mapObjectGuidsStore.find(MAKE_PAIR32(mapid, spawnMode));
             if (i == _mapObjectGuidsStore.end())
-                return nullptr;
+                return false;
 
-            CellObjectGuidsMap::const_iterator j = i->second.find(cell_id);
-            if (j == i->second.end())
-                return nullptr;
+            CellObjectGuids const* cellGuids = FindCellObjectGuids(i->second, cell_id);
+            if (!cellGuids)
+                return false;
 
-            return &j->second;
+            guids = *cellGuids;
+            return true;
         }
 
+        void LogCellObjectGuidsMemory() const;
+
         CreatureData const* GetCreatureData(uint32 guid) const
         {
             CreatureDataContainer::const_iterator itr = _creatureDataStore.find(guid);
@@ -1802,6 +1825,12 @@ class ObjectMgr
 
         mutable MapObjectLock _mapObjectGuidsStoreLock;
 
+        // the callers hold _mapObjectGuidsStoreLock
+        static CellObjectGuids const* FindCellObjectGuids(CellObjectGuidsMap const& cells, uint32 cellId);
+        static CellObjectGuids& GetOrCreateCellObjectGuids(CellObjectGuidsMap& cells, uint32 cellId);
+        static void AppendCellSpawns(std::vector<CellSpawn>& spawns, uint32 guid, uint16 mapId, uint32 spawnMask, float x, float y);
+        void AddCellSpawnsToGrid(std::vector<CellSpawn>& spawns, CellGuidSet CellObjectGuids::* guids);
+
         CreatureDataContainer _creatureDataStore;
         CreatureTemplateContainer _creatureTemplateStore;
         CreatureDifficultyStatContainer _creatureDifficultyStatStore;
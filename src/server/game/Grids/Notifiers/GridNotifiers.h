@@ -87,10 +87,11 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
-        MessageDistDeliverer(WorldObject* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
+        bool i_throttleMovement;
+        MessageDistDeliverer(WorldObject* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = NULL, bool throttle_movement = false)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_throttleMovement(throttle_movement)
         { }
 
         void Visit(PlayerMapType &m);
@@ -112,6 +113,10 @@ namespace Trinity
             if (i_message->GetOpcode() == SMSG_MESSAGECHAT && player->GetSocial()->HasIgnore(i_source->GetGUID()))
                 return;
 
+            // held back for the distance of the mover, or sent and dropping what was held back
+            if (MovementInterest::IsMovementOpcode(i_message->GetOpcode()) && !player->GetMovementInterest()->Relay(i_source, i_message, i_throttleMovement))
+                return;
+
             if (WorldSession* session = player->GetSession())
                 session->SendPacket(i_message);
         }
@@ -104,6 +104,9 @@ void ObjectGridLoader::LoadN(NGrid const &grid, Map *map, Cell cell)
     uint32 creatures = 0;
     uint32 corpses = 0;
 
+    // reused by all cells of the grid, the copies keep their capacity
+    CellObjectGuids cellGuids;
+
     for (uint32 x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
     {
         cell.data.Part.cell_x = x;
@@ -112,17 +115,17 @@ void ObjectGridLoader::LoadN(NGrid const &grid, Map *map, Cell cell)
             cell.data.Part.cell_y = y;
 
             // Load creatures and gameobjects
-            if (auto const cellGuids = sObjectMgr->GetCellObjectGuids(map->GetId(), map->GetSpawnMode(), cell.GetCellCoord().GetId()))
+            if (sObjectMgr->GetCellObjectGuids(map->GetId(), map->GetSpawnMode(), cell.GetCellCoord().GetId(), cellGuids))
             {
-                creatures += LoadHelper<Creature>(cellGuids->creatures, cell, map);
-                gameObjects += LoadHelper<GameObject>(cellGuids->gameobjects, cell, map);
+                creatures += LoadHelper<Creature>(cellGuids.creatures, cell, map);
+                gameObjects += LoadHelper<GameObject>(cellGuids.gameobjects, cell, map);
             }
 
             // Load corpses (not bones)
-            if (auto const cellGuids = sObjectMgr->GetCellObjectGuids(map->GetId(), 0, cell.GetCellCoord().GetId()))
+            if (sObjectMgr->GetCellObjectGuids(map->GetId(), 0, cell.GetCellCoord().GetId(), cellGuids))
             {
                 // corpses are always added to spawn mode 0 and they are spawned by their instance id
-                corpses += LoadHelper(cellGuids->corpses, cell, map);
+                corpses += LoadHelper(cellGuids.corpses, cell, map);
             }
         }
     }
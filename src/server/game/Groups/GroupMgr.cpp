@@ -84,6 +84,7 @@ Group* GroupMgr::GetGroupByDbStoreId(uint32 storageId) const
 
 uint32 GroupMgr::GenerateGroupId()
 {
+    std::lock_guard<std::mutex> guard(GroupStoreLock);
     if (NextGroupId >= 0xFFFFFFFE)
     {
         TC_LOG_ERROR("server", "Group guid overflow!! Can't continue, shutting down server. ");
@@ -94,6 +95,7 @@ uint32 GroupMgr::GenerateGroupId()
 
 Group* GroupMgr::GetGroupByGUID(uint32 groupId) const
 {
+    std::lock_guard<std::mutex> guard(GroupStoreLock);
     GroupContainer::const_iterator itr = GroupStore.find(groupId);
     if (itr != GroupStore.end())
         return itr->second;
@@ -103,11 +105,13 @@ Group* GroupMgr::GetGroupByGUID(uint32 groupId) const
 
 void GroupMgr::AddGroup(Group* group)
 {
+    std::lock_guard<std::mutex> guard(GroupStoreLock);
     GroupStore[group->GetLowGUID()] = group;
 }
 
 void GroupMgr::RemoveGroup(Group* group)
 {
+    std::lock_guard<std::mutex> guard(GroupStoreLock);
     GroupStore.erase(group->GetLowGUID());
 }
 
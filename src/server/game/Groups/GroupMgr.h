@@ -19,6 +19,7 @@
 #define _GROUPMGR_H
 
 #include "Group.h"
+#include <mutex>
 
 class GroupMgr
 {
@@ -51,6 +52,7 @@ protected:
     uint32           NextGroupDbStoreId;
     GroupContainer   GroupStore;
     GroupDbContainer GroupDbStore;
+    mutable std::mutex GroupStoreLock;                      // battleground raids are created and disbanded from the map threads
 };
 
 #define sGroupMgr ACE_Singleton<GroupMgr, ACE_Null_Mutex>::instance()
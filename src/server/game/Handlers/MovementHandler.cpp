@@ -814,7 +814,7 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recvPacket)
         movementInfo.moveTime = getMSTime();
         movementInfo.moverGUID = mover->GetGUID();
         WorldSession::WriteMovementInfo(data, &movementInfo);
-        mover->SendMessageToSet(&data, _player);
+        mover->SendMovementMessageToSet(&data, true, _player);
 
         mover->m_movementInfo = movementInfo;
 
@@ -349,7 +349,39 @@ void InstanceSaveManager::ScheduleReset(bool add, time_t time, InstResetEvent ev
         }
     }
     else
+    {
         m_resetTimeQueue.insert(std::pair<time_t, InstResetEvent>(time, event));
+        // reached from the map threads as well, the world scheduler is only touched by the world thread
+        if (m_resetTimeQueue.begin()->first == time)
+            _resetWakeupPending = true;
+    }
+}
+
+void InstanceSaveManager::ScheduleResetWakeup()
+{
+    if (m_resetTimeQueue.empty())
+    {
+        sWorld->GetScheduler().Cancel(_resetWakeup);
+        _resetWakeup = 0;
+        return;
+    }
+
+    // a reset is done once its time has passed, see Update()
+    time_t now = time(NULL);
+    time_t next = m_resetTimeQueue.begin()->first;
+    // a far reset wakes up once a day until it is close enough for the millisecond delay
+    uint32 delay = next >= now ? uint32(std::min<time_t>(next - now + 1, DAY)) * IN_MILLISECONDS : 0;
+
+    if (sWorld->GetScheduler().IsScheduled(_resetWakeup))
+        sWorld->GetScheduler().Reschedule(_resetWakeup, delay);
+    else
+        _resetWakeup = sWorld->GetScheduler().ScheduleOnce("instance resets", delay, [this]() { Update(); });
+}
+
+void InstanceSaveManager::UpdateResetWakeup()
+{
+    if (_resetWakeupPending.exchange(false))
+        ScheduleResetWakeup();
 }
 
 void InstanceSaveManager::Update()
@@ -371,6 +403,9 @@ void InstanceSaveManager::Update()
             m_resetTimeQueue.erase(m_resetTimeQueue.begin());
         }
     }
+
+    // the scheduler clock follows the world diffs, an early wakeup only moves the next one
+    ScheduleResetWakeup();
 }
 
 void InstanceSaveManager::_ResetSave(InstanceSaveHashMap::iterator &itr)
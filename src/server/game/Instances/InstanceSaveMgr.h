@@ -22,11 +22,13 @@
 #include "Define.h"
 #include <ace/Singleton.h>
 #include <ace/Thread_Mutex.h>
+#include <atomic>
 #include <list>
 #include <map>
 #include "DatabaseEnv.h"
 #include "DBCEnums.h"
 #include "ObjectDefines.h"
+#include "TimerWheel.h"
 
 struct InstanceTemplate;
 struct MapEntry;
@@ -130,7 +132,7 @@ class InstanceSaveManager
     friend class InstanceSave;
 
     private:
-        InstanceSaveManager() : lock_instLists(false) {};
+        InstanceSaveManager() : lock_instLists(false), _resetWakeup(0), _resetWakeupPending(false) {};
         ~InstanceSaveManager();
 
     public:
@@ -173,6 +175,8 @@ class InstanceSaveManager
         void ScheduleReset(bool add, time_t time, InstResetEvent event);
 
         void Update();
+        // re-arms the wakeup once ScheduleReset moved the earliest reset, world thread only
+        void UpdateResetWakeup();
 
         InstanceSave* AddInstanceSave(uint32 mapId, uint32 instanceId, Difficulty difficulty, bool canReset, bool load = false);
         void RemoveInstanceSave(uint32 InstanceId);
@@ -193,6 +197,8 @@ class InstanceSaveManager
     private:
         void _ResetInstance(uint32 mapid, uint32 instanceId);
         void _ResetSave(InstanceSaveHashMap::iterator &itr);
+        // wakes Update() through the world scheduler when the earliest reset of the queue is due
+        void ScheduleResetWakeup();
         // used during global instance resets
         bool lock_instLists;
         // fast lookup by instance id
@@ -200,6 +206,8 @@ class InstanceSaveManager
         // fast lookup for reset times (always use existed functions for access/set)
         ResetTimeByMapDifficultyMap m_resetTimeByMapDifficulty;
         ResetTimeQueue m_resetTimeQueue;
+        TimerWheel::TaskId _resetWakeup;
+        std::atomic<bool> _resetWakeupPending;
 };
 
 #define sInstanceSaveMgr ACE_Singleton<InstanceSaveManager, ACE_Thread_Mutex>::instance()
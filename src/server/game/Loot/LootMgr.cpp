@@ -53,6 +53,23 @@ LootStore LootTemplates_Skinning("skinning_loot_template",           "creature s
 LootStore LootTemplates_Spell("spell_loot_template",                 "spell id (random item creating)", false);
 LootStore LootTemplates_Bonus("bonus_loot_template",                 "Bonus loot from effect 189",      false);
 
+// Entries still rollable while processing a group, points into the group lists so rolls don't copy entries and their conditions
+typedef std::vector<LootStoreItem const*> LootStoreItemPtrList;
+
+static void FillPossibleDrops(LootStoreItemList const& entries, LootStoreItemPtrList& possibleDrops)
+{
+    possibleDrops.reserve(entries.size());
+    for (LootStoreItemList::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+        possibleDrops.push_back(&*itr);
+}
+
+// Equal chanced picks are uniform, so order of the remaining entries doesn't matter
+static void RemovePossibleDrop(LootStoreItemPtrList& possibleDrops, LootStoreItemPtrList::iterator itr)
+{
+    *itr = possibleDrops.back();
+    possibleDrops.pop_back();
+}
+
 class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
 {
     public:
@@ -99,13 +116,12 @@ void LootStore::Verify() const
 // All checks of the loaded template are called from here, no error reports at loot generation required
 uint32 LootStore::LoadLootTable()
 {
+    // the rows go to a new map first, a reload that breaks off keeps the loot of the store
+    LootTemplateMap templates;
     LootTemplateMap::const_iterator tab;
 
-    // Clearing store (for reloading case)
-    Clear();
-
     //                                                  0     1            2               3         4         5             6         7
-    QueryResult result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount, shared FROM %s", GetName());
+    StreamedQueryResult result = WorldDatabase.PStreamQuery(GetName(), "SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount, shared FROM %s", GetName());
 
     if (!result)
         return 0;
@@ -139,13 +155,13 @@ uint32 LootStore::LoadLootTable()
 
         // Looking for the template of the entry
                                                         // often entries are put together
-        if (m_LootTemplates.empty() || tab->first != entry)
+        if (templates.empty() || tab->first != entry)
         {
             // Searching the template (in case template Id changed)
-            tab = m_LootTemplates.find(entry);
-            if (tab == m_LootTemplates.end())
+            tab = templates.find(entry);
+            if (tab == templates.end())
             {
-                std::pair< LootTemplateMap::iterator, bool > pr = m_LootTemplates.insert(LootTemplateMap::value_type(entry, new LootTemplate));
+                std::pair< LootTemplateMap::iterator, bool > pr = templates.insert(LootTemplateMap::value_type(entry, new LootTemplate));
                 tab = pr.first;
             }
         }
@@ -158,6 +174,18 @@ uint32 LootStore::LoadLootTable()
     }
     while (result->NextRow());
 
+    // the loot must not come from a part of the table, the startup checks HasLoadFailed() and stops
+    m_loadFailed = result->HasError();
+    if (m_loadFailed)
+    {
+        TC_LOG_ERROR("server", ">> Streaming `%s` failed after %u loot rows, keeping the %u templates loaded before.", GetName(), count, uint32(m_LootTemplates.size()));
+        for (tab = templates.begin(); tab != templates.end(); ++tab)
+            delete tab->second;
+        return 0;
+    }
+
+    Clear();
+    m_LootTemplates.swap(templates);
     Verify();                                           // Checks validity of the loot store
 
     return count;
@@ -1462,8 +1490,10 @@ void LootTemplate::LootGroup::CopyConditions(ConditionList /*conditions*/)
 void LootTemplate::LootGroup::Process(Loot& loot) const
 {
     // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
-    LootStoreItemList ExplicitPossibleDrops = ExplicitlyChanced;
+    LootStoreItemPtrList EqualPossibleDrops;
+    LootStoreItemPtrList ExplicitPossibleDrops;
+    FillPossibleDrops(EqualChanced, EqualPossibleDrops);
+    FillPossibleDrops(ExplicitlyChanced, ExplicitPossibleDrops);
 
     uint8 uiAttemptCount = 0;
     bool uiShared = false;
@@ -1476,38 +1506,40 @@ void LootTemplate::LootGroup::Process(Loot& loot) const
         if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
             return;
 
-        LootStoreItem* item = NULL;
+        LootStoreItem const* item = NULL;
 
         // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
+        LootStoreItemPtrList::iterator itr;
         uint8 itemSource = 0;
         if (!ExplicitPossibleDrops.empty())              // First explicitly chanced entries are checked
         {
             itemSource = 1;
             float Roll = (float)rand_chance();
             // check each explicitly chanced entry in the template and modify its chance based on quality
-            for (itr = ExplicitPossibleDrops.begin(); itr != ExplicitPossibleDrops.end(); itr = ExplicitPossibleDrops.erase(itr))
+            for (itr = ExplicitPossibleDrops.begin(); itr != ExplicitPossibleDrops.end(); ++itr)
             {
-                if (itr->chance >= 100.0f)
+                if ((*itr)->chance >= 100.0f)
                 {
-                    item = &*itr;
+                    item = *itr;
                     break;
                 }
 
-                Roll -= itr->chance;
+                Roll -= (*itr)->chance;
                 if (Roll < 0)
                 {
-                    item = &*itr;
+                    item = *itr;
                     break;
                 }
             }
+
+            // entries that missed their chance are not rolled again
+            itr = ExplicitPossibleDrops.erase(ExplicitPossibleDrops.begin(), itr);
         }
         if (item == NULL && !EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
         {
             itemSource = 2;
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
+            itr = EqualPossibleDrops.begin() + irand(0, EqualPossibleDrops.size()-1);
+            item = *itr;
         }
         // finish rolling
 
@@ -1552,7 +1584,7 @@ void LootTemplate::LootGroup::Process(Loot& loot) const
                         ExplicitPossibleDrops.erase(itr);
                         break;
                     case 2: // item came from EqualPossibleDrops
-                        EqualPossibleDrops.erase(itr);
+                        RemovePossibleDrop(EqualPossibleDrops, itr);
                         break;
                 }
             else           // otherwise, add the item and exit the function
@@ -1569,7 +1601,7 @@ void LootTemplate::LootGroup::Process(Loot& loot) const
                                 ExplicitPossibleDrops.erase(itr);
                                 break;
                             case 2: // item came from EqualPossibleDrops
-                                EqualPossibleDrops.erase(itr);
+                                RemovePossibleDrop(EqualPossibleDrops, itr);
                                 break;
                         }
                         continue;
@@ -1586,7 +1618,8 @@ void LootTemplate::LootGroup::Process(Loot& loot) const
 void LootTemplate::LootGroup::ProcessInst(Loot& loot) const
 {
     // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
+    LootStoreItemPtrList EqualPossibleDrops;
+    FillPossibleDrops(EqualChanced, EqualPossibleDrops);
 
     uint8 uiAttemptCount = 0;
     uint8 uiCountAdd = 0;
@@ -1600,16 +1633,15 @@ void LootTemplate::LootGroup::ProcessInst(Loot& loot) const
         if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
             return;
 
-        LootStoreItem* item = NULL;
+        LootStoreItem const* item = NULL;
 
         // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
+        LootStoreItemPtrList::iterator itr;
 
         if (!EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
         {
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
+            itr = EqualPossibleDrops.begin() + irand(0, EqualPossibleDrops.size()-1);
+            item = *itr;
         }
         // finish rolling
 
@@ -1619,7 +1651,7 @@ void LootTemplate::LootGroup::ProcessInst(Loot& loot) const
         {
             if (!(item->lootmode & diffMask) || (uiShared && item->shared))                          // Do not add if instance mode mismatch
             {
-                EqualPossibleDrops.erase(itr);
+                RemovePossibleDrop(EqualPossibleDrops, itr);
                 continue;
             }
 
@@ -1643,12 +1675,12 @@ void LootTemplate::LootGroup::ProcessInst(Loot& loot) const
                     uiShared = true;
                 else
                 {
-                    EqualPossibleDrops.erase(itr);
+                    RemovePossibleDrop(EqualPossibleDrops, itr);
                     continue;
                 }
             }
             if (duplicate) // if item->itemid is a duplicate, remove it
-                EqualPossibleDrops.erase(itr);
+                RemovePossibleDrop(EqualPossibleDrops, itr);
             else           // otherwise, add the item and exit the function
             {
                 loot.AddItem(*item);
@@ -1664,7 +1696,8 @@ void LootTemplate::LootGroup::ProcessInst(Loot& loot) const
 bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
 {
     // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
+    LootStoreItemPtrList EqualPossibleDrops;
+    FillPossibleDrops(EqualChanced, EqualPossibleDrops);
 
     uint8 uiAttemptCount = 0;
     uint16 diffMask = (1 << (sObjectMgr->GetDiffFromSpawn(loot.spawnMode)));
@@ -1678,16 +1711,15 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
         if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
             return false;
 
-        LootStoreItem* item = NULL;
+        LootStoreItem const* item = NULL;
 
         // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
+        LootStoreItemPtrList::iterator itr;
 
         if (!EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
         {
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
+            itr = EqualPossibleDrops.begin() + irand(0, EqualPossibleDrops.size()-1);
+            item = *itr;
         }
         // finish rolling
 
@@ -1698,7 +1730,7 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
             if (!(item->lootmode & diffMask))                          // Do not add if instance mode mismatch
             {
                 //TC_LOG_DEBUG("loot", "LootGroup::ProcessPersonalInst lootmode %i diffMask %i", item->lootmode, diffMask);
-                EqualPossibleDrops.erase(itr);
+                RemovePossibleDrop(EqualPossibleDrops, itr);
                 continue;
             }
 
@@ -1708,7 +1740,7 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
                 {
                     if(!loot.GetLootOwner()->CanGetItemForLoot(_proto))
                     {
-                        EqualPossibleDrops.erase(itr);
+                        RemovePossibleDrop(EqualPossibleDrops, itr);
                         continue;
                     }
 
@@ -1718,7 +1750,7 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
 
                     if(!specFind)
                     {
-                        EqualPossibleDrops.erase(itr);
+                        RemovePossibleDrop(EqualPossibleDrops, itr);
                         continue;
                     }
                 }
@@ -1727,7 +1759,7 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
             else
             {
                 //TC_LOG_DEBUG("loot", "LootGroup::ProcessPersonalInst AllowableClass %i", _proto->AllowableClass);
-                EqualPossibleDrops.erase(itr);
+                RemovePossibleDrop(EqualPossibleDrops, itr);
                 continue;
             }
             if(item->shared) //shared very low chance to and one item
@@ -1735,7 +1767,7 @@ bool LootTemplate::LootGroup::ProcessPersonalInst(Loot& loot) const
                 if(!roll_chance_f(0.5f))
                 {
                     //TC_LOG_DEBUG("loot", "LootGroup::ProcessPersonalInst shared itemid %i", item->itemid);
-                    EqualPossibleDrops.erase(itr);
+                    RemovePossibleDrop(EqualPossibleDrops, itr);
                     continue;
                 }
             }
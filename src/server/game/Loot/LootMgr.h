@@ -211,7 +211,7 @@ class LootStore
 {
     public:
         explicit LootStore(char const* name, char const* entryName, bool ratesAllowed)
-            : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed) {}
+            : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed), m_loadFailed(false) {}
 
         virtual ~LootStore() { Clear(); }
 
@@ -233,6 +233,8 @@ class LootStore
         char const* GetName() const { return m_name; }
         char const* GetEntryName() const { return m_entryName; }
         bool IsRatesAllowed() const { return m_ratesAllowed; }
+        // the last load broke off, the store still holds the loot from before it
+        bool HasLoadFailed() const { return m_loadFailed; }
     protected:
         uint32 LoadLootTable();
         void Clear();
@@ -241,6 +243,7 @@ class LootStore
         char const* m_name;
         char const* m_entryName;
         bool m_ratesAllowed;
+        bool m_loadFailed;
 };
 
 class LootTemplate
@@ -430,7 +433,8 @@ void LoadLootTemplates_Spell();
 void LoadLootTemplates_Bonus();
 void LoadLootTemplates_Reference();
 
-inline void LoadLootTables()
+// false when a table could not be read completely
+inline bool LoadLootTables()
 {
     LoadLootTemplates_Creature();
     LoadLootTemplates_Fishing();
@@ -446,6 +450,12 @@ inline void LoadLootTables()
     LoadLootTemplates_Bonus();
 
     LoadLootTemplates_Reference();
+
+    return !LootTemplates_Creature.HasLoadFailed() && !LootTemplates_Fishing.HasLoadFailed() && !LootTemplates_Gameobject.HasLoadFailed()
+        && !LootTemplates_Item.HasLoadFailed() && !LootTemplates_Mail.HasLoadFailed() && !LootTemplates_Milling.HasLoadFailed()
+        && !LootTemplates_Pickpocketing.HasLoadFailed() && !LootTemplates_Skinning.HasLoadFailed() && !LootTemplates_Disenchant.HasLoadFailed()
+        && !LootTemplates_Prospecting.HasLoadFailed() && !LootTemplates_Spell.HasLoadFailed() && !LootTemplates_Bonus.HasLoadFailed()
+        && !LootTemplates_Reference.HasLoadFailed();
 }
 
 class LootMgr
@@ -36,6 +36,9 @@
 #include "ChallengeMgr.h"
 #include "ScenarioMgr.h"
 #include "ObjectGridLoader.h"
+#include "PlayerSaveTask.h"
+#include "GameEventMgr.h"
+#include "Profiler.h"
 
 namespace {
 
@@ -360,7 +363,7 @@ _creatureToMoveLock(false), i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 i_gridExpiry(expiry), i_scriptLock(false), i_grids(), i_gridMaps(),
-m_activeNonPlayersIter(m_activeNonPlayers.end())
+m_activeNonPlayersIter(m_activeNonPlayers.end()), _autosaveBudget(MAX_AUTOSAVES_PER_MAP_UPDATE)
 {
     m_parentMap = (_parent ? _parent : this);
 
@@ -659,12 +662,17 @@ bool Map::IsGridLoaded(const GridCoord &p) const
 
 void Map::Update(const uint32 t_diff)
 {
+    PROFILE_SCOPE("Map::Update", PROFILE_MAP, GetId());
+
     // for creature
     auto gridObjectUpdate(Trinity::makeGridVisitor(i_objectUpdater));
     // for pets
     auto worldObjectUpdate(Trinity::makeWorldVisitor(i_objectUpdater));
 
     _dynamicTree.update(t_diff);
+    _pathCache.Update(t_diff);
+    _autosaveBudget = MAX_AUTOSAVES_PER_MAP_UPDATE;
+    UpdateGameEventSpawns();
 
     /// update active cells around players and active objects
     resetMarkedCells();
@@ -700,6 +708,11 @@ void Map::Update(const uint32 t_diff)
 
     i_objectUpdater.updateCollected(t_diff);
 
+    // transports never leave the map from here, TeleportTransport is deferred to MapManager
+    for (TransportsContainer::const_iterator itr = _transports.begin(); itr != _transports.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            (*itr)->Update(t_diff);
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
@@ -2124,6 +2137,115 @@ char const* Map::GetMapName() const
     return i_mapEntry ? i_mapEntry->name : "UNNAMEDMAP\x0";
 }
 
+void Map::QueueGameEventSpawns(std::vector<GameEventSpawnRequest> const& requests)
+{
+    std::lock_guard<std::mutex> lock(_gameEventSpawnsLock);
+    _gameEventSpawns.insert(_gameEventSpawns.end(), requests.begin(), requests.end());
+}
+
+void Map::UpdateGameEventSpawns()
+{
+    std::vector<GameEventSpawnRequest> batch;
+    {
+        std::lock_guard<std::mutex> lock(_gameEventSpawnsLock);
+        if (_gameEventSpawns.empty())
+            return;
+
+        size_t count = std::min<size_t>(sWorld->getIntConfig(CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE), _gameEventSpawns.size());
+        batch.assign(_gameEventSpawns.begin(), _gameEventSpawns.begin() + count);
+        _gameEventSpawns.erase(_gameEventSpawns.begin(), _gameEventSpawns.begin() + count);
+    }
+
+    GameEventSpawnStats& stats = sGameEventMgr->GetSpawnStats();
+    for (std::vector<GameEventSpawnRequest>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+    {
+        // the event started or stopped again since the request was queued
+        bool spawned = itr->EventId > 0 ? sGameEventMgr->IsActiveEvent(itr->EventId) : !sGameEventMgr->IsActiveEvent(-itr->EventId);
+        if (spawned != itr->Spawn)
+        {
+            ++stats.Skipped;
+            continue;
+        }
+
+        if (itr->Spawn ? SpawnGameEventObject(*itr) : DespawnGameEventObject(*itr))
+            ++stats.Applied;
+        else
+            ++stats.Skipped;
+    }
+}
+
+bool Map::SpawnGameEventObject(GameEventSpawnRequest const& request)
+{
+    if (request.IsGameObject)
+    {
+        GameObjectData const* data = sObjectMgr->GetGOData(request.Guid);
+        if (!data || !IsGridLoaded(data->posX, data->posY))
+            return false;
+
+        // the grid was loaded after the request was queued, with the gameobject in it
+        if (GetGameObject(MAKE_NEW_GUID(request.Guid, data->id, HIGHGUID_GAMEOBJECT)))
+            return false;
+
+        GameObject* gameobject = new GameObject;
+        //TODO: find out when it is add to map
+        if (!gameobject->LoadGameObjectFromDB(request.Guid, this, false))
+        {
+            delete gameobject;
+            return false;
+        }
+
+        if (gameobject->isSpawnedByDefault())
+            AddToMap(gameobject);
+    }
+    else
+    {
+        CreatureData const* data = sObjectMgr->GetCreatureData(request.Guid);
+        if (!data || !IsGridLoaded(data->posX, data->posY))
+            return false;
+
+        if (GetCreature(MAKE_NEW_GUID(request.Guid, data->id, HIGHGUID_UNIT)))
+            return false;
+
+        // We use spawn coords to spawn
+        Creature* creature = new Creature;
+        if (!creature->LoadCreatureFromDB(request.Guid, this))
+        {
+            delete creature;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Map::DespawnGameEventObject(GameEventSpawnRequest const& request)
+{
+    if (request.IsGameObject)
+    {
+        if (GameObject* gameobject = GetGameObject(MAKE_NEW_GUID(request.Guid, request.Entry, HIGHGUID_GAMEOBJECT)))
+        {
+            gameobject->AddObjectToRemoveList();
+            return true;
+        }
+    }
+    else if (Creature* creature = GetCreature(MAKE_NEW_GUID(request.Guid, request.Entry, HIGHGUID_UNIT)))
+    {
+        creature->AddObjectToRemoveList();
+        return true;
+    }
+
+    return false;
+}
+
+bool Map::ConsumeAutosave()
+{
+    if (!_autosaveBudget)
+        return false;
+
+    --_autosaveBudget;
+    return true;
+}
+
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellCoord cellpair)
 {
     cell.SetNoCreate();
@@ -2936,6 +3058,15 @@ BattlegroundMap::~BattlegroundMap()
     }
 }
 
+void BattlegroundMap::Update(const uint32 t_diff)
+{
+    Map::Update(t_diff);
+
+    // the battleground logic runs in this map task, deletion is left to BattlegroundMgr on the world thread
+    if (m_bg && !m_bg->ToBeDeleted())
+        m_bg->TimedUpdate(t_diff);
+}
+
 void BattlegroundMap::InitVisibilityDistance()
 {
     m_VisibleDistance = GetEntry()->IsBattleArena()
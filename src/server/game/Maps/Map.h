@@ -32,12 +32,14 @@
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
 #include "NGrid.h"
+#include "PathCache.h"
 
 #include <functional>
 
 #include <mutex>
 #include <bitset>
 #include <list>
+#include <deque>
 #include <unordered_set>
 
 class Unit;
@@ -58,8 +60,19 @@ class Battleground;
 class MapInstanced;
 class InstanceMap;
 class BattlegroundMap;
+class Transport;
 struct Position;
 
+// a game event creature or gameobject to spawn in or despawn from the loaded grids of a map
+struct GameEventSpawnRequest
+{
+    uint32 Guid;
+    uint32 Entry;
+    int16 EventId;                                          // negative for the spawns of an event that stopped
+    bool IsGameObject;
+    bool Spawn;
+};
+
 struct ScriptAction
 {
     uint64 sourceGUID;
@@ -560,7 +573,24 @@ class Map
 
         static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId);
         WorldObject* GetActiveObjectWithEntry(uint32 entry);    ///< Hard iteration of all active object on map
+
+        // transports currently on this map, updated from Map::Update
+        typedef std::set<Transport*> TransportsContainer;
+        void AddTransport(Transport* transport) { _transports.insert(transport); }
+        void RemoveTransport(Transport* transport) { _transports.erase(transport); }
+
+        PathCache& GetPathCache() { return _pathCache; }
+
+        // autosaves left in this update, the players due after them are saved in the next one
+        bool ConsumeAutosave();
+
+        // applied by Map::Update, Event.SpawnsPerMapUpdate at a time
+        void QueueGameEventSpawns(std::vector<GameEventSpawnRequest> const& requests);
     private:
+        void UpdateGameEventSpawns();
+        bool SpawnGameEventObject(GameEventSpawnRequest const& request);
+        bool DespawnGameEventObject(GameEventSpawnRequest const& request);
+
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
@@ -653,6 +683,11 @@ class Map
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
+        TransportsContainer _transports;
+        PathCache _pathCache;
+        uint32 _autosaveBudget;
+        std::deque<GameEventSpawnRequest> _gameEventSpawns;
+        std::mutex _gameEventSpawnsLock;
 
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
@@ -724,6 +759,7 @@ class BattlegroundMap : public Map
         BattlegroundMap(uint32 id, time_t, uint32 InstanceId, Map* _parent, uint8 spawnMode);
         ~BattlegroundMap();
 
+        void Update(const uint32);
         bool AddPlayerToMap(Player*, bool initPlayer = true);
         void RemovePlayerFromMap(Player*, bool);
         bool CanEnter(Player* player);
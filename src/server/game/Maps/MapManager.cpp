@@ -34,6 +34,7 @@
 #include "WorldPacket.h"
 #include "Group.h"
 #include "ThreadPoolMgr.hpp"
+#include "Profiler.h"
 
 #include <thread>
 
@@ -66,18 +67,23 @@ Map* MapManager::CreateBaseMap(uint32 id)
     {
         GuardType guard(i_lock);
 
-        MapEntry const* entry = sMapStore.LookupEntry(id);
-        ASSERT(entry);
-
-        if (entry->Instanceable())
-            map = new MapInstanced(id, i_gridCleanUpDelay);
-        else
+        // another thread may have created it while we waited for the lock
+        map = FindBaseMap(id);
+        if (map == NULL)
         {
-            map = new Map(id, i_gridCleanUpDelay, 0, NONE_DIFFICULTY);
-            map->LoadRespawnTimes();
-        }
+            MapEntry const* entry = sMapStore.LookupEntry(id);
+            ASSERT(entry);
 
-        i_maps[id] = map;
+            if (entry->Instanceable())
+                map = new MapInstanced(id, i_gridCleanUpDelay);
+            else
+            {
+                map = new Map(id, i_gridCleanUpDelay, 0, NONE_DIFFICULTY);
+                map->LoadRespawnTimes();
+            }
+
+            i_maps[id] = map;
+        }
     }
 
     ASSERT(map);
@@ -248,6 +254,8 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    PROFILE_SCOPE("MapManager::Update");
+
     uint32 curr = uint32(i_timer.GetCurrent());
     i_timer.SetCurrent(0);
 
@@ -265,8 +273,21 @@ void MapManager::Update(uint32 diff)
 
     sObjectAccessor->Update(curr);
 
-    for (auto itr = m_Transports.begin(); itr != m_Transports.end(); ++itr)
-        (*itr)->Update(curr);
+    // transports are updated by the map they are on, only the map changes are done here
+    std::vector<Transport*> teleports;
+    {
+        GuardType guard(_transportTeleportsLock);
+        teleports.swap(_transportTeleports);
+    }
+
+    for (auto itr = teleports.begin(); itr != teleports.end(); ++itr)
+        (*itr)->DoWaypointTeleport();
+}
+
+void MapManager::ScheduleTransportTeleport(Transport* transport)
+{
+    GuardType guard(_transportTeleportsLock);
+    _transportTeleports.push_back(transport);
 }
 
 void MapManager::DoDelayedMovesAndRemoves()
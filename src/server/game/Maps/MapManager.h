@@ -136,6 +136,9 @@ class MapManager
         TransportMap m_TransportsByMap;
         TransportMap m_TransportsByInstanceIdMap;
 
+        // transports reaching a teleport waypoint during their map update, processed after the map threads join
+        void ScheduleTransportTeleport(Transport* transport);
+
         bool CanPlayerEnter(uint32 mapid, Player* player, bool loginCheck = false);
         void InitializeVisibilityDistanceInfo();
 
@@ -169,6 +172,9 @@ class MapManager
 
         InstanceIds _instanceIds;
         uint32 _nextInstanceId;
+
+        std::vector<Transport*> _transportTeleports;
+        LockType _transportTeleportsLock;
 };
 #define sMapMgr MapManager::instance()
 #endif
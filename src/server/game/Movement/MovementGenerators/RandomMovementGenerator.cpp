@@ -35,6 +35,22 @@
 template<>
 void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
 {
+    // roaming is not urgent, when the map already built enough paths in this update try again in the next one
+    PathCache& pathCache = creature.GetMap()->GetPathCache();
+    if (!pathCache.ReserveDeferrablePath())
+    {
+        if (!i_pathDeferTime)
+            i_pathDeferTime = getMSTime();
+        i_nextMoveTime.Reset(0);
+        return;
+    }
+
+    if (i_pathDeferTime)
+    {
+        pathCache.DeferredPathServed(GetMSTimeDiffToNow(i_pathDeferTime));
+        i_pathDeferTime = 0;
+    }
+
     float respX, respY, respZ, respO, destX, destY, destZ/*, travelDistZ*/;
     creature.GetHomePosition(respX, respY, respZ, respO);
     Map const* map = creature.GetBaseMap();
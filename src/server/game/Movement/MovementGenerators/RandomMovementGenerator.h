@@ -25,7 +25,7 @@ template<class T>
 class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovementGenerator<T> >
 {
     public:
-        RandomMovementGenerator(float spawn_dist = 0.0f) : i_nextMoveTime(0), wander_distance(spawn_dist) {}
+        RandomMovementGenerator(float spawn_dist = 0.0f) : i_nextMoveTime(0), wander_distance(spawn_dist), i_pathDeferTime(0) {}
 
         void _setRandomLocation(T &);
         void DoInitialize(T &);
@@ -39,6 +39,7 @@ class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovemen
 
         uint32 i_nextMove;
         float wander_distance;
+        uint32 i_pathDeferTime;                             // getMSTime() of the first deferred path request, 0 if none waits
 };
 #endif
 
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MovementInterest.h"
+#include "Map.h"
+#include "Player.h"
+#include "Timer.h"
+#include "World.h"
+#include "WorldSession.h"
+
+MovementInterest::MovementInterest(Player* owner) : _owner(owner), _pendingCount(0), _lastCleanup(0)
+{
+    memset(&_counters, 0, sizeof(_counters));
+}
+
+bool MovementInterest::IsMovementOpcode(Opcodes opcode)
+{
+    return opcode == SMSG_MOVE_UPDATE || opcode == SMSG_MONSTER_MOVE || opcode == SMSG_MOVE_TELEPORT;
+}
+
+bool MovementInterest::Relay(WorldObject* mover, WorldPacket const* data, bool throttle)
+{
+    uint32 interval = 0;
+    if (throttle && sWorld->getBoolConfig(CONFIG_MOVEMENT_INTEREST_ENABLE))
+        interval = GetInterval(mover);
+
+    if (!interval)
+    {
+        // whatever is held back is older than this one
+        if (!_movers.empty())
+        {
+            std::unordered_map<uint64, MoverRelay>::iterator itr = _movers.find(mover->GetGUID());
+            if (itr != _movers.end())
+            {
+                DropPending(itr->second);
+                itr->second.LastSent = getMSTime();
+            }
+        }
+
+        ++_counters.Relayed;
+        _counters.RelayedBytes += data->size();
+        return true;
+    }
+
+    uint32 now = getMSTime();
+    MoverRelay& relay = _movers[mover->GetGUID()];
+    if (!relay.LastSent || getMSTimeDiff(relay.LastSent, now) >= interval)
+    {
+        DropPending(relay);
+        relay.LastSent = now;
+
+        ++_counters.Relayed;
+        _counters.RelayedBytes += data->size();
+        return true;
+    }
+
+    if (relay.HasPending)
+    {
+        ++_counters.Superseded;
+        _counters.SavedBytes += relay.Pending.size();
+    }
+    else
+        ++_pendingCount;
+
+    // the storage of the packet held back before is reused
+    relay.Pending = *data;
+    relay.Interval = interval;
+    relay.HasPending = true;
+    ++_counters.Held;
+    return false;
+}
+
+void MovementInterest::Update()
+{
+    uint32 now = getMSTime();
+    bool cleanup = getMSTimeDiff(_lastCleanup, now) >= MOVEMENT_INTEREST_IDLE_TIME;
+
+    if (_pendingCount || cleanup)
+    {
+        for (std::unordered_map<uint64, MoverRelay>::iterator itr = _movers.begin(); itr != _movers.end();)
+        {
+            MoverRelay& relay = itr->second;
+            if (relay.HasPending && getMSTimeDiff(relay.LastSent, now) >= relay.Interval)
+            {
+                // the mover may have left the sight of the player meanwhile
+                if (_owner->m_clientGUIDs.find(itr->first) != _owner->m_clientGUIDs.end())
+                {
+                    _owner->GetSession()->SendPacket(&relay.Pending);
+                    ++_counters.Flushed;
+                    _counters.RelayedBytes += relay.Pending.size();
+
+                    relay.LastSent = now;
+                    relay.HasPending = false;
+                    relay.Pending.clear();
+                    --_pendingCount;
+                }
+                else
+                    DropPending(relay);
+            }
+
+            if (cleanup && !relay.HasPending && getMSTimeDiff(relay.LastSent, now) >= MOVEMENT_INTEREST_IDLE_TIME)
+                itr = _movers.erase(itr);
+            else
+                ++itr;
+        }
+
+        if (cleanup)
+            _lastCleanup = now;
+    }
+
+    if (_counters.Relayed || _counters.Held || _counters.Flushed || _counters.Superseded)
+    {
+        sMovementInterestMgr->AddCounters(_counters);
+        memset(&_counters, 0, sizeof(_counters));
+    }
+}
+
+uint32 MovementInterest::GetInterval(WorldObject* mover) const
+{
+    if (!mover->ToUnit() || IsRelevant(mover))
+        return 0;
+
+    WorldObject const* viewpoint = _owner->m_seer ? _owner->m_seer : _owner;
+    float distSq = viewpoint->GetExactDist2dSq(mover);
+
+    float nearDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE);
+    if (distSq <= nearDist * nearDist)
+        return 0;
+
+    float farDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE);
+    if (distSq <= farDist * farDist)
+        return sWorld->getIntConfig(CONFIG_MOVEMENT_INTEREST_MID_INTERVAL);
+
+    return sWorld->getIntConfig(CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL);
+}
+
+bool MovementInterest::IsRelevant(WorldObject* mover) const
+{
+    Unit* unit = mover->ToUnit();
+
+    // every move counts in an arena
+    if (_owner->GetMap()->IsBattleArena())
+        return true;
+
+    if (_owner->GetSelection() == unit->GetGUID() || _owner->getVictim() == unit)
+        return true;
+
+    if (unit->getVictim() == _owner || unit->GetTargetGUID() == _owner->GetGUID())
+        return true;
+
+    if (unit->GetCharmerOrOwnerGUID() == _owner->GetGUID() || _owner->GetVehicleBase() == unit)
+        return true;
+
+    // group members, their pets and what they control
+    if (Player* player = unit->GetCharmerOrOwnerPlayerOrPlayerItself())
+        if (_owner->IsInSameRaidWith(player))
+            return true;
+
+    return false;
+}
+
+void MovementInterest::DropPending(MoverRelay& relay)
+{
+    if (!relay.HasPending)
+        return;
+
+    ++_counters.Superseded;
+    _counters.SavedBytes += relay.Pending.size();
+
+    relay.HasPending = false;
+    relay.Pending.clear();
+    --_pendingCount;
+}
+
+MovementInterestMgr::MovementInterestMgr() : _relayed(0), _relayedBytes(0), _held(0), _flushed(0), _superseded(0), _savedBytes(0),
+    _savedPerSecond(0.0f), _savedBytesPerSecond(0.0f), _relayedBytesPerSecond(0.0f)
+{
+    memset(&_lastSample, 0, sizeof(_lastSample));
+}
+
+void MovementInterestMgr::AddCounters(MovementInterestCounters const& counters)
+{
+    _relayed.fetch_add(counters.Relayed, std::memory_order_relaxed);
+    _relayedBytes.fetch_add(counters.RelayedBytes, std::memory_order_relaxed);
+    _held.fetch_add(counters.Held, std::memory_order_relaxed);
+    _flushed.fetch_add(counters.Flushed, std::memory_order_relaxed);
+    _superseded.fetch_add(counters.Superseded, std::memory_order_relaxed);
+    _savedBytes.fetch_add(counters.SavedBytes, std::memory_order_relaxed);
+}
+
+void MovementInterestMgr::UpdateRates(uint32 diff)
+{
+    if (!diff)
+        return;
+
+    MovementInterestStats stats = GetStats();
+    float seconds = diff / float(IN_MILLISECONDS);
+
+    _savedPerSecond = (stats.Superseded - _lastSample.Superseded) / seconds;
+    _savedBytesPerSecond = (stats.SavedBytes - _lastSample.SavedBytes) / seconds;
+    _relayedBytesPerSecond = (stats.RelayedBytes - _lastSample.RelayedBytes) / seconds;
+
+    _lastSample = stats;
+}
+
+MovementInterestStats MovementInterestMgr::GetStats() const
+{
+    MovementInterestStats stats;
+    stats.Relayed = _relayed.load(std::memory_order_relaxed);
+    stats.RelayedBytes = _relayedBytes.load(std::memory_order_relaxed);
+    stats.Held = _held.load(std::memory_order_relaxed);
+    stats.Flushed = _flushed.load(std::memory_order_relaxed);
+    stats.Superseded = _superseded.load(std::memory_order_relaxed);
+    stats.SavedBytes = _savedBytes.load(std::memory_order_relaxed);
+    stats.SavedPerSecond = _savedPerSecond;
+    stats.SavedBytesPerSecond = _savedBytesPerSecond;
+    stats.RelayedBytesPerSecond = _relayedBytesPerSecond;
+    return stats;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MOVEMENTINTEREST_H
+#define TRINITY_MOVEMENTINTEREST_H
+
+#include "Common.h"
+#include "WorldPacket.h"
+#include <ace/Singleton.h>
+#include <atomic>
+#include <unordered_map>
+
+#define MOVEMENT_INTEREST_IDLE_TIME     10000               // milliseconds a mover without relays is remembered
+#define MOVEMENT_INTEREST_RATE_INTERVAL 5000                // milliseconds between two samples of the rates
+
+class Player;
+class WorldObject;
+
+struct MovementInterestCounters
+{
+    uint64 Relayed;                                         // sent when they were built
+    uint64 RelayedBytes;
+    uint64 Held;                                            // held back by the band of the receiver
+    uint64 Flushed;                                         // held back and sent once the interval elapsed
+    uint64 Superseded;                                      // held back and replaced by a newer one, never sent
+    uint64 SavedBytes;                                      // of the superseded ones
+};
+
+struct MovementInterestStats : MovementInterestCounters
+{
+    float SavedPerSecond;                                   // packets, over the last MOVEMENT_INTEREST_RATE_INTERVAL
+    float SavedBytesPerSecond;
+    float RelayedBytesPerSecond;
+};
+
+/*
+ * Movement relays of the movers around a player, thinned out by distance.
+ *
+ * The movement updates of the players and the monster moves reach every
+ * player in visibility range through MessageDistDeliverer. Closer than
+ * Movement.Interest.NearDistance they are sent as they come. Further away a
+ * mover gets one relay per Movement.Interest.MidInterval, or FarInterval
+ * beyond Movement.Interest.FarDistance: the relays in between are held
+ * back, each replacing the one before as it carries the whole movement
+ * state, and the last one is sent once the interval elapsed. Group members,
+ * the target of the player, the units fighting or targeting it and arenas
+ * always get every relay. The relays that aren't throttled, like the stop
+ * of a spline, drop what is held back for their mover.
+ *
+ * Only touched by the map thread of the player.
+ */
+class MovementInterest
+{
+    public:
+        explicit MovementInterest(Player* owner);
+        ~MovementInterest() { }
+
+        // false when the packet is held back for the player
+        bool Relay(WorldObject* mover, WorldPacket const* data, bool throttle);
+        // sends what is held back once its interval elapsed, from Player::Update
+        void Update();
+
+        static bool IsMovementOpcode(Opcodes opcode);
+
+    private:
+        struct MoverRelay
+        {
+            MoverRelay() : LastSent(0), Interval(0), HasPending(false) { }
+
+            uint32 LastSent;
+            uint32 Interval;                                // of the band the pending packet was held back in
+            bool HasPending;
+            WorldPacket Pending;
+        };
+
+        uint32 GetInterval(WorldObject* mover) const;
+        bool IsRelevant(WorldObject* mover) const;
+        void DropPending(MoverRelay& relay);
+
+        Player* _owner;
+        std::unordered_map<uint64, MoverRelay> _movers;
+        uint32 _pendingCount;
+        uint32 _lastCleanup;
+        MovementInterestCounters _counters;                 // given to the manager on every update
+};
+
+/*
+ * Counters of the movement relays of all players and the rates sampled
+ * from them on the world thread.
+ */
+class MovementInterestMgr
+{
+    friend class ACE_Singleton<MovementInterestMgr, ACE_Thread_Mutex>;
+
+    private:
+        MovementInterestMgr();
+        ~MovementInterestMgr() { }
+
+    public:
+        void AddCounters(MovementInterestCounters const& counters);
+        void UpdateRates(uint32 diff);
+
+        MovementInterestStats GetStats() const;
+
+    private:
+        std::atomic<uint64> _relayed;
+        std::atomic<uint64> _relayedBytes;
+        std::atomic<uint64> _held;
+        std::atomic<uint64> _flushed;
+        std::atomic<uint64> _superseded;
+        std::atomic<uint64> _savedBytes;
+
+        // world thread only
+        MovementInterestCounters _lastSample;
+        float _savedPerSecond;
+        float _savedBytesPerSecond;
+        float _relayedBytesPerSecond;
+};
+
+#define sMovementInterestMgr ACE_Singleton<MovementInterestMgr, ACE_Thread_Mutex>::instance()
+
+#endif
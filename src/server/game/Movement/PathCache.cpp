@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PathCache.h"
+#include "Timer.h"
+
+PathCache::PathCache() : _deferrableBudget(MAX_DEFERRABLE_PATHS_PER_UPDATE), _expireTimer(PATH_CACHE_TTL)
+{
+}
+
+bool PathCache::Find(dtNavMeshQuery const* query, dtQueryFilter const& filter, dtPolyRef startPoly, dtPolyRef endPoly, dtPolyRef* polyRefs, uint32& polyLength)
+{
+    PathCacheKey key = { query, startPoly, endPoly, filter.getIncludeFlags(), filter.getExcludeFlags() };
+    PathCacheMap::iterator itr = _paths.find(key);
+    if (itr == _paths.end())
+    {
+        ++_stats.Misses;
+        return false;
+    }
+
+    if (getMSTimeDiff(itr->second.createTime, getMSTime()) > PATH_CACHE_TTL)
+    {
+        ++_stats.Expired;
+        ++_stats.Misses;
+        _paths.erase(itr);
+        return false;
+    }
+
+    // tiles can be unloaded and loaded again under the same refs with another salt
+    dtNavMesh const* navMesh = query->getAttachedNavMesh();
+    for (std::vector<dtPolyRef>::const_iterator ref = itr->second.polyRefs.begin(); ref != itr->second.polyRefs.end(); ++ref)
+    {
+        if (!navMesh->isValidPolyRef(*ref))
+        {
+            ++_stats.Invalidated;
+            ++_stats.Misses;
+            _paths.erase(itr);
+            return false;
+        }
+    }
+
+    ++_stats.Hits;
+    polyLength = uint32(itr->second.polyRefs.size());
+    memcpy(polyRefs, &itr->second.polyRefs[0], polyLength * sizeof(dtPolyRef));
+    return true;
+}
+
+void PathCache::Store(dtNavMeshQuery const* query, dtQueryFilter const& filter, dtPolyRef const* polyRefs, uint32 polyLength)
+{
+    if (!polyLength)
+        return;
+
+    if (_paths.size() >= PATH_CACHE_MAX_SIZE)
+    {
+        ++_stats.Flushes;
+        _paths.clear();
+    }
+
+    PathCacheKey key = { query, polyRefs[0], polyRefs[polyLength - 1], filter.getIncludeFlags(), filter.getExcludeFlags() };
+    PathCacheEntry& entry = _paths[key];
+    entry.createTime = getMSTime();
+    entry.polyRefs.assign(polyRefs, polyRefs + polyLength);
+    ++_stats.Stored;
+}
+
+bool PathCache::ReserveDeferrablePath()
+{
+    if (!_deferrableBudget)
+    {
+        ++_stats.Deferred;
+        return false;
+    }
+
+    --_deferrableBudget;
+    ++_stats.Granted;
+    return true;
+}
+
+void PathCache::DeferredPathServed(uint32 waitTime)
+{
+    ++_stats.DeferredServed;
+    _stats.DeferredWaitTotal += waitTime;
+    if (waitTime > _stats.DeferredWaitMax)
+        _stats.DeferredWaitMax = waitTime;
+}
+
+void PathCache::Update(uint32 diff)
+{
+    _deferrableBudget = MAX_DEFERRABLE_PATHS_PER_UPDATE;
+
+    if (_expireTimer > diff)
+    {
+        _expireTimer -= diff;
+        return;
+    }
+
+    _expireTimer = PATH_CACHE_TTL;
+
+    uint32 now = getMSTime();
+    for (PathCacheMap::iterator itr = _paths.begin(); itr != _paths.end();)
+    {
+        if (getMSTimeDiff(itr->second.createTime, now) > PATH_CACHE_TTL)
+        {
+            ++_stats.Expired;
+            itr = _paths.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include "DetourNavMeshQuery.h"
+
+#include <unordered_map>
+#include <vector>
+
+// cached poly paths are dropped after this many milliseconds, tiles may be reloaded meanwhile
+#define PATH_CACHE_TTL                  2000
+// the whole cache is flushed when it grows past this many paths
+#define PATH_CACHE_MAX_SIZE             2048
+// non-urgent path requests (random movement) allowed per map update, the others wait for the next one
+#define MAX_DEFERRABLE_PATHS_PER_UPDATE 50
+
+struct PathCacheKey
+{
+    dtNavMeshQuery const* query;
+    dtPolyRef startPoly;
+    dtPolyRef endPoly;
+    uint16 includeFlags;
+    uint16 excludeFlags;
+
+    bool operator==(PathCacheKey const& right) const
+    {
+        return query == right.query && startPoly == right.startPoly && endPoly == right.endPoly
+            && includeFlags == right.includeFlags && excludeFlags == right.excludeFlags;
+    }
+};
+
+struct PathCacheKeyHash
+{
+    std::size_t operator()(PathCacheKey const& key) const
+    {
+        std::size_t hash = std::hash<dtNavMeshQuery const*>()(key.query);
+        hash = hash * 31 + std::hash<dtPolyRef>()(key.startPoly);
+        hash = hash * 31 + std::hash<dtPolyRef>()(key.endPoly);
+        return hash * 31 + ((uint32(key.includeFlags) << 16) | key.excludeFlags);
+    }
+};
+
+struct PathCacheStats
+{
+    PathCacheStats() : Hits(0), Misses(0), Expired(0), Invalidated(0), Stored(0), Flushes(0),
+        Granted(0), Deferred(0), DeferredWaitTotal(0), DeferredWaitMax(0), DeferredServed(0) { }
+
+    uint64 Hits;
+    uint64 Misses;
+    uint64 Expired;             // found but older than PATH_CACHE_TTL
+    uint64 Invalidated;         // found but a poly was unloaded meanwhile
+    uint64 Stored;
+    uint64 Flushes;             // PATH_CACHE_MAX_SIZE reached
+
+    uint64 Granted;             // non-urgent requests served in the update they were made
+    uint64 Deferred;            // non-urgent requests pushed to a later update
+    uint64 DeferredWaitTotal;   // milliseconds deferred requests waited before being served
+    uint32 DeferredWaitMax;
+    uint64 DeferredServed;      // deferred requests served afterwards
+};
+
+/*
+ * Per-map cache of detour poly corridors keyed by (start poly, end poly, filter),
+ * so units starting and ending on the same polygons - packs chasing one target,
+ * mobs roaming around the same spawn - share one findPath() call. Only the poly
+ * corridor is shared, the point path is still built from each unit's own positions.
+ *
+ * The nav mesh queries are per map instance and not thread safe, so the cache
+ * and the non-urgent request budget live in the Map and are only used from its update.
+ */
+class PathCache
+{
+    public:
+        PathCache();
+
+        bool Find(dtNavMeshQuery const* query, dtQueryFilter const& filter, dtPolyRef startPoly, dtPolyRef endPoly, dtPolyRef* polyRefs, uint32& polyLength);
+        void Store(dtNavMeshQuery const* query, dtQueryFilter const& filter, dtPolyRef const* polyRefs, uint32 polyLength);
+        void Clear() { _paths.clear(); }
+
+        // returns false when this update's budget for non-urgent paths is used, the caller should retry later
+        bool ReserveDeferrablePath();
+        // a request refused by ReserveDeferrablePath() was served after waiting waitTime milliseconds
+        void DeferredPathServed(uint32 waitTime);
+
+        void Update(uint32 diff);
+
+        uint32 GetSize() const { return uint32(_paths.size()); }
+        PathCacheStats const& GetStats() const { return _stats; }
+
+    private:
+        struct PathCacheEntry
+        {
+            uint32 createTime;
+            std::vector<dtPolyRef> polyRefs;
+        };
+
+        typedef std::unordered_map<PathCacheKey, PathCacheEntry, PathCacheKeyHash> PathCacheMap;
+
+        PathCacheMap _paths;
+        PathCacheStats _stats;
+        uint32 _deferrableBudget;
+        uint32 _expireTimer;
+};
+
+#endif
@@ -530,7 +530,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             }
         }
         else
-            dtResult = _navMeshQuery->findPath( startPoly, endPoly, startPoint, endPoint, &_filter, _pathPolyRefs, reinterpret_cast<int*>(&_polyLength), MAX_PATH_LENGTH);
+        {
+            // units starting and ending on the same polys get the same corridor, share it through the map
+            PathCache& cache = _sourceUnit->GetMap()->GetPathCache();
+            if (cache.Find(_navMeshQuery, _filter, startPoly, endPoly, _pathPolyRefs, _polyLength))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = _navMeshQuery->findPath( startPoly, endPoly, startPoint, endPoint, &_filter, _pathPolyRefs, reinterpret_cast<int*>(&_polyLength), MAX_PATH_LENGTH);
+
+                // partial corridors depend on the search limits, keep only the complete ones
+                if (dtStatusSucceed(dtResult) && _polyLength && _pathPolyRefs[_polyLength - 1] == endPoly)
+                    cache.Store(_navMeshQuery, _filter, _pathPolyRefs, _polyLength);
+            }
+        }
 
         if (!_polyLength || dtStatusFailed(dtResult))
         {
@@ -112,9 +112,9 @@ namespace Movement
             plr->GetAnticheatMgr()->SetSplineDuration(move_spline.Duration() + 2000);
         }
 
-        WorldPacket data(SMSG_MONSTER_MOVE, 64);
+        WorldPacket data(SMSG_MONSTER_MOVE, 64 + 12 * args.path.size());
         PacketBuilder::WriteMonsterMove(move_spline, data, unit);
-        unit.SendMessageToSet(&data, true);
+        unit.SendMovementMessageToSet(&data, true);
         //blizz-hack.
         //on retail if creature has loop emote and start run we remove emote, else client crash at getting object create.
         //ToDo: more reseach.
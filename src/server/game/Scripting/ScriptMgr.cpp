@@ -51,6 +51,9 @@ class ScriptRegistry
         // after server startup.
         static ScriptMap ScriptPointerList;
 
+        // Number of registered scripts per hook that did not report the hook as unused.
+        static std::atomic<uint32> HookSubscribers[MAX_SCRIPT_HOOKS];
+
         static void AddScript(TScript* const script)
         {
             ASSERT(script);
@@ -92,6 +95,7 @@ class ScriptRegistry
                     if (!existing)
                     {
                         ScriptPointerList[id] = script;
+                        SubscribeHooks(script);
                         sScriptMgr->IncrementScriptCount();
                     }
                     else
@@ -118,6 +122,7 @@ class ScriptRegistry
             {
                 // We're dealing with a code-only script; just add it.
                 ScriptPointerList[_scriptIdCounter++] = script;
+                SubscribeHooks(script);
                 sScriptMgr->IncrementScriptCount();
             }
         }
@@ -134,6 +139,14 @@ class ScriptRegistry
 
     private:
 
+        // Every hook counts as overridden until the script's default body says otherwise.
+        static void SubscribeHooks(TScript* script)
+        {
+            script->_hookSubscribers = HookSubscribers;
+            for (uint8 i = 0; i < MAX_SCRIPT_HOOKS; ++i)
+                ++HookSubscribers[i];
+        }
+
         // Counter used for code-only scripts.
         static uint32 _scriptIdCounter;
 };
@@ -157,6 +170,12 @@ class ScriptRegistry
 #define FOREACH_SCRIPT(T) \
     FOR_SCRIPTS(T, itr, end) \
     itr->second
+// Only scripts overriding the hook, costs one check when none does
+#define FOREACH_SCRIPT_HOOK(T, H) \
+    if (ScriptRegistry<T>::HookSubscribers[H].load(std::memory_order_relaxed)) \
+        for (SCR_REG_ITR(T) itr = SCR_REG_LST(T).begin(); itr != SCR_REG_LST(T).end(); ++itr) \
+            if (!itr->second->IsHookDisabled(H)) \
+                itr->second
 
 // Utility macros for finding specific scripts.
 #define GET_SCRIPT_NO_RET(T, I, V) \
@@ -524,57 +543,57 @@ void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
 
 void ScriptMgr::OnOpenStateChange(bool open)
 {
-    FOREACH_SCRIPT(WorldScript)->OnOpenStateChange(open);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_OPEN_STATE_CHANGE)->OnOpenStateChange(open);
 }
 
 void ScriptMgr::OnConfigLoad(bool reload)
 {
-    FOREACH_SCRIPT(WorldScript)->OnConfigLoad(reload);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_CONFIG_LOAD)->OnConfigLoad(reload);
 }
 
 void ScriptMgr::OnMotdChange(std::string& newMotd)
 {
-    FOREACH_SCRIPT(WorldScript)->OnMotdChange(newMotd);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_MOTD_CHANGE)->OnMotdChange(newMotd);
 }
 
 void ScriptMgr::OnShutdownInitiate(ShutdownExitCode code, ShutdownMask mask)
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownInitiate(code, mask);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_SHUTDOWN_INITIATE)->OnShutdownInitiate(code, mask);
 }
 
 void ScriptMgr::OnShutdownCancel()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownCancel();
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_SHUTDOWN_CANCEL)->OnShutdownCancel();
 }
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
-    FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_UPDATE)->OnUpdate(diff);
 }
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnHonorCalculation(honor, level, multiplier);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_HONOR_CALCULATION)->OnHonorCalculation(honor, level, multiplier);
 }
 
 void ScriptMgr::OnGrayLevelCalculation(uint8& grayLevel, uint8 playerLevel)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnGrayLevelCalculation(grayLevel, playerLevel);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_GRAY_LEVEL_CALCULATION)->OnGrayLevelCalculation(grayLevel, playerLevel);
 }
 
 void ScriptMgr::OnColorCodeCalculation(XPColorChar& color, uint8 playerLevel, uint8 mobLevel)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnColorCodeCalculation(color, playerLevel, mobLevel);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_COLOR_CODE_CALCULATION)->OnColorCodeCalculation(color, playerLevel, mobLevel);
 }
 
 void ScriptMgr::OnZeroDifferenceCalculation(uint8& diff, uint8 playerLevel)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnZeroDifferenceCalculation(diff, playerLevel);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_ZERO_DIFFERENCE_CALCULATION)->OnZeroDifferenceCalculation(diff, playerLevel);
 }
 
 void ScriptMgr::OnBaseGainCalculation(uint32& gain, uint8 playerLevel, uint8 mobLevel, ContentLevels content)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnBaseGainCalculation(gain, playerLevel, mobLevel, content);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_BASE_GAIN_CALCULATION)->OnBaseGainCalculation(gain, playerLevel, mobLevel, content);
 }
 
 void ScriptMgr::OnGainCalculation(uint32& gain, Player* player, Unit* unit)
@@ -582,12 +601,12 @@ void ScriptMgr::OnGainCalculation(uint32& gain, Player* player, Unit* unit)
     ASSERT(player);
     ASSERT(unit);
 
-    FOREACH_SCRIPT(FormulaScript)->OnGainCalculation(gain, player, unit);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_GAIN_CALCULATION)->OnGainCalculation(gain, player, unit);
 }
 
 void ScriptMgr::OnGroupRateCalculation(float& rate, uint32 count, bool isRaid)
 {
-    FOREACH_SCRIPT(FormulaScript)->OnGroupRateCalculation(rate, count, isRaid);
+    FOREACH_SCRIPT_HOOK(FormulaScript, FORMULA_HOOK_ON_GROUP_RATE_CALCULATION)->OnGroupRateCalculation(rate, count, isRaid);
 }
 
 #define SCR_MAP_BGN(M, V, I, E, C, T) \
@@ -682,7 +701,7 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    FOREACH_SCRIPT(PlayerScript)->OnMapChanged(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_MAP_CHANGED)->OnMapChanged(player);
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
         itr->second->OnPlayerEnter(map, player);
@@ -1214,12 +1233,12 @@ void ScriptMgr::OnRelocate(Transport* transport, uint32 waypointId, uint32 mapId
 
 void ScriptMgr::OnStartup()
 {
-    FOREACH_SCRIPT(WorldScript)->OnStartup();
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_STARTUP)->OnStartup();
 }
 
 void ScriptMgr::OnShutdown()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdown();
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLD_HOOK_ON_SHUTDOWN)->OnShutdown();
 }
 
 bool ScriptMgr::OnCriteriaCheck(AchievementCriteriaData const* data, Player* source, Unit* target)
@@ -1270,137 +1289,137 @@ void ScriptMgr::OnCompletedAchievement(AchievementEntry const* achievement, Play
 // Player
 void ScriptMgr::OnPVPKill(Player* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPVPKill(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_PVP_KILL)->OnPVPKill(killer, killed);
 }
 
 void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_CREATURE_KILL)->OnCreatureKill(killer, killed);
 }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerKilledByCreature(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_PLAYER_KILLED_BY_CREATURE)->OnPlayerKilledByCreature(killer, killed);
 }
 
 void ScriptMgr::OnPlayerDeath(Player *deadPlayer)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerDeath(deadPlayer);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_PLAYER_DEATH)->OnPlayerDeath(deadPlayer);
 }
 
 void ScriptMgr::OnPlayerLevelChanged(Player* player, uint8 oldLevel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLevelChanged(player, oldLevel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_LEVEL_CHANGED)->OnLevelChanged(player, oldLevel);
 }
 
 void ScriptMgr::OnPlayerFreeTalentPointsChanged(Player* player, uint32 points)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFreeTalentPointsChanged(player, points);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_FREE_TALENT_POINTS_CHANGED)->OnFreeTalentPointsChanged(player, points);
 }
 
 void ScriptMgr::OnPlayerTalentsReset(Player* player, bool noCost)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTalentsReset(player, noCost);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_TALENTS_RESET)->OnTalentsReset(player, noCost);
 }
 
 void ScriptMgr::OnPlayerMoneyChanged(Player* player, int64& amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_MONEY_CHANGED)->OnMoneyChanged(player, amount);
 }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_GIVE_XP)->OnGiveXP(player, amount, victim);
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, int32& standing, bool incremental)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_REPUTATION_CHANGE)->OnReputationChange(player, factionID, standing, incremental);
 }
 
 void ScriptMgr::OnPlayerDuelRequest(Player* target, Player* challenger)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelRequest(target, challenger);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_DUEL_REQUEST)->OnDuelRequest(target, challenger);
 }
 
 void ScriptMgr::OnPlayerDuelStart(Player* player1, Player* player2)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelStart(player1, player2);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_DUEL_START)->OnDuelStart(player1, player2);
 }
 
 void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType type)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelEnd(winner, loser, type);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_DUEL_END)->OnDuelEnd(winner, loser, type);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_CHAT)->OnChat(player, type, lang, msg);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_WHISPER)->OnChat(player, type, lang, msg, receiver);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_GROUP_CHAT)->OnChat(player, type, lang, msg, group);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_GUILD_CHAT)->OnChat(player, type, lang, msg, guild);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Channel* channel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, channel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_CHANNEL_CHAT)->OnChat(player, type, lang, msg, channel);
 }
 
 void ScriptMgr::OnPlayerEmote(Player* player, uint32 emote)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnEmote(player, emote);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_EMOTE)->OnEmote(player, emote);
 }
 
 void ScriptMgr::OnPlayerTextEmote(Player* player, uint32 textEmote, uint32 emoteNum, uint64 guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTextEmote(player, textEmote, emoteNum, guid);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_TEXT_EMOTE)->OnTextEmote(player, textEmote, emoteNum, guid);
 }
 
 void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_SPELL_CAST)->OnSpellCast(player, spell, skipCheck);
 }
 
 void ScriptMgr::OnPlayerLogin(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogin(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_LOGIN)->OnLogin(player);
 }
 
 void ScriptMgr::OnPlayerLogout(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogout(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_LOGOUT)->OnLogout(player);
 }
 
 void ScriptMgr::OnPlayerCreate(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreate(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_CREATE)->OnCreate(player);
 }
 
 void ScriptMgr::OnPlayerDelete(uint64 guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDelete(guid);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_DELETE)->OnDelete(guid);
 }
 
 void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, uint32 mapid, bool permanent)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBindToInstance(player, difficulty, mapid, permanent);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_BIND_TO_INSTANCE)->OnBindToInstance(player, difficulty, mapid, permanent);
 }
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYER_HOOK_ON_UPDATE_ZONE)->OnUpdateZone(player, newZone, newArea);
 }
 
 // Guild
@@ -1491,6 +1510,16 @@ void ScriptMgr::OnGroupDisband(Group* group)
     FOREACH_SCRIPT(GroupScript)->OnDisband(group);
 }
 
+void ScriptObject::DisableHook(uint8 hook)
+{
+    uint64 mask = UI64LIT(1) << hook;
+    if (_disabledHooks.fetch_or(mask, std::memory_order_relaxed) & mask)
+        return;
+
+    if (_hookSubscribers)
+        --_hookSubscribers[hook];
+}
+
 SpellScriptLoader::SpellScriptLoader(const char* name)
     : ScriptObject(name)
 {
@@ -1659,6 +1688,7 @@ GroupScript::GroupScript(const char* name)
 // Instantiate static members of ScriptRegistry.
 template<class TScript> std::map<uint32, TScript*> ScriptRegistry<TScript>::ScriptPointerList;
 template<class TScript> uint32 ScriptRegistry<TScript>::_scriptIdCounter = 0;
+template<class TScript> std::atomic<uint32> ScriptRegistry<TScript>::HookSubscribers[MAX_SCRIPT_HOOKS];
 
 // Specialize for each script type class like so:
 template class ScriptRegistry<SpellScriptLoader>;
@@ -1691,6 +1721,7 @@ template class ScriptRegistry<GroupScript>;
 // Undefine utility macros.
 #undef GET_SCRIPT_RET
 #undef GET_SCRIPT
+#undef FOREACH_SCRIPT_HOOK
 #undef FOREACH_SCRIPT
 #undef FOR_SCRIPTS_RET
 #undef FOR_SCRIPTS
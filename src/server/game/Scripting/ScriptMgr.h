@@ -20,6 +20,7 @@
 #define SC_SCRIPTMGR_H
 
 #include "Common.h"
+#include <atomic>
 #include <ace/Singleton.h>
 #include <ace/Atomic_Op.h>
 
@@ -147,11 +148,20 @@ void DoScriptText(int32 textEntry, WorldObject* pSource, Unit* target = NULL);
 
     Now you simply call these two functions from anywhere in the core to trigger the
     event on all registered scripts of that type.
+
+    Hooks that are called often should only reach scripts that override them. Give the
+    hook an id below MAX_SCRIPT_HOOKS, call DisableHook(id) from its default body and
+    dispatch it with FOREACH_SCRIPT_HOOK(MyScriptType, id) instead of FOREACH_SCRIPT.
 */
 
+template<class TScript> class ScriptRegistry;
+
+#define MAX_SCRIPT_HOOKS 64
+
 class ScriptObject
 {
     friend class ScriptMgr;
+    template<class TScript> friend class ScriptRegistry;
 
     public:
 
@@ -161,10 +171,13 @@ class ScriptObject
 
         const std::string& GetName() const { return _name; }
 
+        // True once the default (empty) body of the hook was called, the script doesn't override it
+        bool IsHookDisabled(uint8 hook) const { return (_disabledHooks.load(std::memory_order_relaxed) & (UI64LIT(1) << hook)) != 0; }
+
     protected:
 
         ScriptObject(const char* name)
-            : _name(name)
+            : _name(name), _disabledHooks(0), _hookSubscribers(NULL)
         {
         }
 
@@ -172,9 +185,14 @@ class ScriptObject
         {
         }
 
+        // Called from the default bodies of dispatched hooks, so the script is skipped for that hook afterwards
+        void DisableHook(uint8 hook);
+
     private:
 
         const std::string _name;
+        std::atomic<uint64> _disabledHooks;
+        std::atomic<uint32>* _hookSubscribers;              // subscriber counters of the script type, set at registration
 };
 
 template<class TObject> class UpdatableScript
@@ -241,6 +259,19 @@ class ServerScript : public ScriptObject
         virtual void OnUnknownPacketReceive(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
 };
 
+enum WorldScriptHook
+{
+    WORLD_HOOK_ON_OPEN_STATE_CHANGE = 0,
+    WORLD_HOOK_ON_CONFIG_LOAD,
+    WORLD_HOOK_ON_MOTD_CHANGE,
+    WORLD_HOOK_ON_SHUTDOWN_INITIATE,
+    WORLD_HOOK_ON_SHUTDOWN_CANCEL,
+    WORLD_HOOK_ON_UPDATE,
+    WORLD_HOOK_ON_STARTUP,
+    WORLD_HOOK_ON_SHUTDOWN,
+    WORLD_HOOK_END
+};
+
 class WorldScript : public ScriptObject
 {
     protected:
@@ -250,28 +281,40 @@ class WorldScript : public ScriptObject
     public:
 
         // Called when the open/closed state of the world changes.
-        virtual void OnOpenStateChange(bool /*open*/) { }
+        virtual void OnOpenStateChange(bool /*open*/) { DisableHook(WORLD_HOOK_ON_OPEN_STATE_CHANGE); }
 
         // Called after the world configuration is (re)loaded.
-        virtual void OnConfigLoad(bool /*reload*/) { }
+        virtual void OnConfigLoad(bool /*reload*/) { DisableHook(WORLD_HOOK_ON_CONFIG_LOAD); }
 
         // Called before the message of the day is changed.
-        virtual void OnMotdChange(std::string& /*newMotd*/) { }
+        virtual void OnMotdChange(std::string& /*newMotd*/) { DisableHook(WORLD_HOOK_ON_MOTD_CHANGE); }
 
         // Called when a world shutdown is initiated.
-        virtual void OnShutdownInitiate(ShutdownExitCode /*code*/, ShutdownMask /*mask*/) { }
+        virtual void OnShutdownInitiate(ShutdownExitCode /*code*/, ShutdownMask /*mask*/) { DisableHook(WORLD_HOOK_ON_SHUTDOWN_INITIATE); }
 
         // Called when a world shutdown is cancelled.
-        virtual void OnShutdownCancel() { }
+        virtual void OnShutdownCancel() { DisableHook(WORLD_HOOK_ON_SHUTDOWN_CANCEL); }
 
         // Called on every world tick (don't execute too heavy code here).
-        virtual void OnUpdate(uint32 /*diff*/) { }
+        virtual void OnUpdate(uint32 /*diff*/) { DisableHook(WORLD_HOOK_ON_UPDATE); }
 
         // Called when the world is started.
-        virtual void OnStartup() { }
+        virtual void OnStartup() { DisableHook(WORLD_HOOK_ON_STARTUP); }
 
         // Called when the world is actually shut down.
-        virtual void OnShutdown() { }
+        virtual void OnShutdown() { DisableHook(WORLD_HOOK_ON_SHUTDOWN); }
+};
+
+enum FormulaScriptHook
+{
+    FORMULA_HOOK_ON_HONOR_CALCULATION = 0,
+    FORMULA_HOOK_ON_GRAY_LEVEL_CALCULATION,
+    FORMULA_HOOK_ON_COLOR_CODE_CALCULATION,
+    FORMULA_HOOK_ON_ZERO_DIFFERENCE_CALCULATION,
+    FORMULA_HOOK_ON_BASE_GAIN_CALCULATION,
+    FORMULA_HOOK_ON_GAIN_CALCULATION,
+    FORMULA_HOOK_ON_GROUP_RATE_CALCULATION,
+    FORMULA_HOOK_END
 };
 
 class FormulaScript : public ScriptObject
@@ -283,25 +326,25 @@ class FormulaScript : public ScriptObject
     public:
 
         // Called after calculating honor.
-        virtual void OnHonorCalculation(float& /*honor*/, uint8 /*level*/, float /*multiplier*/) { }
+        virtual void OnHonorCalculation(float& /*honor*/, uint8 /*level*/, float /*multiplier*/) { DisableHook(FORMULA_HOOK_ON_HONOR_CALCULATION); }
 
         // Called after gray level calculation.
-        virtual void OnGrayLevelCalculation(uint8& /*grayLevel*/, uint8 /*playerLevel*/) { }
+        virtual void OnGrayLevelCalculation(uint8& /*grayLevel*/, uint8 /*playerLevel*/) { DisableHook(FORMULA_HOOK_ON_GRAY_LEVEL_CALCULATION); }
 
         // Called after calculating experience color.
-        virtual void OnColorCodeCalculation(XPColorChar& /*color*/, uint8 /*playerLevel*/, uint8 /*mobLevel*/) { }
+        virtual void OnColorCodeCalculation(XPColorChar& /*color*/, uint8 /*playerLevel*/, uint8 /*mobLevel*/) { DisableHook(FORMULA_HOOK_ON_COLOR_CODE_CALCULATION); }
 
         // Called after calculating zero difference.
-        virtual void OnZeroDifferenceCalculation(uint8& /*diff*/, uint8 /*playerLevel*/) { }
+        virtual void OnZeroDifferenceCalculation(uint8& /*diff*/, uint8 /*playerLevel*/) { DisableHook(FORMULA_HOOK_ON_ZERO_DIFFERENCE_CALCULATION); }
 
         // Called after calculating base experience gain.
-        virtual void OnBaseGainCalculation(uint32& /*gain*/, uint8 /*playerLevel*/, uint8 /*mobLevel*/, ContentLevels /*content*/) { }
+        virtual void OnBaseGainCalculation(uint32& /*gain*/, uint8 /*playerLevel*/, uint8 /*mobLevel*/, ContentLevels /*content*/) { DisableHook(FORMULA_HOOK_ON_BASE_GAIN_CALCULATION); }
 
         // Called after calculating experience gain.
-        virtual void OnGainCalculation(uint32& /*gain*/, Player* /*player*/, Unit* /*unit*/) { }
+        virtual void OnGainCalculation(uint32& /*gain*/, Player* /*player*/, Unit* /*unit*/) { DisableHook(FORMULA_HOOK_ON_GAIN_CALCULATION); }
 
         // Called when calculating the experience rate for group experience.
-        virtual void OnGroupRateCalculation(float& /*rate*/, uint32 /*count*/, bool /*isRaid*/) { }
+        virtual void OnGroupRateCalculation(float& /*rate*/, uint32 /*count*/, bool /*isRaid*/) { DisableHook(FORMULA_HOOK_ON_GROUP_RATE_CALCULATION); }
 };
 
 template<class TMap> class MapScript : public UpdatableScript<TMap>
@@ -699,6 +742,39 @@ class AchievementScript : public ScriptObject
         virtual void OnCompletedAchievement(AchievementEntry const* /*achievement*/, Player* /*source*/) { }
 };
 
+enum PlayerScriptHook
+{
+    PLAYER_HOOK_ON_PVP_KILL = 0,
+    PLAYER_HOOK_ON_CREATURE_KILL,
+    PLAYER_HOOK_ON_PLAYER_KILLED_BY_CREATURE,
+    PLAYER_HOOK_ON_PLAYER_DEATH,
+    PLAYER_HOOK_ON_LEVEL_CHANGED,
+    PLAYER_HOOK_ON_FREE_TALENT_POINTS_CHANGED,
+    PLAYER_HOOK_ON_TALENTS_RESET,
+    PLAYER_HOOK_ON_MONEY_CHANGED,
+    PLAYER_HOOK_ON_GIVE_XP,
+    PLAYER_HOOK_ON_REPUTATION_CHANGE,
+    PLAYER_HOOK_ON_DUEL_REQUEST,
+    PLAYER_HOOK_ON_DUEL_START,
+    PLAYER_HOOK_ON_DUEL_END,
+    PLAYER_HOOK_ON_CHAT,
+    PLAYER_HOOK_ON_WHISPER,
+    PLAYER_HOOK_ON_GROUP_CHAT,
+    PLAYER_HOOK_ON_GUILD_CHAT,
+    PLAYER_HOOK_ON_CHANNEL_CHAT,
+    PLAYER_HOOK_ON_EMOTE,
+    PLAYER_HOOK_ON_TEXT_EMOTE,
+    PLAYER_HOOK_ON_SPELL_CAST,
+    PLAYER_HOOK_ON_LOGIN,
+    PLAYER_HOOK_ON_LOGOUT,
+    PLAYER_HOOK_ON_CREATE,
+    PLAYER_HOOK_ON_DELETE,
+    PLAYER_HOOK_ON_BIND_TO_INSTANCE,
+    PLAYER_HOOK_ON_UPDATE_ZONE,
+    PLAYER_HOOK_ON_MAP_CHANGED,
+    PLAYER_HOOK_END
+};
+
 class PlayerScript : public ScriptObject
 {
     protected:
@@ -708,83 +784,83 @@ class PlayerScript : public ScriptObject
     public:
 
         // Called when a player kills another player
-        virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { }
+        virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { DisableHook(PLAYER_HOOK_ON_PVP_KILL); }
 
         // Called when a player kills a creature
-        virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { }
+        virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { DisableHook(PLAYER_HOOK_ON_CREATURE_KILL); }
 
         // Called when a player is killed by a creature
-        virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { }
+        virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { DisableHook(PLAYER_HOOK_ON_PLAYER_KILLED_BY_CREATURE); }
         
         // Called when a player is dead
-        virtual void OnPlayerDeath(Player* /*deadPlayer*/) {}
+        virtual void OnPlayerDeath(Player* /*deadPlayer*/) { DisableHook(PLAYER_HOOK_ON_PLAYER_DEATH); }
 
         // Called when a player's level changes (right before the level is applied)
-        virtual void OnLevelChanged(Player* /*player*/, uint8 /*newLevel*/) { }
+        virtual void OnLevelChanged(Player* /*player*/, uint8 /*newLevel*/) { DisableHook(PLAYER_HOOK_ON_LEVEL_CHANGED); }
 
         // Called when a player's free talent points change (right before the change is applied)
-        virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) { }
+        virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) { DisableHook(PLAYER_HOOK_ON_FREE_TALENT_POINTS_CHANGED); }
 
         // Called when a player's talent points are reset (right before the reset is done)
-        virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { }
+        virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { DisableHook(PLAYER_HOOK_ON_TALENTS_RESET); }
 
         // Called when a player's money is modified (before the modification is done)
-        virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) { }
+        virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) { DisableHook(PLAYER_HOOK_ON_MONEY_CHANGED); }
 
         // Called when a player gains XP (before anything is given)
-        virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) { }
+        virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) { DisableHook(PLAYER_HOOK_ON_GIVE_XP); }
 
         // Called when a player's reputation changes (before it is actually changed)
-        virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, int32& /*standing*/, bool /*incremental*/) { }
+        virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, int32& /*standing*/, bool /*incremental*/) { DisableHook(PLAYER_HOOK_ON_REPUTATION_CHANGE); }
 
         // Called when a duel is requested
-        virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) { }
+        virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) { DisableHook(PLAYER_HOOK_ON_DUEL_REQUEST); }
 
         // Called when a duel starts (after 3s countdown)
-        virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) { }
+        virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) { DisableHook(PLAYER_HOOK_ON_DUEL_START); }
 
         // Called when a duel ends
-        virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) { }
+        virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) { DisableHook(PLAYER_HOOK_ON_DUEL_END); }
 
         // The following methods are called when a player sends a chat message.
-        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) { }
+        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) { DisableHook(PLAYER_HOOK_ON_CHAT); }
 
-        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) { }
+        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) { DisableHook(PLAYER_HOOK_ON_WHISPER); }
 
-        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) { }
+        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) { DisableHook(PLAYER_HOOK_ON_GROUP_CHAT); }
 
-        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) { }
+        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) { DisableHook(PLAYER_HOOK_ON_GUILD_CHAT); }
 
-        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) { }
+        virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) { DisableHook(PLAYER_HOOK_ON_CHANNEL_CHAT); }
 
         // Both of the below are called on emote opcodes.
-        virtual void OnEmote(Player* /*player*/, uint32 /*emote*/) { }
+        virtual void OnEmote(Player* /*player*/, uint32 /*emote*/) { DisableHook(PLAYER_HOOK_ON_EMOTE); }
 
-        virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, uint64 /*guid*/) { }
+        virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, uint64 /*guid*/) { DisableHook(PLAYER_HOOK_ON_TEXT_EMOTE); }
 
         // Called in Spell::Cast.
-        virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { }
+        virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { DisableHook(PLAYER_HOOK_ON_SPELL_CAST); }
 
         // Called when a player logs in.
-        virtual void OnLogin(Player* /*player*/) { }
+        virtual void OnLogin(Player* /*player*/) { DisableHook(PLAYER_HOOK_ON_LOGIN); }
 
         // Called when a player logs out.
-        virtual void OnLogout(Player* /*player*/) { }
+        virtual void OnLogout(Player* /*player*/) { DisableHook(PLAYER_HOOK_ON_LOGOUT); }
 
         // Called when a player is created.
-        virtual void OnCreate(Player* /*player*/) { }
+        virtual void OnCreate(Player* /*player*/) { DisableHook(PLAYER_HOOK_ON_CREATE); }
 
         // Called when a player is deleted.
-        virtual void OnDelete(uint64 /*guid*/) { }
+        virtual void OnDelete(uint64 /*guid*/) { DisableHook(PLAYER_HOOK_ON_DELETE); }
 
         // Called when a player is bound to an instance
-        virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { }
+        virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { DisableHook(PLAYER_HOOK_ON_BIND_TO_INSTANCE); }
 
         // Called when a player switches to a new zone
-        virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { }
+        virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { DisableHook(PLAYER_HOOK_ON_UPDATE_ZONE); }
 
         // Called when a player changes to a new map (after moving to new map)
-        virtual void OnMapChanged(Player* /*player*/) { }
+        virtual void OnMapChanged(Player* /*player*/) { DisableHook(PLAYER_HOOK_ON_MAP_CHANGED); }
 };
 
 class GuildScript : public ScriptObject
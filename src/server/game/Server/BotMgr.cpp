@@ -0,0 +1,802 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BotMgr.h"
+#include "CellImpl.h"
+#include "Config.h"
+#include "DBCStores.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "MovementInterest.h"
+#include "ObjectAccessor.h"
+#include "ObjectMgr.h"
+#include "ObjectVisitors.hpp"
+#include "Player.h"
+#include "Profiler.h"
+#include "SpellInfo.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <sstream>
+
+#if PLATFORM == PLATFORM_UNIX
+#include <unistd.h>
+#endif
+
+enum BotSpells
+{
+    SPELL_BOT_FIREBALL              = 133,
+    SPELL_BOT_BLIZZARD              = 10,
+    SPELL_BOT_ARCANE_BRILLIANCE     = 1459
+};
+
+#define BOT_MAX_HEARTBEATS              200                 // a bot that didn't get there after this many heartbeats stops
+
+static char const* const BotMessages[] =
+{
+    "LFG anyone?",
+    "WTS [Linen Cloth] x20, pst",
+    "where is the flight master?",
+    "lol",
+    "anyone up for a dungeon run later tonight? need a healer and two dps"
+};
+
+static char const* const BotSearches[] =
+{
+    "",
+    "cloth",
+    "potion",
+    "of the",
+    "sword"
+};
+
+namespace
+{
+    class NearestAuctioneerCheck
+    {
+        public:
+            NearestAuctioneerCheck(WorldObject const* obj, float range) : _obj(obj), _range(range) { }
+
+            bool operator()(Creature* creature)
+            {
+                if (creature->isAuctioner() && creature->IsAlive() && _obj->IsWithinDistInMap(creature, _range))
+                {
+                    _range = _obj->GetDistance(creature);
+                    return true;
+                }
+
+                return false;
+            }
+
+        private:
+            WorldObject const* _obj;
+            float _range;
+    };
+}
+
+void BotStats::Reset()
+{
+    Logins = 0;
+    memset(Packets, 0, sizeof(Packets));
+    MaxBots = 0;
+}
+
+BotMgr::BotMgr() : _nextAccount(BOT_ACCOUNT_ID_BASE), _nextBehaviour(BOT_BEHAVIOUR_MOVE), _nextTick(0), _benchmark(false)
+{
+    _logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!_logsDir.empty())
+        if ((_logsDir.at(_logsDir.length() - 1) != '/') && (_logsDir.at(_logsDir.length() - 1) != '\\'))
+            _logsDir.push_back('/');
+}
+
+void BotMgr::AddBots(uint32 count, BotBehaviour behaviour, WorldLocation const& location, uint32 phaseMask, uint32 team)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        PendingBot pending;
+        pending.Behaviour = behaviour;
+        if (behaviour == BOT_BEHAVIOUR_MIXED)
+        {
+            pending.Behaviour = BotBehaviour(_nextBehaviour);
+            if (++_nextBehaviour == BOT_BEHAVIOUR_MIXED)
+                _nextBehaviour = BOT_BEHAVIOUR_MOVE;
+        }
+
+        pending.Location.WorldRelocate(location);
+        pending.PhaseMask = phaseMask;
+        pending.Team = team;
+        _pending.push_back(pending);
+    }
+}
+
+void BotMgr::RemoveBots(uint32 count)
+{
+    bool all = !count;
+
+    // the bots still waiting to log in go first
+    while (!_pending.empty() && (all || count))
+    {
+        _pending.pop_back();
+        if (!all)
+            --count;
+    }
+
+    while (!_bots.empty() && (all || count))
+    {
+        Logout(_bots.back());
+        _bots.pop_back();
+        if (!all)
+            --count;
+    }
+}
+
+bool BotMgr::Login(PendingBot const& pending)
+{
+    Map* map = sMapMgr->CreateBaseMap(pending.Location.GetMapId());
+    if (!map || map->Instanceable())
+    {
+        TC_LOG_ERROR("server", "BotMgr: bots can't log in on map %u, only continents are supported", pending.Location.GetMapId());
+        return false;
+    }
+
+    uint32 accountId = _nextAccount++;
+    std::ostringstream name;
+    name << "Bot" << (accountId - BOT_ACCOUNT_ID_BASE);
+
+    WorldSession* session = new WorldSession(accountId, name.str(), NULL, SEC_PLAYER, uint8(sWorld->getIntConfig(CONFIG_EXPANSION)), 0, LOCALE_enUS, 0, false);
+    session->SetBot(true);
+
+    WorldPacket createData;
+    CharacterCreateInfo createInfo(name.str(), pending.Team == ALLIANCE ? RACE_HUMAN : RACE_ORC, CLASS_MAGE, accountId % 2 ? GENDER_FEMALE : GENDER_MALE,
+        0, 0, 0, 0, 0, 0, createData);
+
+    Player* player = new Player(session);
+    player->GetMotionMaster()->Initialize();
+    if (!player->Create(sObjectMgr->GenerateLowGuid(HIGHGUID_PLAYER), &createInfo))
+    {
+        player->CleanupsBeforeDelete();
+        delete player;
+        delete session;
+        return false;
+    }
+
+    // created at the start location of the race
+    if (player->GetMap() != map)
+    {
+        player->ResetMap();
+        player->SetMap(map);
+    }
+
+    player->Relocate(pending.Location);
+    player->m_homebindMapId = pending.Location.GetMapId();
+    player->m_homebindAreaId = 0;
+    player->m_homebindX = pending.Location.GetPositionX();
+    player->m_homebindY = pending.Location.GetPositionY();
+    player->m_homebindZ = pending.Location.GetPositionZ();
+    player->SetPhaseMask(pending.PhaseMask, false);
+    player->setCinematic(1);
+
+    player->learnSpell(SPELL_BOT_FIREBALL, false);
+    player->learnSpell(SPELL_BOT_BLIZZARD, false);
+    player->learnSpell(SPELL_BOT_ARCANE_BRILLIANCE, false);
+
+    session->SetPlayer(player);
+    player->SendInitialPacketsBeforeAddToMap();
+
+    if (!map->AddPlayerToMap(player))
+    {
+        TC_LOG_ERROR("server", "BotMgr: bot %s couldn't be added to map %u", player->GetName(), map->GetId());
+        session->SetPlayer(NULL);
+        player->CleanupsBeforeDelete();
+        delete player;
+        delete session;
+        return false;
+    }
+
+    sObjectAccessor->AddObject(player);
+    player->SendInitialPacketsAfterAddToMap();
+    player->SetInGameTime(getMSTime());
+
+    sWorld->AddCharacterNameData(player->GetGUIDLow(), player->GetName(), player->getGender(), player->getRace(), player->getClass(), player->getLevel());
+
+    Bot bot;
+    bot.Session = session;
+    bot.Behaviour = pending.Behaviour;
+    bot.Home.Relocate(pending.Location);
+    bot.Destination.Relocate(pending.Location);
+    bot.Moving = false;
+    bot.MoveTime = 0;
+    bot.Heartbeats = 0;
+    bot.ActionTimer = urand(0, 5 * IN_MILLISECONDS);    // the bots logged in together don't act together
+    bot.CastCount = 0;
+    bot.Auctioneer = 0;
+    _bots.push_back(bot);
+
+    ++_stats.Logins;
+    _stats.MaxBots = std::max(_stats.MaxBots, uint32(_bots.size()));
+    return true;
+}
+
+void BotMgr::Logout(Bot& bot)
+{
+    if (Player* player = bot.Session->GetPlayer())
+    {
+        uint32 guidLow = player->GetGUIDLow();
+        bot.Session->LogoutPlayer(false);
+        sWorld->DeleteCharacterNameData(guidLow);
+    }
+
+    delete bot.Session;
+    bot.Session = NULL;
+}
+
+void BotMgr::Update(uint32 diff)
+{
+    if (_bots.empty() && _pending.empty())
+        return;
+
+    PROFILE_SCOPE("BotMgr::Update");
+
+    bool loggingIn = !_pending.empty();
+    for (uint32 i = 0; i < BOT_LOGINS_PER_UPDATE && !_pending.empty(); ++i)
+    {
+        Login(_pending.front());
+        _pending.pop_front();
+    }
+
+    // the benchmark measures the bots once they are all in, without the logins
+    if (loggingIn && _pending.empty())
+    {
+        TC_LOG_INFO("server", "BotMgr: %u bots logged in", uint32(_bots.size()));
+
+        if (_benchmark)
+        {
+            _ticks.clear();
+            _nextTick = 0;
+            sProfiler->Reset();
+
+            uint32 duration = sWorld->getIntConfig(CONFIG_BOTS_BENCHMARK_DURATION);
+            sWorld->GetScheduler().ScheduleOnce("bot benchmark", std::max<uint32>(duration, 1) * IN_MILLISECONDS, [this]() { FinishBenchmark(); });
+            TC_LOG_INFO("server", "BotMgr: benchmark running for %u seconds", duration);
+        }
+    }
+
+    for (std::list<Bot>::iterator itr = _bots.begin(); itr != _bots.end();)
+    {
+        // the packets that can't be handled on the map thread, the others were handled by the map update
+        WorldSessionFilter updater(itr->Session);
+        itr->Session->Update(diff, updater);
+
+        // logged out by a kick or a script
+        if (!itr->Session->GetPlayer())
+        {
+            Logout(*itr);
+            itr = _bots.erase(itr);
+            continue;
+        }
+
+        UpdateBot(*itr, diff);
+        ++itr;
+    }
+}
+
+void BotMgr::UpdateBot(Bot& bot, uint32 diff)
+{
+    Player* player = bot.Session->GetPlayer();
+    if (!player->IsInWorld() || player->IsBeingTeleported())
+        return;
+
+    // nobody releases the spirit of a bot, it gets up where it died
+    if (player->isDead())
+    {
+        player->ResurrectPlayer(1.0f);
+        player->SpawnCorpseBones();
+        bot.Moving = false;
+        return;
+    }
+
+    if (bot.Moving)
+    {
+        UpdateMovement(bot, player, diff);
+        return;
+    }
+
+    switch (bot.Behaviour)
+    {
+        case BOT_BEHAVIOUR_MOVE:
+        {
+            Position destination;
+            float angle = frand(0.0f, 2.0f * M_PI);
+            float distance = frand(BOT_WANDER_RADIUS / 4.0f, BOT_WANDER_RADIUS);
+            destination.Relocate(bot.Home.GetPositionX() + distance * std::cos(angle), bot.Home.GetPositionY() + distance * std::sin(angle), bot.Home.GetPositionZ());
+            StartMoving(bot, player, destination);
+            return;
+        }
+        case BOT_BEHAVIOUR_CAST:
+        case BOT_BEHAVIOUR_AOE:
+        case BOT_BEHAVIOUR_CHAT:
+        case BOT_BEHAVIOUR_AUCTION:
+            break;
+        default:
+            return;
+    }
+
+    if (bot.ActionTimer > diff)
+    {
+        bot.ActionTimer -= diff;
+        return;
+    }
+
+    switch (bot.Behaviour)
+    {
+        case BOT_BEHAVIOUR_CAST:
+            Cast(bot, player, false);
+            bot.ActionTimer = urand(3 * IN_MILLISECONDS, 4 * IN_MILLISECONDS);      // fireball takes 2.5 seconds
+            break;
+        case BOT_BEHAVIOUR_AOE:
+            Cast(bot, player, true);
+            bot.ActionTimer = urand(9 * IN_MILLISECONDS, 10 * IN_MILLISECONDS);     // blizzard is channeled for 8 seconds
+            break;
+        case BOT_BEHAVIOUR_CHAT:
+            Say(bot, player);
+            bot.ActionTimer = urand(5 * IN_MILLISECONDS, 15 * IN_MILLISECONDS);
+            break;
+        case BOT_BEHAVIOUR_AUCTION:
+            BrowseAuctions(bot, player);
+            bot.ActionTimer = urand(10 * IN_MILLISECONDS, 20 * IN_MILLISECONDS);
+            break;
+        default:
+            break;
+    }
+}
+
+void BotMgr::StartMoving(Bot& bot, Player* player, Position const& destination)
+{
+    bot.Destination.Relocate(destination);
+    player->UpdateGroundPositionZ(bot.Destination.m_positionX, bot.Destination.m_positionY, bot.Destination.m_positionZ);
+    bot.Moving = true;
+    bot.MoveTime = 0;
+    bot.Heartbeats = 0;
+
+    Position position;
+    player->GetPosition(&position);
+    position.SetOrientation(player->GetAngle(&bot.Destination));
+    SendMovement(bot, player, CMSG_MOVE_START_FORWARD, position);
+}
+
+void BotMgr::UpdateMovement(Bot& bot, Player* player, uint32 diff)
+{
+    bot.MoveTime += diff;
+    if (bot.MoveTime < BOT_HEARTBEAT_INTERVAL)
+        return;
+
+    // where the client would be after running straight to the destination for that long
+    float step = player->GetSpeed(MOVE_RUN) * bot.MoveTime / IN_MILLISECONDS;
+    float angle = player->GetAngle(&bot.Destination);
+    bot.MoveTime = 0;
+
+    Position position;
+    if (player->GetExactDist2d(&bot.Destination) <= step || ++bot.Heartbeats >= BOT_MAX_HEARTBEATS)
+    {
+        position.Relocate(bot.Destination);
+        position.SetOrientation(angle);
+        bot.Moving = false;
+        bot.ActionTimer = std::min<uint32>(bot.ActionTimer, urand(0, 2 * IN_MILLISECONDS));
+        SendMovement(bot, player, CMSG_MOVE_STOP, position);
+        return;
+    }
+
+    position.Relocate(player->GetPositionX() + step * std::cos(angle), player->GetPositionY() + step * std::sin(angle), player->GetPositionZ(), angle);
+    player->UpdateGroundPositionZ(position.m_positionX, position.m_positionY, position.m_positionZ);
+    SendMovement(bot, player, CMSG_MOVE_HEARTBEAT, position);
+}
+
+void BotMgr::Cast(Bot& bot, Player* player, bool aoe)
+{
+    // bots don't drink
+    player->SetPower(POWER_MANA, player->GetMaxPower(POWER_MANA));
+
+    Unit* target = NULL;
+    Trinity::NearestAttackableUnitInObjectRangeCheck check(player, player, BOT_TARGET_RANGE);
+    Trinity::UnitLastSearcher<Trinity::NearestAttackableUnitInObjectRangeCheck> searcher(player, target, check);
+    Trinity::VisitNearbyObject(player, BOT_TARGET_RANGE, searcher);
+
+    uint32 spellId = SPELL_BOT_ARCANE_BRILLIANCE;
+    uint32 targetMask = TARGET_FLAG_NONE;
+    ObjectGuid targetGuid = 0;
+    Position destination;
+
+    if (aoe)
+    {
+        spellId = SPELL_BOT_BLIZZARD;
+        targetMask = TARGET_FLAG_DEST_LOCATION;
+        if (target)
+            target->GetPosition(&destination);
+        else
+        {
+            player->GetNearPoint2D(destination.m_positionX, destination.m_positionY, 10.0f, player->GetOrientation());
+            destination.m_positionZ = player->GetPositionZ();
+            player->UpdateGroundPositionZ(destination.m_positionX, destination.m_positionY, destination.m_positionZ);
+        }
+    }
+    else if (target)
+    {
+        spellId = SPELL_BOT_FIREBALL;
+        targetMask = TARGET_FLAG_UNIT;
+        targetGuid = target->GetGUID();
+    }
+
+    // turn to the target first, like the client does
+    if (target && !player->HasInArc(static_cast<float>(M_PI), target))
+    {
+        Position position;
+        player->GetPosition(&position);
+        position.SetOrientation(player->GetAngle(target));
+        SendMovement(bot, player, CMSG_MOVE_SET_FACING, position);
+    }
+
+    bool hasDst = targetMask & TARGET_FLAG_DEST_LOCATION;
+    ObjectGuid itemGuid = 0;
+    ObjectGuid dstTransportGuid = 0;
+
+    // the order HandleCastSpellOpcode reads it in
+    WorldPacket* packet = new WorldPacket(CMSG_CAST_SPELL, 64);
+    packet->WriteBit(1);                                    // no glyph index
+    packet->WriteBit(1);                                    // no string target
+    packet->WriteBit(0);                                    // no source
+    packet->WriteBit(0);                                    // has spell id
+    packet->WriteBit(0);                                    // has cast count
+    packet->WriteBit(0);                                    // has target mask
+    packet->WriteBit(1);                                    // no missile speed
+    packet->WriteBit(0);                                    // item target guid marker
+    packet->WriteBits(0, 2);                                // archaeology weights
+    packet->WriteBit(0);                                    // no movement
+    packet->WriteBit(0);                                    // target guid marker
+    packet->WriteBit(1);                                    // no cast flags
+    packet->WriteBit(hasDst);
+    packet->WriteBit(1);                                    // no elevation
+    if (hasDst)
+        packet->WriteGuidMask<3, 5, 1, 7, 0, 6, 2, 4>(dstTransportGuid);
+    packet->WriteGuidMask<0, 4, 3, 1, 6, 5, 7, 2>(targetGuid);
+    packet->WriteGuidMask<3, 4, 2, 0, 7, 6, 5, 1>(itemGuid);
+    packet->WriteBits(targetMask, 20);
+    packet->FlushBits();
+
+    packet->WriteGuidBytes<4, 3, 5, 6, 0, 7, 2, 1>(itemGuid);
+    if (hasDst)
+    {
+        *packet << float(destination.GetPositionZ());
+        packet->WriteGuidBytes<1, 3, 7, 6, 0, 2>(dstTransportGuid);
+        *packet << float(destination.GetPositionY());
+        packet->WriteGuidBytes<5>(dstTransportGuid);
+        *packet << float(destination.GetPositionX());
+        packet->WriteGuidBytes<4>(dstTransportGuid);
+    }
+    packet->WriteGuidBytes<7, 3, 2, 0, 4, 6, 5, 1>(targetGuid);
+    *packet << uint32(spellId);
+    *packet << uint8(++bot.CastCount);
+
+    QueuePacket(bot, packet);
+}
+
+void BotMgr::Say(Bot& bot, Player* player)
+{
+    std::string message = BotMessages[urand(0, sizeof(BotMessages) / sizeof(BotMessages[0]) - 1)];
+
+    WorldPacket* packet = new WorldPacket(CMSG_MESSAGECHAT_SAY, 4 + 1 + message.length());
+    *packet << uint32(player->GetTeam() == ALLIANCE ? LANG_COMMON : LANG_ORCISH);
+    packet->WriteBits(message.length(), 8);
+    packet->FlushBits();
+    packet->WriteString(message);
+
+    QueuePacket(bot, packet);
+}
+
+void BotMgr::BrowseAuctions(Bot& bot, Player* player)
+{
+    Creature* auctioneer = bot.Auctioneer ? ObjectAccessor::GetCreature(*player, bot.Auctioneer) : NULL;
+    if (!auctioneer)
+    {
+        NearestAuctioneerCheck check(player, BOT_AUCTIONEER_RANGE);
+        Trinity::CreatureLastSearcher<NearestAuctioneerCheck> searcher(player, auctioneer, check);
+        Trinity::VisitNearbyGridObject(player, BOT_AUCTIONEER_RANGE, searcher);
+
+        // nothing to browse here
+        if (!auctioneer)
+            return;
+
+        bot.Auctioneer = auctioneer->GetGUID();
+    }
+
+    if (!player->IsWithinDistInMap(auctioneer, INTERACTION_DISTANCE - 1.0f))
+    {
+        Position destination;
+        auctioneer->GetNearPoint2D(destination.m_positionX, destination.m_positionY, 2.0f, auctioneer->GetAngle(player));
+        destination.m_positionZ = auctioneer->GetPositionZ();
+        StartMoving(bot, player, destination);
+        return;
+    }
+
+    std::string search = BotSearches[urand(0, sizeof(BotSearches) / sizeof(BotSearches[0]) - 1)];
+    ObjectGuid guid = auctioneer->GetGUID();
+
+    // the order HandleAuctionListItems reads it in, any class, quality and level
+    WorldPacket* packet = new WorldPacket(CMSG_AUCTION_LIST_ITEMS, 64);
+    *packet << uint32(0);                                   // page
+    *packet << uint8(0);
+    *packet << uint32(0xFFFFFFFF);                          // sub class
+    *packet << uint8(0);                                    // level min
+    *packet << uint32(0xFFFFFFFF);                          // quality
+    *packet << uint32(0xFFFFFFFF);                          // class
+    *packet << uint8(0);                                    // level max
+    *packet << uint32(0xFFFFFFFF);                          // inventory type
+    *packet << uint32(0);
+    packet->WriteGuidMask<4, 0, 1, 5, 3, 6>(guid);
+    packet->WriteBits(search.length(), 8);
+    packet->WriteGuidMask<2>(guid);
+    packet->WriteBit(0);
+    packet->WriteGuidMask<7>(guid);
+    packet->WriteBit(0);                                    // usable only
+    packet->FlushBits();
+    packet->WriteGuidBytes<0, 7, 3, 1, 4>(guid);
+    packet->WriteString(search);
+    packet->WriteGuidBytes<5, 6, 2>(guid);
+
+    QueuePacket(bot, packet);
+}
+
+void BotMgr::SendMovement(Bot& bot, Player* player, Opcodes opcode, Position const& position)
+{
+    MovementInfo movementInfo;
+    movementInfo.moverGUID = player->GetGUID();
+    movementInfo.position.Relocate(position);
+    movementInfo.moveTime = getMSTime();
+    movementInfo.hasMoveTime = true;
+    movementInfo.hasFacing = true;
+    if (opcode == CMSG_MOVE_START_FORWARD || opcode == CMSG_MOVE_HEARTBEAT)
+        movementInfo.flags = MOVEMENTFLAG_FORWARD;
+
+    WorldPacket* packet = new WorldPacket(opcode, 64);
+    WorldSession::WriteMovementInfo(*packet, &movementInfo);
+    QueuePacket(bot, packet);
+}
+
+void BotMgr::QueuePacket(Bot& bot, WorldPacket* packet)
+{
+    // handled by the next update of the session, on the map or the world thread
+    bool deletePacket = false;
+    bot.Session->QueuePacket(packet, deletePacket);
+    if (deletePacket)
+        delete packet;
+    else
+        ++_stats.Packets[bot.Behaviour];
+}
+
+void BotMgr::RecordTick(uint32 tickTime)
+{
+    if (_bots.empty())
+        return;
+
+    if (_ticks.size() < BOT_TICK_SAMPLES)
+        _ticks.push_back(tickTime);
+    else
+    {
+        _ticks[_nextTick] = tickTime;
+        _nextTick = (_nextTick + 1) % BOT_TICK_SAMPLES;
+    }
+}
+
+BotTickReport BotMgr::GetTickReport() const
+{
+    return BuildTickReport(_ticks);
+}
+
+BotTickReport BotMgr::BuildTickReport(std::vector<uint32> ticks)
+{
+    BotTickReport report;
+    memset(&report, 0, sizeof(report));
+
+    if (ticks.empty())
+        return report;
+
+    std::sort(ticks.begin(), ticks.end());
+
+    uint64 total = 0;
+    for (uint32 tick : ticks)
+        total += tick;
+
+    size_t last = ticks.size() - 1;
+    report.Ticks = uint32(ticks.size());
+    report.Average = uint32(total / ticks.size());
+    report.P50 = ticks[last * 500 / 1000];
+    report.P90 = ticks[last * 900 / 1000];
+    report.P99 = ticks[last * 990 / 1000];
+    report.P999 = ticks[last * 999 / 1000];
+    report.Max = ticks[last];
+    return report;
+}
+
+std::vector<std::string> BotMgr::GetReport() const
+{
+    std::vector<std::string> lines;
+    char line[256];
+
+    snprintf(line, sizeof(line), "Bots: %u logged in, %u waiting, %u at most, " UI64FMTD " logins", GetBotCount(), GetPendingCount(), _stats.MaxBots, _stats.Logins);
+    lines.push_back(line);
+
+    std::ostringstream packets;
+    packets << "Packets queued:";
+    for (uint8 i = BOT_BEHAVIOUR_MOVE; i < BOT_BEHAVIOUR_MIXED; ++i)
+        packets << " " << GetBehaviourName(BotBehaviour(i)) << " " << _stats.Packets[i];
+    lines.push_back(packets.str());
+
+    BotTickReport ticks = GetTickReport();
+    snprintf(line, sizeof(line), "World update: %u updates, avg %u ms, p50 %u ms, p90 %u ms, p99 %u ms, p99.9 %u ms, max %u ms",
+        ticks.Ticks, ticks.Average, ticks.P50, ticks.P90, ticks.P99, ticks.P999, ticks.Max);
+    lines.push_back(line);
+
+    if (uint64 memory = GetResidentMemory())
+        snprintf(line, sizeof(line), "Memory: " UI64FMTD " MB resident", memory / (1024 * 1024));
+    else
+        snprintf(line, sizeof(line), "Memory: unknown on this platform");
+    lines.push_back(line);
+
+    PacketPoolStats pool = sPacketPool->GetStats();
+    snprintf(line, sizeof(line), "Packet pool: " UI64FMTD " allocations, %.1f%% from the free lists of the threads, " UI64FMTD " from the heap",
+        pool.Allocations, pool.Allocations ? pool.ThreadHits * 100.0 / pool.Allocations : 0.0, pool.HeapAllocations);
+    lines.push_back(line);
+
+    MovementInterestStats movement = sMovementInterestMgr->GetStats();
+    snprintf(line, sizeof(line), "Movement relays: " UI64FMTD " sent, " UI64FMTD " held back for distance, " UI64FMTD " KB saved, %.0f bytes/s saved and %.0f bytes/s sent lately",
+        movement.Relayed + movement.Flushed, movement.Held, movement.SavedBytes / 1024, movement.SavedBytesPerSecond, movement.RelayedBytesPerSecond);
+    lines.push_back(line);
+
+    if (!Profiler::IsEnabled())
+    {
+        lines.push_back("Maps: start the profiler (.debug profile start) for the cost of every map");
+        return lines;
+    }
+
+    std::vector<ProfileKeyStats> maps = sProfiler->GetKeyStats(PROFILE_MAP);
+    for (size_t i = 0; i < maps.size() && i < 10; ++i)
+    {
+        ProfileKeyStats const& stats = maps[i];
+        MapEntry const* entry = sMapStore.LookupEntry(stats.Key);
+        snprintf(line, sizeof(line), "Map %u %s: " UI64FMTD " ms, " UI64FMTD " updates, avg " UI64FMTD " us, max %u us", stats.Key, entry ? entry->name : "",
+            stats.Time / IN_MILLISECONDS, stats.Calls, stats.Calls ? stats.Time / stats.Calls : 0, stats.MaxTime);
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+void BotMgr::ResetStats()
+{
+    _stats.Reset();
+    _stats.MaxBots = uint32(_bots.size());
+    _ticks.clear();
+    _nextTick = 0;
+}
+
+void BotMgr::StartBenchmark()
+{
+    uint32 count = sWorld->getIntConfig(CONFIG_BOTS_BENCHMARK_COUNT);
+
+    std::string locationStr = ConfigMgr::GetStringDefault("Bots.Benchmark.Location", "0 -8833.38 628.62 94.00");
+    uint32 mapId = 0;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    if (sscanf(locationStr.c_str(), "%u %f %f %f", &mapId, &x, &y, &z) != 4 || !MapManager::IsValidMapCoord(mapId, x, y, z))
+    {
+        TC_LOG_ERROR("server", "BotMgr: Bots.Benchmark.Location \"%s\" isn't a valid \"map x y z\", the benchmark doesn't start", locationStr.c_str());
+        return;
+    }
+
+    std::string behaviourStr = ConfigMgr::GetStringDefault("Bots.Benchmark.Behaviour", "mixed");
+    BotBehaviour behaviour = GetBehaviourByName(behaviourStr.c_str());
+    if (behaviour == MAX_BOT_BEHAVIOUR)
+    {
+        TC_LOG_ERROR("server", "BotMgr: Bots.Benchmark.Behaviour \"%s\" is unknown, the benchmark doesn't start", behaviourStr.c_str());
+        return;
+    }
+
+    // the per-map costs of the report
+    sProfiler->Start();
+
+    _benchmark = true;
+    AddBots(count, behaviour, WorldLocation(mapId, x, y, z), PHASEMASK_NORMAL, ALLIANCE);
+    TC_LOG_INFO("server", "BotMgr: benchmark with %u %s bots on map %u started, %u bots log in per world update", count, GetBehaviourName(behaviour), mapId, uint32(BOT_LOGINS_PER_UPDATE));
+}
+
+void BotMgr::FinishBenchmark()
+{
+    std::vector<std::string> report = GetReport();
+
+    std::ostringstream fileName;
+    fileName << _logsDir << "bot_benchmark_" << uint64(time(NULL)) << ".txt";
+
+    FILE* file = fopen(fileName.str().c_str(), "w");
+    if (!file)
+        TC_LOG_ERROR("server", "BotMgr: can't open %s for writing", fileName.str().c_str());
+
+    TC_LOG_INFO("server", "BotMgr: benchmark finished");
+    for (std::string const& line : report)
+    {
+        TC_LOG_INFO("server", "BotMgr: %s", line.c_str());
+        if (file)
+            fprintf(file, "%s\n", line.c_str());
+    }
+
+    if (file)
+    {
+        fclose(file);
+        TC_LOG_INFO("server", "BotMgr: report written to %s", fileName.str().c_str());
+    }
+
+    if (Profiler::IsEnabled())
+        sProfiler->Export();
+
+    _benchmark = false;
+    World::StopNow(SHUTDOWN_EXIT_CODE);
+}
+
+char const* BotMgr::GetBehaviourName(BotBehaviour behaviour)
+{
+    switch (behaviour)
+    {
+        case BOT_BEHAVIOUR_IDLE:    return "idle";
+        case BOT_BEHAVIOUR_MOVE:    return "move";
+        case BOT_BEHAVIOUR_CAST:    return "cast";
+        case BOT_BEHAVIOUR_AOE:     return "aoe";
+        case BOT_BEHAVIOUR_CHAT:    return "chat";
+        case BOT_BEHAVIOUR_AUCTION: return "auction";
+        case BOT_BEHAVIOUR_MIXED:   return "mixed";
+        default:                    return "unknown";
+    }
+}
+
+BotBehaviour BotMgr::GetBehaviourByName(char const* name)
+{
+    for (uint8 i = 0; i < MAX_BOT_BEHAVIOUR; ++i)
+        if (strcmp(name, GetBehaviourName(BotBehaviour(i))) == 0)
+            return BotBehaviour(i);
+
+    return MAX_BOT_BEHAVIOUR;
+}
+
+uint64 BotMgr::GetResidentMemory()
+{
+#if PLATFORM == PLATFORM_UNIX
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+
+    unsigned long size = 0, resident = 0;
+    int read = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+
+    if (read != 2)
+        return 0;
+
+    return uint64(resident) * uint64(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_BOTMGR_H
+#define TRINITY_BOTMGR_H
+
+#include "Common.h"
+#include "Object.h"
+#include "Opcodes.h"
+#include <ace/Singleton.h>
+#include <list>
+#include <vector>
+
+#define BOT_ACCOUNT_ID_BASE             0xF0000000          // bot sessions take account ids from here, above the real ones
+#define BOT_LOGINS_PER_UPDATE           50                  // bots waiting to log in are added a few per world update
+#define BOT_TICK_SAMPLES                65536               // world update times kept for the percentiles
+#define BOT_HEARTBEAT_INTERVAL          500                 // milliseconds between two movement heartbeats
+#define BOT_WANDER_RADIUS               30.0f               // moving bots walk to random points this far around where they logged in
+#define BOT_TARGET_RANGE                30.0f
+#define BOT_AUCTIONEER_RANGE            250.0f              // auction bots walk to an auctioneer closer than this
+
+class Player;
+class WorldSession;
+class WorldPacket;
+
+enum BotBehaviour
+{
+    BOT_BEHAVIOUR_IDLE,
+    BOT_BEHAVIOUR_MOVE,                                     // wander around with movement opcodes
+    BOT_BEHAVIOUR_CAST,                                     // fireball the nearest attackable unit, or buff themselves
+    BOT_BEHAVIOUR_AOE,                                      // blizzard on the nearest attackable unit, or in front of them
+    BOT_BEHAVIOUR_CHAT,                                     // /say
+    BOT_BEHAVIOUR_AUCTION,                                  // browse the nearest auction house
+    BOT_BEHAVIOUR_MIXED,                                    // one of the above for every bot, in turn
+    MAX_BOT_BEHAVIOUR
+};
+
+struct BotStats
+{
+    BotStats() { Reset(); }
+
+    uint64 Logins;
+    uint64 Packets[MAX_BOT_BEHAVIOUR];                      // client packets queued by the bots of a behaviour
+    uint32 MaxBots;
+
+    void Reset();
+};
+
+struct BotTickReport
+{
+    uint32 Ticks;
+    uint32 Average;                                         // milliseconds
+    uint32 P50;
+    uint32 P90;
+    uint32 P99;
+    uint32 P999;
+    uint32 Max;
+};
+
+/*
+ * Load generator of simulated players for reproducible performance work.
+ *
+ * A bot is a WorldSession without a socket and a character created in memory,
+ * logged in like a real one and never saved. Bots drive the server through
+ * the real opcode handlers: their behaviour builds the client packets (movement,
+ * spell casts, chat, auction browsing) and queues them to the session, which
+ * processes them in the map update like any other. Packets sent to a bot are
+ * built and dropped by WorldSession::SendPacket, so the server side cost stays.
+ *
+ * The world update times are sampled while bots are logged in, the report adds
+ * their percentiles, the cost of every map from the profiler and the memory
+ * of the process. With Bots.Benchmark.Count set the bots log in at startup and
+ * the server writes the report and stops after Bots.Benchmark.Duration.
+ *
+ * Only touched by the world thread, between the map updates.
+ */
+class BotMgr
+{
+    friend class ACE_Singleton<BotMgr, ACE_Thread_Mutex>;
+
+    private:
+        BotMgr();
+        ~BotMgr() { }
+
+    public:
+        // the bots log in over the next updates, at the location and in the phases given
+        void AddBots(uint32 count, BotBehaviour behaviour, WorldLocation const& location, uint32 phaseMask, uint32 team);
+        // logs out the last bots logged in, all of them with count 0
+        void RemoveBots(uint32 count);
+
+        void Update(uint32 diff);
+        void RecordTick(uint32 tickTime);
+
+        void StartBenchmark();
+        bool IsBenchmarkRunning() const { return _benchmark; }
+
+        uint32 GetBotCount() const { return uint32(_bots.size()); }
+        uint32 GetPendingCount() const { return uint32(_pending.size()); }
+        BotStats const& GetStats() const { return _stats; }
+        BotTickReport GetTickReport() const;
+        std::vector<std::string> GetReport() const;
+        void ResetStats();
+
+        static char const* GetBehaviourName(BotBehaviour behaviour);
+        static BotBehaviour GetBehaviourByName(char const* name);
+        static BotTickReport BuildTickReport(std::vector<uint32> ticks);
+        static uint64 GetResidentMemory();                  // bytes, 0 where unknown
+
+    private:
+        struct Bot
+        {
+            WorldSession* Session;
+            BotBehaviour Behaviour;
+            Position Home;
+            Position Destination;
+            bool Moving;
+            uint32 MoveTime;                                // milliseconds since the last movement packet
+            uint32 Heartbeats;
+            uint32 ActionTimer;                             // milliseconds to the next cast, message or auction search
+            uint8 CastCount;
+            uint64 Auctioneer;
+        };
+
+        struct PendingBot
+        {
+            BotBehaviour Behaviour;
+            WorldLocation Location;
+            uint32 PhaseMask;
+            uint32 Team;
+        };
+
+        bool Login(PendingBot const& pending);
+        void Logout(Bot& bot);
+
+        void UpdateBot(Bot& bot, uint32 diff);
+        void UpdateMovement(Bot& bot, Player* player, uint32 diff);
+        void StartMoving(Bot& bot, Player* player, Position const& destination);
+        void Cast(Bot& bot, Player* player, bool aoe);
+        void Say(Bot& bot, Player* player);
+        void BrowseAuctions(Bot& bot, Player* player);
+
+        void QueuePacket(Bot& bot, WorldPacket* packet);
+        void SendMovement(Bot& bot, Player* player, Opcodes opcode, Position const& position);
+
+        void FinishBenchmark();
+
+        std::list<Bot> _bots;
+        std::list<PendingBot> _pending;
+        uint32 _nextAccount;
+        uint32 _nextBehaviour;                              // the next behaviour given out to mixed bots
+
+        std::vector<uint32> _ticks;
+        uint32 _nextTick;
+
+        BotStats _stats;
+        bool _benchmark;
+        std::string _logsDir;
+};
+
+#define sBotMgr ACE_Singleton<BotMgr, ACE_Thread_Mutex>::instance()
+
+#endif
@@ -21,6 +21,45 @@
 
 OpcodeHandler* opcodeTable[MAX_PACKET_TYPE][NUM_OPCODE_HANDLERS] = { };
 
+void OpcodeTimeStats::Add(uint32 time)
+{
+    uint32 bucket = 0;
+    while (bucket < OPCODE_TIME_BUCKETS - 1 && (time >> bucket))
+        ++bucket;
+
+    Count.fetch_add(1, std::memory_order_relaxed);
+    TotalTime.fetch_add(time, std::memory_order_relaxed);
+    Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint32 maxTime = MaxTime.load(std::memory_order_relaxed);
+    while (time > maxTime && !MaxTime.compare_exchange_weak(maxTime, time, std::memory_order_relaxed))
+        ;
+}
+
+void OpcodeTimeStats::Reset()
+{
+    Count = 0;
+    TotalTime = 0;
+    MaxTime = 0;
+    for (uint32 i = 0; i < OPCODE_TIME_BUCKETS; ++i)
+        Buckets[i] = 0;
+}
+
+uint32 OpcodeTimeStats::GetPercentile(float fraction) const
+{
+    uint64 count = Count.load(std::memory_order_relaxed);
+    uint64 wanted = uint64(count * fraction);
+    uint64 seen = 0;
+    for (uint32 i = 0; i < OPCODE_TIME_BUCKETS - 1; ++i)
+    {
+        seen += Buckets[i].load(std::memory_order_relaxed);
+        if (seen >= wanted)
+            return 1 << i;
+    }
+
+    return MaxTime.load(std::memory_order_relaxed);
+}
+
 template<bool isInValidRange, bool isNonZero>
 inline void ValidateAndSetOpcode(uint16 /*opcode*/, char const* /*name*/, SessionStatus /*status*/, PacketProcessing /*processing*/, pOpcodeHandler /*handler*/, PacketType /*type*/)
 {
@@ -25,6 +25,8 @@
 
 #include "Common.h"
 
+#include <atomic>
+
 /// List of Opcodes
 enum Opcodes
 {
@@ -1436,6 +1438,25 @@ class WorldSession;
 
 typedef void(WorldSession::*pOpcodeHandler)(WorldPacket& recvPacket);
 
+// bucket i counts handler calls that took less than 2^i microseconds (and at least 2^(i-1)), the last one the slower ones
+#define OPCODE_TIME_BUCKETS 16
+
+// handling times of an opcode, updated by the world and map threads at once, shown by .debug opcodestats
+struct OpcodeTimeStats
+{
+    OpcodeTimeStats() { Reset(); }
+
+    std::atomic<uint64> Count;
+    std::atomic<uint64> TotalTime;                          // microseconds
+    std::atomic<uint32> MaxTime;
+    std::atomic<uint64> Buckets[OPCODE_TIME_BUCKETS];
+
+    void Add(uint32 time);
+    void Reset();
+    // upper bound of the bucket holding the given fraction of the calls
+    uint32 GetPercentile(float fraction) const;
+};
+
 struct OpcodeHandler
 {
     OpcodeHandler() {}
@@ -1446,6 +1467,7 @@ struct OpcodeHandler
     SessionStatus status;
     PacketProcessing packetProcessing;
     pOpcodeHandler handler;
+    mutable OpcodeTimeStats timeStats;
 };
 
 extern OpcodeHandler* opcodeTable[MAX_PACKET_TYPE][NUM_OPCODE_HANDLERS];
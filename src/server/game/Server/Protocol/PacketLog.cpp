@@ -18,45 +18,265 @@
 #include "PacketLog.h"
 #include "Config.h"
 #include "ByteBuffer.h"
+#include "Log.h"
+#include "Timer.h"
 #include "WorldPacket.h"
 
-PacketLog::PacketLog() : _file(NULL)
+#include <algorithm>
+#include <chrono>
+
+#define PACKET_LOG_CLIENT_BUILD 18414
+
+PacketLog::PacketLog() : _file(NULL), _capturing(false), _opcodeFilterCount(0), _filterGeneration(0),
+    _writtenPackets(0), _writtenBytes(0), _droppedPackets(0)
 {
+    for (uint32 i = 0; i < PACKET_LOG_OPCODE_WORDS; ++i)
+        _opcodeFilter[i] = 0;
+
     Initialize();
 }
 
 PacketLog::~PacketLog()
 {
-    if (_file)
-        fclose(_file);
-
-    _file = NULL;
+    Stop();
+    ClearRings();
 }
 
 void PacketLog::Initialize()
 {
+    std::string logname = ConfigMgr::GetStringDefault("PacketLogFile", "");
+    if (!logname.empty())
+        Start(logname);
+}
+
+bool PacketLog::Start(std::string const& fileName)
+{
+    std::lock_guard<std::mutex> lock(_controlLock);
+
+    if (_capturing)
+        return false;
+
     std::string logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
 
     if (!logsDir.empty())
         if ((logsDir.at(logsDir.length()-1) != '/') && (logsDir.at(logsDir.length()-1) != '\\'))
             logsDir.push_back('/');
 
-    std::string logname = ConfigMgr::GetStringDefault("PacketLogFile", "");
-    if (!logname.empty())
-        _file = fopen((logsDir + logname).c_str(), "wb");
+    _file = fopen((logsDir + fileName).c_str(), "wb");
+    if (!_file)
+    {
+        TC_LOG_ERROR("server", "PacketLog: can't open %s%s for writing", logsDir.c_str(), fileName.c_str());
+        return false;
+    }
+
+    PacketLogHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Signature, "PKT", 3);
+    header.FormatVersion = 0x0301;
+    header.SnifferId = 'T';
+    header.Build = PACKET_LOG_CLIENT_BUILD;
+    memcpy(header.Locale, "enUS", 4);
+    header.SniffStartUnixtime = uint32(time(NULL));
+    header.SniffStartTicks = getMSTime();
+    fwrite(&header, sizeof(header), 1, _file);
+
+    // packets queued after the previous Stop() checked the rings for the last time
+    ClearRings();
+
+    _fileName = fileName;
+    _writtenPackets = 0;
+    _writtenBytes = sizeof(header);
+    _droppedPackets = 0;
+
+    _capturing = true;
+    _writer = std::thread(&PacketLog::WriterThread, this);
+
+    TC_LOG_INFO("server", "PacketLog: capturing packets to %s%s", logsDir.c_str(), fileName.c_str());
+    return true;
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction)
+void PacketLog::Stop()
 {
-    ByteBuffer data(4+4+4+1+packet.size());
-    data << int32(packet.GetOpcode());
-    data << int32(packet.size());
-    data << uint32(time(NULL));
-    data << uint8(direction);
+    std::lock_guard<std::mutex> lock(_controlLock);
+
+    if (!_capturing)
+        return;
 
-    for (uint32 i = 0; i < packet.size(); i++)
-        data << const_cast<WorldPacket&>(packet)[i];
+    _capturing = false;
+    _writer.join();
+
+    fclose(_file);
+    _file = NULL;
+
+    TC_LOG_INFO("server", "PacketLog: capture to %s stopped, " UI64FMTD " packets written, " UI64FMTD " dropped", _fileName.c_str(),
+        uint64(_writtenPackets), uint64(_droppedPackets));
+}
+
+bool PacketLog::IsOpcodeLogged(uint32 opcode) const
+{
+    if (!_opcodeFilterCount.load(std::memory_order_relaxed))
+        return true;
+
+    opcode &= 0x7FFF;
+    return (_opcodeFilter[opcode / 64].load(std::memory_order_relaxed) & (uint64(1) << (opcode % 64))) != 0;
+}
+
+bool PacketLog::IsAccountLogged(uint32 accountId) const
+{
+    std::lock_guard<std::mutex> lock(_accountFilterLock);
+    return _accountFilter.empty() || _accountFilter.find(accountId) != _accountFilter.end();
+}
+
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, uint32 accountId)
+{
+    EntryRing* ring = GetThreadRing();
+
+    PacketLogEntry* entry = new PacketLogEntry();
+    entry->Dir = direction;
+    entry->AccountId = accountId;
+    entry->ArrivalTicks = getMSTime();
+    entry->Opcode = packet.GetOpcode();
+    entry->Data.assign(packet.contents(), packet.contents() + packet.size());
+
+    if (!ring->Push(entry))
+    {
+        ++_droppedPackets;
+        delete entry;
+    }
+}
+
+void PacketLog::AddAccountFilter(uint32 accountId)
+{
+    std::lock_guard<std::mutex> lock(_accountFilterLock);
+    _accountFilter.insert(accountId);
+    ++_filterGeneration;
+}
 
-    fwrite(data.contents(), 1, data.size(), _file);
+void PacketLog::RemoveAccountFilter(uint32 accountId)
+{
+    std::lock_guard<std::mutex> lock(_accountFilterLock);
+    _accountFilter.erase(accountId);
+    ++_filterGeneration;
+}
+
+void PacketLog::AddOpcodeFilter(uint32 opcode)
+{
+    opcode &= 0x7FFF;
+    uint64 bit = uint64(1) << (opcode % 64);
+    if (!(_opcodeFilter[opcode / 64].fetch_or(bit) & bit))
+        ++_opcodeFilterCount;
+}
+
+void PacketLog::RemoveOpcodeFilter(uint32 opcode)
+{
+    opcode &= 0x7FFF;
+    uint64 bit = uint64(1) << (opcode % 64);
+    if (_opcodeFilter[opcode / 64].fetch_and(~bit) & bit)
+        --_opcodeFilterCount;
+}
+
+void PacketLog::ClearFilters()
+{
+    {
+        std::lock_guard<std::mutex> lock(_accountFilterLock);
+        _accountFilter.clear();
+        ++_filterGeneration;
+    }
+
+    _opcodeFilterCount = 0;
+    for (uint32 i = 0; i < PACKET_LOG_OPCODE_WORDS; ++i)
+        _opcodeFilter[i] = 0;
+}
+
+std::vector<uint32> PacketLog::GetAccountFilter() const
+{
+    std::lock_guard<std::mutex> lock(_accountFilterLock);
+    std::vector<uint32> accounts(_accountFilter.begin(), _accountFilter.end());
+    std::sort(accounts.begin(), accounts.end());
+    return accounts;
+}
+
+std::vector<uint32> PacketLog::GetOpcodeFilter() const
+{
+    std::vector<uint32> opcodes;
+    for (uint32 i = 0; i < PACKET_LOG_OPCODE_WORDS; ++i)
+        if (uint64 word = _opcodeFilter[i])
+            for (uint32 bit = 0; bit < 64; ++bit)
+                if (word & (uint64(1) << bit))
+                    opcodes.push_back(i * 64 + bit);
+
+    return opcodes;
+}
+
+PacketLog::EntryRing* PacketLog::GetThreadRing()
+{
+    static thread_local EntryRing* threadRing = NULL;
+    if (!threadRing)
+    {
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        _rings.push_back(std::unique_ptr<EntryRing>(new EntryRing()));
+        threadRing = _rings.back().get();
+    }
+
+    return threadRing;
+}
+
+void PacketLog::WriterThread()
+{
+    while (_capturing)
+    {
+        if (WriteEntries())
+            fflush(_file);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(PACKET_LOG_WRITE_INTERVAL));
+    }
+
+    // the packets queued before the capture stopped
+    WriteEntries();
     fflush(_file);
 }
+
+uint32 PacketLog::WriteEntries()
+{
+    std::lock_guard<std::mutex> lock(_ringsLock);
+
+    uint32 count = 0;
+    for (std::unique_ptr<EntryRing> const& ring : _rings)
+    {
+        PacketLogEntry* entry;
+        while (ring->Pop(entry))
+        {
+            PacketLogPacketHeader header;
+            memset(&header, 0, sizeof(header));
+            header.Direction = entry->Dir == CLIENT_TO_SERVER ? PACKET_LOG_DIRECTION_CMSG : PACKET_LOG_DIRECTION_SMSG;
+            header.ConnectionId = entry->AccountId;
+            header.ArrivalTicks = entry->ArrivalTicks;
+            header.OptionalDataSize = sizeof(header.OptionalData);
+            header.Length = uint32(entry->Data.size() + sizeof(header.Opcode));
+            header.Opcode = entry->Opcode;
+
+            fwrite(&header, sizeof(header), 1, _file);
+            if (!entry->Data.empty())
+                fwrite(&entry->Data[0], 1, entry->Data.size(), _file);
+
+            _writtenBytes += sizeof(header) + entry->Data.size();
+            ++count;
+            delete entry;
+        }
+    }
+
+    _writtenPackets += count;
+    return count;
+}
+
+void PacketLog::ClearRings()
+{
+    std::lock_guard<std::mutex> lock(_ringsLock);
+
+    for (std::unique_ptr<EntryRing> const& ring : _rings)
+    {
+        PacketLogEntry* entry;
+        while (ring->Pop(entry))
+            delete entry;
+    }
+}
@@ -19,7 +19,13 @@
 #define TRINITY_PACKETLOG_H
 
 #include "Common.h"
+#include "SPSCQueue.h"
 #include <ace/Singleton.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 enum Direction
 {
@@ -27,8 +33,70 @@ enum Direction
     SERVER_TO_CLIENT
 };
 
+#define PACKET_LOG_RING_SIZE            4096                // packets per capturing thread waiting for the writer
+#define PACKET_LOG_OPCODE_WORDS         (0x8000 / 64)       // one bit for every opcode value
+#define PACKET_LOG_WRITE_INTERVAL       100                 // milliseconds between the writer passes
+#define PACKET_LOG_DIRECTION_CMSG       0x47534D43          // "CMSG"
+#define PACKET_LOG_DIRECTION_SMSG       0x47534D53          // "SMSG"
+
 class WorldPacket;
 
+#pragma pack(push, 1)
+
+struct PacketLogHeader
+{
+    char Signature[3];
+    uint16 FormatVersion;
+    uint8 SnifferId;
+    uint32 Build;
+    char Locale[4];
+    uint8 SessionKey[40];
+    uint32 SniffStartUnixtime;
+    uint32 SniffStartTicks;
+    uint32 OptionalDataSize;
+};
+
+struct PacketLogPacketHeader
+{
+    // identifies the connection for the parser, the account id stands for it
+    struct OptionalData
+    {
+        uint8 SocketIPBytes[16];
+        uint32 SocketPort;
+    };
+
+    uint32 Direction;
+    uint32 ConnectionId;
+    uint32 ArrivalTicks;
+    uint32 OptionalDataSize;
+    uint32 Length;
+    OptionalData OptionalData;
+    uint32 Opcode;
+};
+
+#pragma pack(pop)
+
+struct PacketLogEntry
+{
+    Direction Dir;
+    uint32 AccountId;
+    uint32 ArrivalTicks;
+    uint32 Opcode;
+    std::vector<uint8> Data;
+};
+
+/*
+ * Packet capture in the PKT 3.1 format read by WowPacketParser.
+ *
+ * Every thread that logs a packet gets its own lock-free ring, a writer thread
+ * empties the rings into the file, so the network and map threads never wait
+ * on the disk. Packets that don't fit in a full ring are dropped and counted.
+ *
+ * Capture is limited to a set of accounts and a set of opcodes, an empty set
+ * matches everything. The opcode filter is a bitmap and the account filter is
+ * cached by every session until the filters change, so both are O(1) and need
+ * no lock. With capture off only one atomic flag is read per packet.
+ */
 class PacketLog
 {
     friend class ACE_Singleton<PacketLog, ACE_Thread_Mutex>;
@@ -39,11 +107,57 @@ class PacketLog
 
     public:
         void Initialize();
-        bool CanLogPacket() const { return (_file != NULL); }
-        void LogPacket(WorldPacket const& packet, Direction direction);
+
+        bool Start(std::string const& fileName);
+        void Stop();
+
+        bool CanLogPacket() const { return _capturing.load(std::memory_order_relaxed); }
+        bool IsOpcodeLogged(uint32 opcode) const;
+        bool IsAccountLogged(uint32 accountId) const;
+        void LogPacket(WorldPacket const& packet, Direction direction, uint32 accountId);
+
+        // changed every time the account filter changes, the sessions cache IsAccountLogged() until then
+        uint32 GetFilterGeneration() const { return _filterGeneration.load(std::memory_order_acquire); }
+
+        void AddAccountFilter(uint32 accountId);
+        void RemoveAccountFilter(uint32 accountId);
+        void AddOpcodeFilter(uint32 opcode);
+        void RemoveOpcodeFilter(uint32 opcode);
+        void ClearFilters();
+
+        std::string const& GetFileName() const { return _fileName; }
+        uint64 GetWrittenPackets() const { return _writtenPackets; }
+        uint64 GetWrittenBytes() const { return _writtenBytes; }
+        uint64 GetDroppedPackets() const { return _droppedPackets; }
+        std::vector<uint32> GetAccountFilter() const;
+        std::vector<uint32> GetOpcodeFilter() const;
 
     private:
+        typedef SPSCQueue<PacketLogEntry*, PACKET_LOG_RING_SIZE> EntryRing;
+
+        EntryRing* GetThreadRing();
+        void WriterThread();
+        uint32 WriteEntries();
+        void ClearRings();
+
         FILE* _file;
+        std::string _fileName;
+        std::atomic<bool> _capturing;
+        std::thread _writer;
+        std::mutex _controlLock;                            // Start() and Stop()
+
+        std::vector<std::unique_ptr<EntryRing>> _rings;     // never shrinks, a ring stays with its thread
+        std::mutex _ringsLock;
+
+        std::atomic<uint64> _opcodeFilter[PACKET_LOG_OPCODE_WORDS];
+        std::atomic<uint32> _opcodeFilterCount;
+        std::unordered_set<uint32> _accountFilter;
+        mutable std::mutex _accountFilterLock;
+        std::atomic<uint32> _filterGeneration;
+
+        std::atomic<uint64> _writtenPackets;
+        std::atomic<uint64> _writtenBytes;
+        std::atomic<uint64> _droppedPackets;
 };
 
 #define sPacketLog ACE_Singleton<PacketLog, ACE_Thread_Mutex>::instance()
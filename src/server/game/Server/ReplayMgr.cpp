@@ -0,0 +1,656 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReplayMgr.h"
+#include "BotMgr.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "PacketLog.h"
+#include "Player.h"
+#include "Profiler.h"
+#include "Timer.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define REPLAY_MAX_PACKET_SIZE          0x100000            // a longer packet means the capture is damaged
+
+ReplayMgr::ReplayMgr() : _speed(1.0f), _running(false), _stopAfter(false), _time(0), _lastPacketTime(0), _heapTimer(0), _startTime(0)
+{
+    memset(&_stats, 0, sizeof(_stats));
+    memset(&_poolStart, 0, sizeof(_poolStart));
+
+    _logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!_logsDir.empty())
+        if ((_logsDir.at(_logsDir.length() - 1) != '/') && (_logsDir.at(_logsDir.length() - 1) != '\\'))
+            _logsDir.push_back('/');
+}
+
+bool ReplayMgr::Start(std::string const& fileName, float speed, std::string const& baseline)
+{
+    if (_running)
+        return false;
+
+    // the players online would share the world, the guilds and the auction houses with the replayed characters
+    if (uint32 sessions = sWorld->GetSessionCount())
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: %u sessions are online, a replay only starts on an empty realm", sessions);
+        return false;
+    }
+
+    if (speed <= 0.0f)
+        speed = 1.0f;
+
+    memset(&_stats, 0, sizeof(_stats));
+    _sessions.clear();
+    _ticks.clear();
+
+    if (!Load(fileName))
+        return false;
+
+    _fileName = fileName;
+    _baseline = baseline;
+    _speed = speed;
+    _time = 0;
+    _heapTimer = 0;
+    _stats.HeapStart = _stats.HeapPeak = GetHeapInUse();
+    _stats.MemoryStart = BotMgr::GetResidentMemory();
+    _poolStart = sPacketPool->GetStats();
+    _movementStart = sMovementInterestMgr->GetStats();
+
+    CreateSessions();
+    if (_sessions.empty())
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: nothing to replay in %s%s", _logsDir.c_str(), fileName.c_str());
+        return false;
+    }
+
+    _startTime = getMSTime();
+    _running = true;
+
+    TC_LOG_INFO("server", "ReplayMgr: replaying " UI64FMTD " packets of %u sessions from %s%s at %.2fx, %u seconds of traffic",
+        _stats.Packets, _stats.Sessions, _logsDir.c_str(), fileName.c_str(), _speed, _lastPacketTime / IN_MILLISECONDS);
+
+    // the packet count is filled again by the replay
+    _stats.Packets = 0;
+    return true;
+}
+
+void ReplayMgr::StartAtStartup()
+{
+    std::string fileName = ConfigMgr::GetStringDefault("Replay.File", "");
+    float speed = ConfigMgr::GetFloatDefault("Replay.Speed", 1.0f);
+    std::string baseline = ConfigMgr::GetStringDefault("Replay.Baseline", "");
+
+    if (!Start(fileName, speed, baseline))
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: the replay of Replay.File \"%s\" doesn't start", fileName.c_str());
+        return;
+    }
+
+    _stopAfter = true;
+}
+
+bool ReplayMgr::IsReplayedAccount(uint32 accountId) const
+{
+    if (!_running)
+        return false;
+
+    for (ReplaySession const& session : _sessions)
+        if (session.AccountId == accountId)
+            return true;
+
+    return false;
+}
+
+void ReplayMgr::Stop()
+{
+    if (!_running)
+        return;
+
+    for (ReplaySession& session : _sessions)
+    {
+        if (session.Session->GetPlayer())
+            session.Session->LogoutPlayer(false);
+
+        delete session.Session;
+    }
+
+    _sessions.clear();
+    _running = false;
+    _stopAfter = false;
+
+    TC_LOG_INFO("server", "ReplayMgr: replay of %s stopped", _fileName.c_str());
+}
+
+bool ReplayMgr::Load(std::string const& fileName)
+{
+    std::string path = _logsDir + fileName;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: can't open %s", path.c_str());
+        return false;
+    }
+
+    PacketLogHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.Signature, "PKT", 3) != 0 || header.FormatVersion != 0x0301)
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: %s isn't a PKT 3.1 capture", path.c_str());
+        fclose(file);
+        return false;
+    }
+
+    fseek(file, header.OptionalDataSize, SEEK_CUR);
+
+    // the rings of the capturing threads are written in turn, the packets of one account
+    // come from the same network thread and stay in order but the accounts are mixed
+    std::map<uint32, std::vector<ReplayPacket>> accounts;
+    uint32 firstTime = 0xFFFFFFFF;
+    bool damaged = false;
+
+    // every packet header up to the optional data, whose size can differ between sniffers
+    uint8 fixed[offsetof(PacketLogPacketHeader, OptionalData)];
+    while (fread(fixed, sizeof(fixed), 1, file) == 1)
+    {
+        PacketLogPacketHeader packetHeader;
+        memcpy(&packetHeader, fixed, sizeof(fixed));
+
+        uint32 opcode = 0;
+        if (packetHeader.Length < sizeof(opcode) || packetHeader.Length > REPLAY_MAX_PACKET_SIZE ||
+            fseek(file, packetHeader.OptionalDataSize, SEEK_CUR) != 0 || fread(&opcode, sizeof(opcode), 1, file) != 1)
+        {
+            damaged = true;
+            break;
+        }
+
+        ReplayPacket packet;
+        packet.Time = packetHeader.ArrivalTicks - header.SniffStartTicks;     // getMSTime() may wrap during the capture
+        packet.Opcode = PacketFilter::DropHighBytes(Opcodes(opcode));
+        packet.Data.resize(packetHeader.Length - sizeof(opcode));
+        if (!packet.Data.empty() && fread(&packet.Data[0], packet.Data.size(), 1, file) != 1)
+        {
+            damaged = true;
+            break;
+        }
+
+        if (packetHeader.Direction != PACKET_LOG_DIRECTION_CMSG)
+            continue;
+
+        firstTime = std::min(firstTime, packet.Time);
+        accounts[packetHeader.ConnectionId].push_back(std::move(packet));
+    }
+
+    fclose(file);
+
+    if (damaged)
+        TC_LOG_ERROR("server", "ReplayMgr: %s is truncated or damaged, only the packets before the damage are replayed", path.c_str());
+
+    _lastPacketTime = 0;
+    for (std::pair<uint32 const, std::vector<ReplayPacket>>& account : accounts)
+    {
+        std::vector<ReplayPacket>& packets = account.second;
+        std::stable_sort(packets.begin(), packets.end(), [](ReplayPacket const& left, ReplayPacket const& right)
+        {
+            return left.Time < right.Time;
+        });
+
+        // the character screen isn't replayed, the characters must not be created or deleted again
+        std::vector<ReplayPacket>::iterator login = std::find_if(packets.begin(), packets.end(), [](ReplayPacket const& packet)
+        {
+            return packet.Opcode == CMSG_PLAYER_LOGIN;
+        });
+
+        if (login == packets.end())
+        {
+            TC_LOG_ERROR("server", "ReplayMgr: account %u logged in before the capture started and isn't replayed", account.first);
+            ++_stats.SkippedSessions;
+            continue;
+        }
+
+        ReplaySession session;
+        session.AccountId = account.first;
+        session.Session = NULL;
+        session.Next = 0;
+        session.LoggedIn = false;
+        session.LoginFailed = false;
+        _stats.SkippedPackets += uint64(login - packets.begin());
+
+        for (; login != packets.end(); ++login)
+        {
+            switch (login->Opcode)
+            {
+                // handled by the socket itself
+                case CMSG_PING:
+                case CMSG_AUTH_SESSION:
+                case CMSG_KEEP_ALIVE:
+                case CMSG_LOG_DISCONNECT:
+                case CMSG_REORDER_CHARACTERS:
+                case CMSG_ENABLE_NAGLE:
+                case MSG_VERIFY_CONNECTIVITY:
+                    ++_stats.SkippedPackets;
+                    continue;
+                default:
+                    break;
+            }
+
+            OpcodeHandler* handler = opcodeTable[CMSG][login->Opcode & 0x7FFF];
+            if (!handler || handler->status == STATUS_UNHANDLED)
+            {
+                ++_stats.SkippedPackets;
+                continue;
+            }
+
+            login->Time -= firstTime;
+            _lastPacketTime = std::max(_lastPacketTime, login->Time);
+            session.Packets.push_back(std::move(*login));
+        }
+
+        _stats.Packets += session.Packets.size();
+        _sessions.push_back(std::move(session));
+    }
+
+    return true;
+}
+
+void ReplayMgr::CreateSessions()
+{
+    for (std::vector<ReplaySession>::iterator itr = _sessions.begin(); itr != _sessions.end();)
+    {
+        // the character of an account playing right now can't log in twice
+        if (sWorld->FindSession(itr->AccountId))
+        {
+            TC_LOG_ERROR("server", "ReplayMgr: account %u is online and isn't replayed", itr->AccountId);
+            ++_stats.SkippedSessions;
+            _stats.Packets -= itr->Packets.size();
+            itr = _sessions.erase(itr);
+            continue;
+        }
+
+        // the character screen isn't replayed, so the characters it would list are allowed to log in from the database
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARS_BY_ACCOUNT_ID);
+        stmt->setUInt32(0, itr->AccountId);
+        PreparedQueryResult result = CharacterDatabase.Query(stmt);
+        if (!result)
+        {
+            TC_LOG_ERROR("server", "ReplayMgr: account %u has no characters in the database and isn't replayed", itr->AccountId);
+            ++_stats.SkippedSessions;
+            _stats.Packets -= itr->Packets.size();
+            itr = _sessions.erase(itr);
+            continue;
+        }
+
+        std::ostringstream name;
+        name << "Replay" << itr->AccountId;
+
+        // flagged as a bot, the character and its items are never saved and the snapshot can be replayed again
+        itr->Session = new WorldSession(itr->AccountId, name.str(), NULL, SEC_PLAYER, uint8(sWorld->getIntConfig(CONFIG_EXPANSION)), 0, LOCALE_enUS, 0, false);
+        itr->Session->SetBot(true);
+
+        do
+            itr->Session->AllowCharacterLogin((*result)[0].GetUInt32());
+        while (result->NextRow());
+
+        itr->Session->LoadGlobalAccountData();
+        itr->Session->LoadTutorialsData();
+
+        ++_stats.Sessions;
+        ++itr;
+    }
+}
+
+void ReplayMgr::Update(uint32 diff)
+{
+    if (!_running)
+        return;
+
+    PROFILE_SCOPE("ReplayMgr::Update");
+
+    // world time, not wall time, a slower build gets the same packets in every world update
+    _time += uint64(diff * _speed);
+
+    for (ReplaySession& session : _sessions)
+    {
+        ReplayPackets(session);
+
+        // the packets that can't be handled on the map thread, the others are handled by the map update
+        WorldSessionFilter updater(session.Session);
+        session.Session->Update(diff, updater);
+    }
+
+    CheckLogins();
+    if (!_running)
+        return;
+
+    _heapTimer += diff;
+    if (_heapTimer >= REPLAY_HEAP_SAMPLE_INTERVAL)
+    {
+        _heapTimer = 0;
+        _stats.HeapPeak = std::max(_stats.HeapPeak, GetHeapInUse());
+    }
+
+    if (_time >= uint64(_lastPacketTime) + REPLAY_SETTLE_TIME)
+        Finish();
+}
+
+void ReplayMgr::CheckLogins()
+{
+    uint32 failed = 0;
+    for (ReplaySession& session : _sessions)
+    {
+        if (session.Session->GetPlayer())
+            session.LoggedIn = true;
+        else if (!session.LoggedIn && !session.LoginFailed && _time >= uint64(session.Packets[0].Time) + REPLAY_LOGIN_TIMEOUT)
+        {
+            // the packets queued after the login wait for a player forever
+            TC_LOG_ERROR("server", "ReplayMgr: the character of account %u didn't enter the world, its packets are never handled", session.AccountId);
+            session.LoginFailed = true;
+            ++_stats.FailedLogins;
+        }
+
+        if (session.LoginFailed)
+            ++failed;
+    }
+
+    if (failed && failed == _sessions.size())
+        Fail("no character entered the world, the report would measure an idle server");
+}
+
+void ReplayMgr::Fail(char const* reason)
+{
+    TC_LOG_ERROR("server", "ReplayMgr: replay of %s failed: %s", _fileName.c_str(), reason);
+
+    bool stopAfter = _stopAfter;
+    Stop();
+
+    if (stopAfter)
+        World::StopNow(ERROR_EXIT_CODE);
+}
+
+void ReplayMgr::ReplayPackets(ReplaySession& session)
+{
+    while (session.Next < session.Packets.size() && session.Packets[session.Next].Time <= _time)
+    {
+        ReplayPacket const& packet = session.Packets[session.Next++];
+
+        WorldPacket* data = new WorldPacket(Opcodes(packet.Opcode), packet.Data.size());
+        if (!packet.Data.empty())
+            data->append(&packet.Data[0], packet.Data.size());
+
+        bool deletePacket = false;
+        session.Session->QueuePacket(data, deletePacket);
+        if (deletePacket)
+        {
+            delete data;
+            ++_stats.DroppedPackets;
+        }
+        else
+            ++_stats.Packets;
+    }
+}
+
+void ReplayMgr::RecordTick(uint32 tickTime)
+{
+    if (_running)
+        _ticks.push_back(tickTime);
+}
+
+void ReplayMgr::Finish()
+{
+    if (std::none_of(_sessions.begin(), _sessions.end(), [](ReplaySession const& session) { return session.LoggedIn; }))
+    {
+        Fail("no character entered the world, the report would measure an idle server");
+        return;
+    }
+
+    _stats.Duration = GetMSTimeDiffToNow(_startTime);
+    _stats.HeapPeak = std::max(_stats.HeapPeak, GetHeapInUse());
+
+    PacketPoolStats pool = sPacketPool->GetStats();
+    _stats.PacketAllocations = pool.Allocations - _poolStart.Allocations;
+    _stats.PacketHeapAllocations = pool.HeapAllocations - _poolStart.HeapAllocations;
+
+    MovementInterestStats movement = sMovementInterestMgr->GetStats();
+    _stats.MovementRelays = (movement.Relayed + movement.Flushed) - (_movementStart.Relayed + _movementStart.Flushed);
+    _stats.MovementSavedBytes = movement.SavedBytes - _movementStart.SavedBytes;
+
+    for (ReplaySession& session : _sessions)
+    {
+        if (session.Session->GetPlayer())
+            session.Session->LogoutPlayer(false);
+
+        delete session.Session;
+    }
+
+    _sessions.clear();
+    _running = false;
+
+    // what the replay left behind once its characters are gone
+    _stats.HeapEnd = GetHeapInUse();
+    _stats.MemoryEnd = BotMgr::GetResidentMemory();
+
+    std::vector<std::pair<std::string, std::string>> report = GetReport();
+
+    std::ostringstream fileName;
+    fileName << "replay_" << uint64(time(NULL)) << ".txt";
+    _lastReport = fileName.str();
+
+    FILE* file = fopen((_logsDir + _lastReport).c_str(), "w");
+    if (!file)
+        TC_LOG_ERROR("server", "ReplayMgr: can't open %s%s for writing", _logsDir.c_str(), _lastReport.c_str());
+
+    TC_LOG_INFO("server", "ReplayMgr: replay of %s finished", _fileName.c_str());
+    for (std::pair<std::string, std::string> const& line : report)
+    {
+        TC_LOG_INFO("server", "ReplayMgr: %s %s", line.first.c_str(), line.second.c_str());
+        if (file)
+            fprintf(file, "%s %s\n", line.first.c_str(), line.second.c_str());
+    }
+
+    if (file)
+    {
+        fclose(file);
+        TC_LOG_INFO("server", "ReplayMgr: report written to %s%s", _logsDir.c_str(), _lastReport.c_str());
+    }
+
+    if (!_baseline.empty())
+        CompareWithBaseline(report);
+
+    if (Profiler::IsEnabled())
+        sProfiler->Export();
+
+    if (_stopAfter)
+    {
+        _stopAfter = false;
+        World::StopNow(SHUTDOWN_EXIT_CODE);
+    }
+}
+
+std::vector<std::pair<std::string, std::string>> ReplayMgr::GetReport() const
+{
+    std::vector<std::pair<std::string, std::string>> report;
+    char value[64];
+
+    report.push_back(std::make_pair("build", GitRevision::GetHash()));
+    report.push_back(std::make_pair("capture", _fileName));
+    snprintf(value, sizeof(value), "%.2f", _speed);
+    report.push_back(std::make_pair("speed", value));
+
+    BotTickReport ticks = BotMgr::BuildTickReport(_ticks);
+    int64 retained = int64(_stats.HeapEnd) - int64(_stats.HeapStart);
+
+    std::pair<char const*, uint64> const numbers[] =
+    {
+        { "sessions", _stats.Sessions },
+        { "skipped_sessions", _stats.SkippedSessions },
+        { "failed_logins", _stats.FailedLogins },
+        { "packets", _stats.Packets },
+        { "skipped_packets", _stats.SkippedPackets },
+        { "dropped_packets", _stats.DroppedPackets },
+        { "duration_ms", _stats.Duration },
+        { "ticks", ticks.Ticks },
+        { "tick_avg_ms", ticks.Average },
+        { "tick_p50_ms", ticks.P50 },
+        { "tick_p90_ms", ticks.P90 },
+        { "tick_p99_ms", ticks.P99 },
+        { "tick_p999_ms", ticks.P999 },
+        { "tick_max_ms", ticks.Max },
+        { "heap_start_bytes", _stats.HeapStart },
+        { "heap_peak_bytes", _stats.HeapPeak },
+        { "heap_end_bytes", _stats.HeapEnd },
+        { "rss_start_bytes", _stats.MemoryStart },
+        { "rss_end_bytes", _stats.MemoryEnd },
+        { "packet_allocations", _stats.PacketAllocations },
+        { "packet_heap_allocations", _stats.PacketHeapAllocations },
+        { "movement_relays", _stats.MovementRelays },
+        { "movement_saved_bytes", _stats.MovementSavedBytes }
+    };
+
+    for (std::pair<char const*, uint64> const& number : numbers)
+    {
+        snprintf(value, sizeof(value), UI64FMTD, number.second);
+        report.push_back(std::make_pair(number.first, value));
+    }
+
+    snprintf(value, sizeof(value), UI64FMTD, _stats.HeapPeak - std::min(_stats.HeapPeak, _stats.HeapStart));
+    report.push_back(std::make_pair("heap_growth_bytes", value));
+    snprintf(value, sizeof(value), SI64FMTD, retained);
+    report.push_back(std::make_pair("heap_retained_bytes", value));
+
+    return report;
+}
+
+void ReplayMgr::CompareWithBaseline(std::vector<std::pair<std::string, std::string>> const& report)
+{
+    std::string path = _logsDir + _baseline;
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file)
+    {
+        TC_LOG_ERROR("server", "ReplayMgr: can't open the baseline %s", path.c_str());
+        return;
+    }
+
+    std::map<std::string, std::string> baseline;
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#')
+            continue;
+
+        char key[128], value[384];
+        if (sscanf(line, "%127s %383s", key, value) == 2)
+            baseline[key] = value;
+    }
+
+    fclose(file);
+
+    FILE* out = fopen((_logsDir + _lastReport).c_str(), "a");
+    if (out)
+        fprintf(out, "# compared with %s, build %s\n", _baseline.c_str(), baseline["build"].c_str());
+
+    TC_LOG_INFO("server", "ReplayMgr: compared with %s, build %s", _baseline.c_str(), baseline["build"].c_str());
+
+    if (baseline["capture"] != _fileName || baseline["speed"] != report[2].second)
+        TC_LOG_ERROR("server", "ReplayMgr: the baseline replayed %s at %s, the numbers don't compare", baseline["capture"].c_str(), baseline["speed"].c_str());
+
+    // the build, capture and speed come first and aren't numbers
+    for (size_t i = 3; i < report.size(); ++i)
+    {
+        std::map<std::string, std::string>::const_iterator itr = baseline.find(report[i].first);
+        if (itr == baseline.end())
+            continue;
+
+        double before = atof(itr->second.c_str());
+        double after = atof(report[i].second.c_str());
+
+        char delta[64];
+        if (before != 0.0)
+            snprintf(delta, sizeof(delta), "%+.1f%%", (after - before) * 100.0 / before);
+        else
+            snprintf(delta, sizeof(delta), "%+.0f", after - before);
+
+        TC_LOG_INFO("server", "ReplayMgr: %s %s -> %s (%s)", report[i].first.c_str(), itr->second.c_str(), report[i].second.c_str(), delta);
+        if (out)
+            fprintf(out, "# %s %s -> %s (%s)\n", report[i].first.c_str(), itr->second.c_str(), report[i].second.c_str(), delta);
+    }
+
+    if (out)
+        fclose(out);
+}
+
+std::vector<std::string> ReplayMgr::GetStatus() const
+{
+    std::vector<std::string> lines;
+    char line[256];
+
+    if (!_running)
+    {
+        lines.push_back("Replay: not running");
+        if (!_lastReport.empty())
+        {
+            snprintf(line, sizeof(line), "Last report: %s%s", _logsDir.c_str(), _lastReport.c_str());
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    uint32 loggedIn = 0;
+    uint64 left = 0;
+    for (ReplaySession const& session : _sessions)
+    {
+        if (session.Session->GetPlayer())
+            ++loggedIn;
+        left += session.Packets.size() - session.Next;
+    }
+
+    snprintf(line, sizeof(line), "Replay of %s at %.2fx: " UI64FMTD " of %u seconds", _fileName.c_str(), _speed, _time / IN_MILLISECONDS, _lastPacketTime / IN_MILLISECONDS);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "Sessions: %u, %u in game, %u skipped", _stats.Sessions, loggedIn, _stats.SkippedSessions);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "Packets: " UI64FMTD " queued, " UI64FMTD " dropped, " UI64FMTD " left", _stats.Packets, _stats.DroppedPackets, left);
+    lines.push_back(line);
+
+    BotTickReport ticks = BotMgr::BuildTickReport(_ticks);
+    snprintf(line, sizeof(line), "World update: %u updates, avg %u ms, p50 %u ms, p99 %u ms, max %u ms", ticks.Ticks, ticks.Average, ticks.P50, ticks.P99, ticks.Max);
+    lines.push_back(line);
+
+    return lines;
+}
+
+uint64 ReplayMgr::GetHeapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return uint64(info.uordblks) + uint64(info.hblkhd);
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return uint64(uint32(info.uordblks)) + uint64(uint32(info.hblkhd));
+#else
+    return 0;
+#endif
+}
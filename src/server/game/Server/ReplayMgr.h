@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_REPLAYMGR_H
+#define TRINITY_REPLAYMGR_H
+
+#include "Common.h"
+#include "MovementInterest.h"
+#include "PacketPool.h"
+#include <ace/Singleton.h>
+#include <map>
+#include <vector>
+
+#define REPLAY_SETTLE_TIME              10000               // milliseconds the replay goes on after its last packet
+#define REPLAY_HEAP_SAMPLE_INTERVAL     1000                // milliseconds between two samples of the heap peak
+#define REPLAY_LOGIN_TIMEOUT            10000               // milliseconds a character has to enter the world after its CMSG_PLAYER_LOGIN
+
+class WorldSession;
+
+struct ReplayPacket
+{
+    uint32 Time;                                            // milliseconds from the first packet of the capture
+    uint32 Opcode;
+    std::vector<uint8> Data;
+};
+
+struct ReplayStats
+{
+    uint32 Sessions;
+    uint32 SkippedSessions;                                 // captured after the login, with the account online or without characters
+    uint32 FailedLogins;                                    // never entered the world
+    uint64 Packets;
+    uint64 SkippedPackets;                                  // handled by the socket, never queued to the session
+    uint64 DroppedPackets;                                  // refused by the session queue
+    uint32 Duration;                                        // milliseconds
+    uint64 HeapStart;                                       // bytes
+    uint64 HeapPeak;
+    uint64 HeapEnd;
+    uint64 MemoryStart;                                     // resident bytes
+    uint64 MemoryEnd;
+    uint64 PacketAllocations;                               // of the packet pool, during the replay
+    uint64 PacketHeapAllocations;
+    uint64 MovementRelays;                                  // sent to the players around, during the replay
+    uint64 MovementSavedBytes;                              // of the relays held back for distance and never sent
+};
+
+/*
+ * Replays the client packets of a PacketLog capture for regression benchmarks.
+ *
+ * Every account of the capture gets a session without a socket, flagged as a
+ * bot so its character, inventory and gold are never saved; the mails and
+ * auctions it creates still are. A replay only starts while nobody is online
+ * and the replayed accounts can't log in until it ends. The CMSG packets of the account are
+ * queued to it at the time they were received, from CMSG_PLAYER_LOGIN on, so
+ * the character loads from the database and the rest goes through the same
+ * handlers and map updates as it did live. The characters of the account are
+ * allowed to log in as the character screen would, and the replay fails when
+ * none of them enters the world. The capture should start before
+ * the players log in and the server should run on a copy of the databases
+ * taken when the capture started, restored before every replay.
+ *
+ * The world update times and the heap are sampled during the replay. The
+ * report is written to the logs directory as "key value" lines, and compared
+ * with the report of another build given as the baseline.
+ *
+ * Only touched by the world thread, between the map updates.
+ */
+class ReplayMgr
+{
+    friend class ACE_Singleton<ReplayMgr, ACE_Thread_Mutex>;
+
+    private:
+        ReplayMgr();
+        ~ReplayMgr() { }
+
+    public:
+        // fileName in the logs directory, where PacketLog writes, speed 2.0 replays twice as fast
+        bool Start(std::string const& fileName, float speed, std::string const& baseline);
+        // from the Replay.* config, the server shuts down once the replay finished
+        void StartAtStartup();
+        // logs the sessions out without a report
+        void Stop();
+        bool IsRunning() const { return _running; }
+        // its sessions aren't in the session list of the world, a real login has to be refused
+        bool IsReplayedAccount(uint32 accountId) const;
+
+        void Update(uint32 diff);
+        void RecordTick(uint32 tickTime);
+
+        std::vector<std::string> GetStatus() const;
+        std::string const& GetLastReport() const { return _lastReport; }
+
+        static uint64 GetHeapInUse();                       // bytes, 0 where unknown
+
+    private:
+        struct ReplaySession
+        {
+            uint32 AccountId;
+            WorldSession* Session;
+            std::vector<ReplayPacket> Packets;
+            size_t Next;
+            bool LoggedIn;
+            bool LoginFailed;
+        };
+
+        bool Load(std::string const& fileName);
+        void CreateSessions();
+        void ReplayPackets(ReplaySession& session);
+        void Finish();
+        void CheckLogins();
+        void Fail(char const* reason);
+
+        std::vector<std::pair<std::string, std::string>> GetReport() const;
+        void CompareWithBaseline(std::vector<std::pair<std::string, std::string>> const& report);
+
+        std::vector<ReplaySession> _sessions;
+        std::string _fileName;
+        std::string _baseline;
+        float _speed;
+        bool _running;
+        bool _stopAfter;                                    // started from the config
+        uint64 _time;                                       // milliseconds of world time since the start, scaled by the speed
+        uint32 _lastPacketTime;
+        uint32 _heapTimer;
+        uint32 _startTime;
+
+        std::vector<uint32> _ticks;
+        ReplayStats _stats;
+        PacketPoolStats _poolStart;
+        MovementInterestStats _movementStart;
+
+        std::string _logsDir;
+        std::string _lastReport;
+};
+
+#define sReplayMgr ACE_Singleton<ReplayMgr, ACE_Thread_Mutex>::instance()
+
+#endif
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Opcodes.h"
 #include "ByteBuffer.h"
+#include <new>
 
 struct z_stream_s;
 
@@ -45,6 +46,12 @@ class WorldPacket : public ByteBuffer
         {
         }
 
+        // the packets queued to and from the sessions come from the pool of their storage
+        static void* operator new(size_t size) { return PacketPool::Allocate(size); }
+        static void* operator new(size_t size, std::nothrow_t const&) throw() { return PacketPool::Allocate(size); }
+        static void operator delete(void* packet, size_t size) { PacketPool::Free(packet, size); }
+        static void operator delete(void* packet, std::nothrow_t const&) throw() { PacketPool::Free(packet, sizeof(WorldPacket)); }
+
         void Initialize(Opcodes opcode, size_t newres = 200)
         {
             clear();
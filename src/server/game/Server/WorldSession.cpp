@@ -22,6 +22,7 @@
 
 #include "WorldSocket.h"                                    // must be first to make ACE happy with ACE includes in it
 #include <zlib.h>
+#include <chrono>
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
@@ -45,6 +46,8 @@
 #include "Transport.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include "PacketLog.h"
+#include "Profiler.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -103,6 +106,10 @@ isRecruiter(isARecruiter), _account_name(account_name), timeCharEnumOpcode(0), p
 {
     _warden = NULL;
     _filterAddonMessages = false;
+    _bot = false;
+    _recvQueueOverflow = false;
+    _packetLogGeneration = sPacketLog->GetFilterGeneration();
+    _packetLogged = sPacketLog->IsAccountLogged(id);
 
     if (sock)
     {
@@ -154,9 +161,12 @@ WorldSession::~WorldSession()
 
     ///- empty incoming packet queue
     WorldPacket* packet = NULL;
-    while (_recvQueue.next(packet))
+    while (_recvQueue.Pop(packet))
         delete packet;
 
+    for (std::deque<WorldPacket*>::const_iterator itr = _delayedPackets.begin(); itr != _delayedPackets.end(); ++itr)
+        delete *itr;
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 
     int32 z_res = deflateEnd(_compressionStream);
@@ -298,36 +308,52 @@ uint32 WorldSession::CompressPacket(uint8* buffer, WorldPacket const& packet)
     return bufferSize - _compressionStream->avail_out;
 }
 
-/// Add an incoming packet to the queue
+bool WorldSession::IsPacketLogged()
+{
+    uint32 generation = sPacketLog->GetFilterGeneration();
+    if (_packetLogGeneration.load(std::memory_order_relaxed) != generation)
+    {
+        _packetLogged = sPacketLog->IsAccountLogged(GetAccountId());
+        _packetLogGeneration.store(generation, std::memory_order_release);
+    }
+
+    return _packetLogged;
+}
+
+/// Add an incoming packet to the queue, called by the network thread only
 void WorldSession::QueuePacket(WorldPacket* new_packet, bool& deletePacket)
 {
-    if(sWorld->GetAntiSpamm(new_packet->GetOpcode(), 0) == 0 || sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1) == 0)
-        _recvQueue.add(new_packet);
-    else if(sWorld->GetAntiSpamm(new_packet->GetOpcode(), 0) > antispamm[new_packet->GetOpcode()][0])
+    if (sWorld->GetAntiSpamm(new_packet->GetOpcode(), 0) != 0 && sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1) != 0)
     {
-        if(antispamm[new_packet->GetOpcode()][1] == 0 || ((time(NULL) - antispamm[new_packet->GetOpcode()][1]) > sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1)))
+        if(sWorld->GetAntiSpamm(new_packet->GetOpcode(), 0) > antispamm[new_packet->GetOpcode()][0])
         {
-            antispamm[new_packet->GetOpcode()][0] = 0;
-            antispamm[new_packet->GetOpcode()][1] = time(NULL);
-        }
+            if(antispamm[new_packet->GetOpcode()][1] == 0 || ((time(NULL) - antispamm[new_packet->GetOpcode()][1]) > sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1)))
+            {
+                antispamm[new_packet->GetOpcode()][0] = 0;
+                antispamm[new_packet->GetOpcode()][1] = time(NULL);
+            }
 
-        antispamm[new_packet->GetOpcode()][0]++;
-        _recvQueue.add(new_packet);
-    }
-    else
-    {
-        if((time(NULL) - antispamm[new_packet->GetOpcode()][1]) > sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1))
+            antispamm[new_packet->GetOpcode()][0]++;
+        }
+        else if((time(NULL) - antispamm[new_packet->GetOpcode()][1]) > sWorld->GetAntiSpamm(new_packet->GetOpcode(), 1))
         {
             antispamm[new_packet->GetOpcode()][0] = 1;
             antispamm[new_packet->GetOpcode()][1] = time(NULL);
-            _recvQueue.add(new_packet);
         }
         else
         {
             deletePacket = true;
             new_packet->rfinish();
+            return;
         }
     }
+
+    // the next update disconnects the client, the socket thread can't close it from here
+    if (!_recvQueue.Push(new_packet))
+    {
+        deletePacket = true;
+        _recvQueueOverflow = true;
+    }
 }
 
 /// Logging helper for unexpected opcodes
@@ -349,6 +375,15 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
     packet->print_storage();
 }
 
+void WorldSession::ExecuteOpcode(OpcodeHandler const* opHandle, WorldPacket& packet)
+{
+    PROFILE_SCOPE("WorldSession::ExecuteOpcode", PROFILE_OPCODE, packet.GetOpcode());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    (this->*opHandle->handler)(packet);
+    opHandle->timeStats.Add(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+}
+
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
@@ -357,26 +392,47 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
-    if (IsConnectionIdle())
+    if (IsConnectionIdle() && m_Socket)
+        m_Socket->CloseSocket();
+
+    if (_recvQueueOverflow && m_Socket && !m_Socket->IsClosed())
+    {
+        TC_LOG_ERROR("network", "WorldSession::Update: %s sent more than %u packets between two updates, disconnecting.",
+            GetPlayerName(false).c_str(), uint32(WORLD_SESSION_RECV_QUEUE_SIZE));
         m_Socket->CloseSocket();
+    }
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    WorldPacket* packet = NULL;
-    //! Delete packet after processing by default
-    bool deletePacket = true;
-    //! To prevent infinite loop
-    WorldPacket* firstDelayedPacket = NULL;
-    //! If _recvQueue.peek() == firstDelayedPacket it means that in this Update call, we've processed all
-    //! *properly timed* packets, and we're now at the part of the queue where we find
-    //! delayed packets that were re-enqueued due to improper timing. To prevent an infinite
-    //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
-    //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
-
-    while (m_Socket && !m_Socket->IsClosed() &&
-            !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
-            _recvQueue.next(packet, updater))
+    //! Packets delayed by an earlier update are older than the queued ones and go first.
+    //! The ones delayed in this update are appended behind them and wait for the next update,
+    //! so re-delaying the same packets can't loop forever.
+    std::size_t delayedCount = _delayedPackets.size();
+
+    //! Bots have no socket, the BotMgr queues their packets
+    while (_bot || (m_Socket && !m_Socket->IsClosed()))
     {
+        WorldPacket* packet = NULL;
+        if (delayedCount)
+            packet = _delayedPackets.front();
+        else if (WorldPacket** queued = _recvQueue.Peek())
+            packet = *queued;
+        else
+            break;
+
+        if (!updater.Process(packet))
+            break;
+
+        if (delayedCount)
+        {
+            _delayedPackets.pop_front();
+            --delayedCount;
+        }
+        else
+            _recvQueue.Pop(packet);
+
+        //! Delete packet after processing by default
+        bool deletePacket = true;
         const OpcodeHandler* opHandle = opcodeTable[CMSG][packet->GetOpcode()];
 
         try
@@ -391,12 +447,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         //! the client to be in world yet. We will re-add the packets to the bottom of the queue and process them later.
                         if (!m_playerRecentlyLogout)
                         {
-                            //! Prevent infinite loop
-                            if (!firstDelayedPacket)
-                                firstDelayedPacket = packet;
                             //! Because checking a bool is faster than reallocating memory
                             deletePacket = false;
-                            QueuePacket(packet, deletePacket);
+                            _delayedPackets.push_back(packet);
                             //! Log
                             #ifdef WIN32
                                 TC_LOG_DEBUG("network", "Re-enqueueing packet with opcode %s with with status STATUS_LOGGEDIN. "
@@ -407,7 +460,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else if (_player->IsInWorld())
                     {
                         sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                        (this->*opHandle->handler)(*packet);
+                        ExecuteOpcode(opHandle, *packet);
                         #ifdef WIN32
                         if (sLog->ShouldLog("network", LOG_LEVEL_TRACE) && packet->rpos() < packet->wpos())
                             LogUnprocessedTail(packet);
@@ -423,7 +476,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     {
                         // not expected _player or must checked in packet hanlder
                         sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                        (this->*opHandle->handler)(*packet);
+                        ExecuteOpcode(opHandle, *packet);
                         if (sLog->ShouldLog("network", LOG_LEVEL_TRACE) && packet->rpos() < packet->wpos())
                             LogUnprocessedTail(packet);
                     }
@@ -440,7 +493,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else
                     {
                         sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                        (this->*opHandle->handler)(*packet);
+                        ExecuteOpcode(opHandle, *packet);
                         if (sLog->ShouldLog("network", LOG_LEVEL_TRACE) && packet->rpos() < packet->wpos())
                             LogUnprocessedTail(packet);
                     }
@@ -459,7 +512,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         m_playerRecentlyLogout = false;
 
                     sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                    (this->*opHandle->handler)(*packet);
+                    ExecuteOpcode(opHandle, *packet);
                     if (sLog->ShouldLog("network", LOG_LEVEL_TRACE) && packet->rpos() < packet->wpos())
                         LogUnprocessedTail(packet);
                     break;
@@ -491,7 +544,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     if (m_Socket && !m_Socket->IsClosed())
     {
         if (_warden)
+        {
+            // verified Warden responses may ban, only the world thread applies them
+            if (updater.ProcessLogout())
+                _warden->ProcessVerifiedData();
+
             _warden->Update();
+        }
     }
 
     ProcessQueryCallbacks();
@@ -512,7 +571,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             m_Socket = NULL;
         }
 
-        if (!m_Socket)
+        if (!m_Socket && !_bot)
             return false;                                       //Will remove this session from the world session map
     }
 
@@ -31,6 +31,8 @@
 #include "WorldPacket.h"
 #include "Cryptography/BigNumber.h"
 #include "Opcodes.h"
+#include "SPSCQueue.h"
+#include <deque>
 #include <mutex>
 
 class CalendarEvent;
@@ -79,6 +81,9 @@ enum AccountDataType
 
 #define NUM_ACCOUNT_DATA_TYPES        8
 
+// packets a session may have waiting for its next update, a client sending more is disconnected
+#define WORLD_SESSION_RECV_QUEUE_SIZE 512
+
 #define GLOBAL_CACHE_MASK           0x15
 #define PER_CHARACTER_CACHE_MASK    0xAA
 
@@ -219,6 +224,7 @@ class CharacterCreateInfo
 {
     friend class WorldSession;
     friend class Player;
+    friend class BotMgr;
 
     protected:
         CharacterCreateInfo(std::string name, uint8 race, uint8 cclass, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair, uint8 outfitId,
@@ -284,6 +290,8 @@ class WorldSession
 
         AccountTypes GetSecurity() const { return _security; }
         uint32 GetAccountId() const { return _accountId; }
+        // the account filter of the packet capture, cached until the filter changes
+        bool IsPacketLogged();
         std::string GetAccountName() { return _account_name; }
         Player* GetPlayer() const { return _player; }
         std::string GetPlayerName(bool simple = true) const;
@@ -292,6 +300,11 @@ class WorldSession
         void SetSecurity(AccountTypes security) { _security = security; }
         std::string const& GetRemoteAddress() { return m_Address; }
         void SetPlayer(Player* player);
+        // a simulated player of the BotMgr, without a socket
+        bool IsBot() const { return _bot; }
+        void SetBot(bool bot) { _bot = bot; }
+        // the replays log in without going through the character screen
+        void AllowCharacterLogin(uint32 lowGUID) { _allowedCharsToLogin.insert(lowGUID); }
         uint8 Expansion() const { return m_expansion; }
 
         bool InitWarden(BigNumber* k, std::string os);
@@ -1097,6 +1110,9 @@ class WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        // calls the handler and adds its time to the opcode's histogram
+        void ExecuteOpcode(OpcodeHandler const* opHandle, WorldPacket& packet);
+
         // EnumData helpers
         bool CharCanLogin(uint32 lowGUID)
         {
@@ -1142,7 +1158,14 @@ class WorldSession
         bool _filterAddonMessages;
         uint32 recruiterId;
         bool isRecruiter;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        bool _bot;
+        // filled by the network thread, emptied by World::UpdateSessions() and Map::Update() one after another
+        SPSCQueue<WorldPacket*, WORLD_SESSION_RECV_QUEUE_SIZE> _recvQueue;
+        std::atomic<bool> _recvQueueOverflow;
+        // STATUS_LOGGEDIN packets received before the player got in world, only touched by the updating thread
+        std::deque<WorldPacket*> _delayedPackets;
+        std::atomic<uint32> _packetLogGeneration;
+        std::atomic<bool> _packetLogged;
         time_t timeCharEnumOpcode;
         uint8 playerLoginCounter;
 
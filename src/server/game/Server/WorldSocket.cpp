@@ -226,17 +226,16 @@ int WorldSocket::SendPacket(WorldPacket const* pct)
 
     size_t size = pct->wpos();
 
+    // Dump outgoing packet
+    if (m_Session && sPacketLog->CanLogPacket() && sPacketLog->IsOpcodeLogged(pct->GetOpcode()) && m_Session->IsPacketLogged())
+        sPacketLog->LogPacket(*pct, SERVER_TO_CLIENT, m_Session->GetAccountId());
+
     if (pct->GetOpcode() != SMSG_MONSTER_MOVE)
     {
         if (m_Session)
             if(Player* _player = m_Session->GetPlayer())
                 if (sObjectMgr->IsPlayerInLogList(_player))
-                {
-                    // Dump outgoing packet
-                    if (sPacketLog->CanLogPacket())
-                        sPacketLog->LogPacket(*pct, SERVER_TO_CLIENT);
                     TC_LOG_DEBUG("dupe", "S->C: %s", GetOpcodeNameForLogging(pct->GetOpcode()).c_str());
-                }
         #ifdef WIN32
         TC_LOG_INFO("opcode", "S->C: %s len %u", GetOpcodeNameForLogging(pct->GetOpcode()).c_str(), pct->wpos());
         #endif
@@ -834,6 +833,10 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
     if (closing_)
         return -1;
 
+    // Dump received packet.
+    if (m_Session && sPacketLog->CanLogPacket() && sPacketLog->IsOpcodeLogged(opcode) && m_Session->IsPacketLogged())
+        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER, m_Session->GetAccountId());
+
     if (opcode != CMSG_MOVE_START_FORWARD)
     {
         #ifdef WIN32
@@ -842,12 +845,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
         if (m_Session)
             if(Player* _player = m_Session->GetPlayer())
                 if (sObjectMgr->IsPlayerInLogList(_player))
-                {
-                    // Dump received packet.
-                    if (sPacketLog->CanLogPacket())
-                        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER);
                     TC_LOG_DEBUG("dupe", "C->S: %s", GetOpcodeNameForLogging(opcode).c_str());
-                }
     }
 
     try
@@ -939,8 +937,11 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
                 aptr.release();
                 // WARNING here we call it with locks held.
                 // Its possible to cause deadlock if QueuePacket calls back
-                bool deletePacket = true;
+                bool deletePacket = false;
                 m_Session->QueuePacket (new_pct, deletePacket);
+                // dropped by the anti spam or because the session's queue is full
+                if (deletePacket)
+                    delete new_pct;
                 return 0;
             }
         }
@@ -60,6 +60,7 @@
 #include "ScenarioMgr.h"
 #include "ObjectVisitors.hpp"
 #include "PathGenerator.h"
+#include "Profiler.h"
 
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
@@ -4391,6 +4392,8 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    PROFILE_SCOPE("Spell::update", PROFILE_SPELL, m_spellInfo->Id);
+
     // update pointers based at it's GUIDs
     UpdatePointers();
 
@@ -4910,7 +4913,7 @@ void Spell::SendSpellStart()
         else
             targetMask &= ~(TARGET_FLAG_ITEM | TARGET_FLAG_TRADE_ITEM);
 
-    WorldPacket data(SMSG_SPELL_START, (8+8+4+4+2));
+    WorldPacket data(SMSG_SPELL_START, 64);
     data.WriteBit(!hasRuneState);                               // has rune state after
     data.WriteBit(!hasCastImmunities);                          // !dword198
     data.WriteBit(!hasCastSchoolImmunities);                    // !dword194
@@ -5286,7 +5289,7 @@ void Spell::SendSpellGo()
 
     //TC_LOG_DEBUG("network", "WORLD: SMSG_SPELL_GO, castCount: %u, spellId: %u, castFlags: %u", m_cast_count, m_spellInfo->Id, castFlags);
 
-    WorldPacket data(SMSG_SPELL_GO, 50);                        // guess size
+    WorldPacket data(SMSG_SPELL_GO, 64 + 10 * (hit + miss + extraTargetsCount));    // up to 10 bytes a target
     data.WriteBits(miss, 25);                                   // miss count 2
     data.WriteGuidMask<5>(casterGuid);
     data.WriteGuidMask<1>(itemCasterGuid);
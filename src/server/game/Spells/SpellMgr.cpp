@@ -879,6 +879,16 @@ const std::vector<SpellProcEventEntry>* SpellMgr::GetSpellProcEvent(uint32 spell
     return NULL;
 }
 
+// Union of all proc flags the spell can react to, used by Unit proc aura index
+uint32 SpellMgr::GetSpellProcFlagsMask(SpellInfo const* spellInfo) const
+{
+    uint32 procFlags = spellInfo->ProcFlags;
+    if (std::vector<SpellProcEventEntry> const* spellProcEvents = GetSpellProcEvent(spellInfo->Id))
+        for (std::vector<SpellProcEventEntry>::const_iterator itr = spellProcEvents->begin(); itr != spellProcEvents->end(); ++itr)
+            procFlags |= itr->procFlags;
+    return procFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active)
 {
     // No extra req need
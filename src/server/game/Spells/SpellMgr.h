@@ -993,6 +993,7 @@ class SpellMgr
 
         // Spell proc event table
         const std::vector<SpellProcEventEntry>* GetSpellProcEvent(uint32 spellId) const;
+        uint32 GetSpellProcFlagsMask(SpellInfo const* spellInfo) const;
         bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active);
 
         // Spell proc table
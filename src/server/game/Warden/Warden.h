@@ -25,8 +25,8 @@
 #include "ByteBuffer.h"
 #include "WardenMgr.h"
 
-#define BASE_CHECKS_HEADER "686561646572"
-#define EXTENDED_CHECKS_HEADER "53595354454D"
+#define BASE_CHECKS_HEADER "header"
+#define EXTENDED_CHECKS_HEADER "SYSTEM"
 
 class WorldSession;
 
@@ -148,7 +148,8 @@ class Warden
 
         virtual void HandleData(ByteBuffer &buff) = 0;
 
-        virtual void CommonChecksHandler(ByteBuffer &buff) = 0;
+        // applies the outcome of responses verified on the thread pool, the world thread only as it may ban
+        virtual void ProcessVerifiedData() {};
 
         virtual void SendDbcChecks() {};
         virtual void InitializeMPQCheckFuncFake() {};
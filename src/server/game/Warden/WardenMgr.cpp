@@ -90,6 +90,17 @@ void WardenMgr::LoadWardenChecks()
         else
             wardenCheck->Comment = comment;
 
+        // same bytes BigNumber::SetHexStr + AsByteArray(24, false) sent before: leading zero bytes dropped, zero filled up to 24 bytes
+        std::vector<uint8> dataBytes = HexStrToByteArray(data);
+        std::vector<uint8>::iterator firstByte = std::find_if(dataBytes.begin(), dataBytes.end(), [](uint8 byte) { return byte != 0; });
+        dataBytes.erase(dataBytes.begin(), firstByte);
+        dataBytes.resize(24, 0);
+        memcpy(wardenCheck->DataBytes, &dataBytes[0], 24);
+
+        wardenCheck->ResultBytes = HexStrToByteArray(result);
+        if (checkType == MPQ_CHECK && wardenCheck->ResultBytes.size() != 20)
+            TC_LOG_ERROR("sql", "Warden MPQ check %u has a result of %u bytes instead of a 20 bytes SHA1 hash, it can never pass", id, uint32(wardenCheck->ResultBytes.size()));
+
         checkStore[id] = wardenCheck;
         BaseChecksIdPool.push_back(id);
 
@@ -173,6 +184,24 @@ void WardenMgr::LoadWardenCustomMPQData()
         data.Locale = fields[3].GetInt32();
         data.Comment = fields[4].GetString();
 
+        WardenMPQHash hash;
+        hash.Locale = data.Locale;
+        hash.Comment = data.Comment;
+
+        std::vector<uint8> hashBytes = HexStrToByteArray(data.Hash);
+        if (hashBytes.size() != sizeof(hash.Hash))
+        {
+            TC_LOG_ERROR("sql", "Table `warden_custom_mpq_data` has a hash of %u bytes instead of 20 for id %u, skipped", uint32(hashBytes.size()), id);
+            continue;
+        }
+
+        memcpy(hash.Hash, &hashBytes[0], sizeof(hash.Hash));
+
+        // the checks ask for "DBFilesClient\\<file>", the table has the file name only
+        for (WardenCheck* check : checkStore)
+            if (check && check->Type == MPQ_CHECK && check->Str.size() >= 14 && check->Str.compare(14, std::string::npos, data.FileName) == 0)
+                check->MPQHashes.push_back(hash);
+
         ++count;
     } while (result->NextRow());
 
@@ -334,39 +363,15 @@ WardenModule* WardenMgr::GetModuleById(std::string name, std::string os)
     return nullptr;
 }
 
-std::string WardenMgr::GetLocalesMPQHash(std::string filename, uint32 locale)
+void WardenVerifyStats::Reset()
 {
-    for (auto const& mpqData : customMPQDataStore)
+    Responses = 0;
+    ResponseTime = 0;
+    for (uint8 i = 0; i < MAX_CHECK_TYPE; ++i)
     {
-        if (filename != mpqData.second.FileName)
-            continue;
-
-        if (locale == mpqData.second.Locale)
-            return mpqData.second.Hash;
+        Checks[i] = 0;
+        CheckTime[i] = 0;
     }
-
-    return "";
-}
-
-bool WardenMgr::CheckCustomMPQDataHash(std::string filename, std::string& result, std::string packet, std::string& comment)
-{
-    for (auto const& mpqData : customMPQDataStore)
-    {
-        if (filename != mpqData.second.FileName)
-            continue;
-
-        if (mpqData.second.Locale != -1)
-            continue;
-
-        if (!strcmp(packet.c_str(), mpqData.second.Hash.c_str()))
-        {
-            result = mpqData.second.Hash;
-            comment = mpqData.second.Comment;
-            return true;
-        }
-    }
-
-    return false;
 }
 
 std::string WardenMgr::ByteArrayToString(const uint8 * packet_data, uint16 length)
@@ -386,6 +391,41 @@ std::string WardenMgr::ByteArrayToString(const uint8 * packet_data, uint16 lengt
     return data_str;
 }
 
+std::vector<uint8> WardenMgr::HexStrToByteArray(std::string const& str)
+{
+    std::vector<uint8> bytes;
+    bytes.reserve(str.size() / 2 + 1);
+
+    // an odd number of digits has an implicit leading zero, like for BigNumber
+    size_t i = str.size() % 2;
+    if (i)
+        bytes.push_back(uint8(strtoul(str.substr(0, 1).c_str(), NULL, 16)));
+
+    for (; i < str.size(); i += 2)
+        bytes.push_back(uint8(strtoul(str.substr(i, 2).c_str(), NULL, 16)));
+
+    return bytes;
+}
+
+char const* WardenMgr::GetCheckTypeName(uint8 type)
+{
+    switch (type)
+    {
+        case TIME_CHECK:      return "TIME_CHECK";
+        case MEM_CHECK:       return "MEM_CHECK";
+        case PAGE_CHECK_A:    return "PAGE_CHECK_A";
+        case PAGE_CHECK_B:    return "PAGE_CHECK_B";
+        case MPQ_CHECK:       return "MPQ_CHECK";
+        case DRIVER_CHECK:    return "DRIVER_CHECK";
+        case MODULE_CHECK:    return "MODULE_CHECK";
+        case LUA_STR_CHECK:   return "LUA_STR_CHECK";
+        case PROC_CHECK:      return "PROC_CHECK";
+        case LUA_EXEC_CHECK:  return "LUA_EXEC_CHECK";
+        case GET_SYSTEM_INFO: return "GET_SYSTEM_INFO";
+        default:              return "UNKNOWN";
+    }
+}
+
 std::vector<uint16>::iterator WardenMgr::GetRandomCheckFromList(std::vector<uint16>::iterator begin, std::vector<uint16>::iterator end)
 {
     const unsigned long n = std::distance(begin, end);
@@ -19,6 +19,7 @@
 #ifndef _WARDENCHECKMGR_H
 #define _WARDENCHECKMGR_H
 
+#include <atomic>
 #include <map>
 #include "Cryptography/BigNumber.h"
 
@@ -75,6 +76,14 @@ enum WardenActions
     WARDEN_ACTION_PENDING_KICK = 3
 };
 
+// expected hash of a file for a client locale, or of an allowed custom patch of it
+struct WardenMPQHash
+{
+    int32 Locale;                                           // -1 for custom patches
+    uint8 Hash[20];
+    std::string Comment;
+};
+
 struct WardenCheck
 {
     WardenCheck(uint8 checkType, std::string data, std::string str, uint32 address, uint8 length, std::string result, std::string banReason, WardenActions action, uint32 bantime, std::string comment) : Type(checkType),
@@ -91,6 +100,25 @@ struct WardenCheck
     uint32 BanTime;
     bool Enabled;
     std::string Comment;
+
+    // Data and Result decoded once at load, requests and responses use the bytes
+    uint8 DataBytes[24];
+    std::vector<uint8> ResultBytes;
+    // MPQ_CHECK: hashes accepted instead of Result, from warden_custom_mpq_data
+    std::vector<WardenMPQHash> MPQHashes;
+};
+
+// time spent verifying client responses on the thread pool, shown by .debug wardenstats
+struct WardenVerifyStats
+{
+    WardenVerifyStats() { Reset(); }
+
+    std::atomic<uint64> Responses;
+    std::atomic<uint64> ResponseTime;                       // microseconds, the checks included
+    std::atomic<uint64> Checks[MAX_CHECK_TYPE];
+    std::atomic<uint64> CheckTime[MAX_CHECK_TYPE];
+
+    void Reset();
 };
 
 struct WardenCustomMPQ
@@ -129,11 +157,11 @@ class WardenMgr
 
         // utlities
         std::string ByteArrayToString(const uint8 * packet_data, uint16 length);
+        static std::vector<uint8> HexStrToByteArray(std::string const& str);
+        static char const* GetCheckTypeName(uint8 type);
         std::vector<uint16>::iterator GetRandomCheckFromList(std::vector<uint16>::iterator begin, std::vector<uint16>::iterator end);
 
-        // mpq helpers
-        std::string GetLocalesMPQHash(std::string filename, uint32 locale);
-        bool CheckCustomMPQDataHash(std::string filename, std::string& result, std::string packet, std::string& comment);
+        WardenVerifyStats& GetVerifyStats() { return verifyStats; }
 
         ACE_RW_Mutex _checkStoreLock;
         ACE_RW_Mutex _moduleStoreLock;
@@ -142,6 +170,7 @@ class WardenMgr
         CheckContainer checkStore;
         ModuleContainer moduleStore;
         CustomMPQDataContainer customMPQDataStore;
+        WardenVerifyStats verifyStats;
 };
 
 #define _wardenMgr ACE_Singleton<WardenMgr, ACE_Null_Mutex>::instance()
@@ -31,6 +31,9 @@
 #include "WardenMgr.h"
 #include "AccountMgr.h"
 #include "SpellAuraEffects.h"
+#include "ThreadPoolMgr.hpp"
+
+#include <chrono>
 
 WardenWin::WardenWin(WorldSession* session) : Warden(session)
 {
@@ -166,10 +169,7 @@ void WardenWin::HandleHashResult(ByteBuffer &buff)
     uint8 clientSeedHash[20];
     buff.read(clientSeedHash, 20);
 
-    std::string hashStr = _wardenMgr->ByteArrayToString(clientSeedHash, 20);
-    std::string realHashStr = _wardenMgr->ByteArrayToString(_currentModule->ClientKeySeedHash, 20);
-
-    if (strcmp(hashStr.c_str(), realHashStr.c_str()))
+    if (memcmp(clientSeedHash, _currentModule->ClientKeySeedHash, 20))
     {
         TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed hash reply. Action: Kick",
             _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
@@ -350,9 +350,7 @@ uint16 WardenWin::BuildCheckData(WardenCheck* wd, ByteBuffer &buff, ByteBuffer &
         case PAGE_CHECK_A:
         case PAGE_CHECK_B:
         {
-            BigNumber d;
-            d.SetHexStr(wd->Data.c_str());
-            buff.append(d.AsByteArray(24, false), 24);
+            buff.append(wd->DataBytes, 24);
             buff << uint32(wd->Address);
             buff << uint8(wd->Length);
             break;
@@ -365,9 +363,7 @@ uint16 WardenWin::BuildCheckData(WardenCheck* wd, ByteBuffer &buff, ByteBuffer &
         }
         case DRIVER_CHECK:
         {
-            BigNumber d;
-            d.SetHexStr(wd->Data.c_str());
-            buff.append(d.AsByteArray(24, false), 24);
+            buff.append(wd->DataBytes, 24);
             buff << uint8(index++);
             break;
         }
@@ -391,9 +387,7 @@ uint16 WardenWin::BuildCheckData(WardenCheck* wd, ByteBuffer &buff, ByteBuffer &
             hmac.Finalize();
             buff.append(hmac.GetDigest(), hmac.GetLength());
             break;*/
-            BigNumber d;
-            d.SetHexStr(wd->Data.c_str());
-            buff.append(d.AsByteArray(24, false), 24);
+            buff.append(wd->DataBytes, 24);
             buff << uint8(index++);
             buff << uint8(index++);
             buff << uint32(wd->Address);
@@ -459,187 +453,235 @@ void WardenWin::HandleData(ByteBuffer &buff)
     // reset response wait timer
     _clientResponseTimer = 0;
 
-    // read and validate length+checksum - for all packets
-    uint16 length;
-    buff >> length;
-    uint32 checksum;
-    buff >> checksum;
+    // the previous response may change the state, one still being verified makes this one a duplicate
+    ProcessVerifiedData();
 
-    if (!length)
+    if (_verification)
     {
         buff.rfinish();
-        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed packet length. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-        _session->KickPlayer();
+        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) sent a Warden response while the previous one is verified. Action: None", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
         return;
     }
 
-    if (!IsValidCheckSum(checksum, buff.contents() + buff.rpos(), length))
+    if (GetState() != WARDEN_MODULE_WAIT_RESPONSE && GetState() != WARDEN_MODULE_SPECIAL_DBC_CHECKS)
     {
         buff.rfinish();
-        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed checksum. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
+        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) has received wrong Warden packet. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
         _session->KickPlayer();
         return;
     }
 
-    // handlers (header + payload) - divide packets
+    // the checksum and the checks are verified on the thread pool, the outcome is applied by ProcessVerifiedData()
+    std::shared_ptr<WardenVerification> verification = std::make_shared<WardenVerification>();
+    verification->Data = buff;
+    verification->Checks = _currentChecks;
+    verification->State = GetState();
+    verification->AccountId = _session->GetAccountId();
+    verification->AccountName = _session->GetAccountName();
+    buff.rfinish();
+
+    // the answer arrived, the next checks are sent in 33 seconds without waiting for the verification
     if (GetState() == WARDEN_MODULE_WAIT_RESPONSE)
-        HandleBaseChecksData(buff);
-    else if (GetState() == WARDEN_MODULE_SPECIAL_DBC_CHECKS)
-        HandleDbcChecksData(buff);
-    else
     {
-        buff.rfinish();
-        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) has received wrong Warden packet. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-        _session->KickPlayer();
+        _state = WARDEN_MODULE_READY;
+        _checkTimer = 33 * IN_MILLISECONDS;
     }
+
+    _verification = verification;
+    sThreadPoolMgr->schedule([verification]() { WardenWin::Verify(*verification); });
 }
 
-void WardenWin::HandleBaseChecksData(ByteBuffer &buff)
+void WardenWin::ProcessVerifiedData()
 {
-    /*uint8 timeCheckResult;
-    buff >> timeCheckResult;
+    if (!_verification || !_verification->Done.load(std::memory_order_acquire))
+        return;
+
+    std::shared_ptr<WardenVerification> verification;
+    verification.swap(_verification);
 
-    if (!timeCheckResult)
+    switch (verification->Result)
     {
-        buff.rfinish();
-        TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed TIME_CHECK. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-        _session->KickPlayer();
-        return;
-    }
+        case WARDEN_VERIFY_PASSED:
+        {
+            if (verification->State == WARDEN_MODULE_SPECIAL_DBC_CHECKS)
+            {
+                _state = WARDEN_MODULE_WAIT_INITIALIZE;
+                _reInitTimer = 4 * IN_MILLISECONDS;
+            }
+            break;
+        }
+        case WARDEN_VERIFY_KICK:
+        {
+            _session->KickPlayer();
+            break;
+        }
+        case WARDEN_VERIFY_FAILED:
+        {
+            TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed Warden check %u. Action: %s", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId(),
+                verification->FailedCheckId, Penalty(verification->FailedCheckId).c_str());
 
-    uint32 newClientTicks;
-    buff >> newClientTicks;
+            if (verification->State == WARDEN_MODULE_SPECIAL_DBC_CHECKS)
+                _state = WARDEN_MODULE_SET_PLAYER_PENDING_LOCK;
+            break;
+        }
+        default:
+            break;
+    }
+}
 
-    uint32 ticksNow = getMSTime();
-    uint32 ourTicks = newClientTicks + (ticksNow - _serverTicks);
+void WardenWin::Verify(WardenVerification& verification)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-    TC_LOG_DEBUG("warden", "ServerTicks %u", ticksNow);         // Now
-    TC_LOG_DEBUG("warden", "RequestTicks %u", _serverTicks);    // At request
-    TC_LOG_DEBUG("warden", "Ticks %u", newClientTicks);         // At response
-    TC_LOG_DEBUG("warden", "Ticks diff %u", ourTicks - newClientTicks);*/
+    ByteBuffer& buff = verification.Data;
+    WardenVerifyResult result = WARDEN_VERIFY_NONE;
 
-    uint8 headerRes;
-    buff >> headerRes;
+    try
+    {
+        // read and validate length+checksum - for all packets
+        uint16 length;
+        buff >> length;
+        uint32 checksum;
+        buff >> checksum;
 
-    if (headerRes)
+        if (!length || buff.rpos() + length > buff.size())
+        {
+            TC_LOG_DEBUG("warden","Account %s (Id: %u) failed packet length. Action: Kick", verification.AccountName.c_str(), verification.AccountId);
+            result = WARDEN_VERIFY_KICK;
+        }
+        else if (!IsValidCheckSum(checksum, buff.contents() + buff.rpos(), length))
+        {
+            TC_LOG_DEBUG("warden","Account %s (Id: %u) failed checksum. Action: Kick", verification.AccountName.c_str(), verification.AccountId);
+            result = WARDEN_VERIFY_KICK;
+        }
+        else if (verification.State == WARDEN_MODULE_WAIT_RESPONSE)
+            result = VerifyBaseChecks(verification);
+        else
+            result = VerifyDbcChecks(verification);
+    }
+    catch (ByteBufferException &)
     {
-        buff.rfinish();
-        TC_LOG_DEBUG("warden","WARDEN: Player %s (guid: %u, account: %u) failed validate Warden packet header. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-        _session->KickPlayer();
-        return;
+        TC_LOG_DEBUG("warden","Account %s (Id: %u) sent a truncated Warden response. Action: None", verification.AccountName.c_str(), verification.AccountId);
+        result = WARDEN_VERIFY_NONE;
     }
 
-    uint8 bytes[6];
-    buff.read(bytes, 6);
-    std::string headerStr = _wardenMgr->ByteArrayToString(bytes, 6);
+    WardenVerifyStats& stats = _wardenMgr->GetVerifyStats();
+    ++stats.Responses;
+    stats.ResponseTime += uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    verification.Result = result;
+    verification.Done.store(true, std::memory_order_release);
+}
+
+WardenVerifyResult WardenWin::VerifyBaseChecks(WardenVerification& verification)
+{
+    ByteBuffer& buff = verification.Data;
 
-    if (headerStr == BASE_CHECKS_HEADER)
-        CommonChecksHandler(buff);
-    //else if (headerStr == EXTENDED_CHECKS_HEADER)
-        //ExtendedChecksHandler(buff);
-    else
+    uint8 headerRes;
+    buff >> headerRes;
+
+    uint8 header[6];
+    if (!headerRes)
+        buff.read(header, 6);
+
+    if (headerRes || memcmp(header, BASE_CHECKS_HEADER, 6))
     {
-        buff.rfinish();
-        TC_LOG_DEBUG("warden","WARDEN: Player %s (guid: %u, account: %u) failed validate Warden packet header. Action: Kick", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-        _session->KickPlayer();
-        return;
+        TC_LOG_DEBUG("warden","WARDEN: Account %s (Id: %u) failed validate Warden packet header. Action: Kick", verification.AccountName.c_str(), verification.AccountId);
+        return WARDEN_VERIFY_KICK;
     }
+
+    return VerifyCommonChecks(verification);
 }
 
-void WardenWin::HandleDbcChecksData(ByteBuffer &buff)
+WardenVerifyResult WardenWin::VerifyDbcChecks(WardenVerification& verification)
 {
-    ACE_READ_GUARD(ACE_RW_Mutex, g, _wardenMgr->_checkStoreLock);
+    ByteBuffer& buff = verification.Data;
+    WardenVerifyStats& stats = _wardenMgr->GetVerifyStats();
+
+    ACE_READ_GUARD_RETURN(ACE_RW_Mutex, g, _wardenMgr->_checkStoreLock, WARDEN_VERIFY_NONE);
 
     uint8 memResult;
     buff >> memResult;
 
     if (memResult)
     {
-        buff.rfinish();
-        TC_LOG_DEBUG("warden","Function for MEM_CHECK hasn't been called, CheckId Special account Id %u. Action: Kick", _session->GetAccountId());
-        _session->KickPlayer();
-        return;
+        TC_LOG_DEBUG("warden","Function for MEM_CHECK hasn't been called, CheckId Special account Id %u. Action: Kick", verification.AccountId);
+        return WARDEN_VERIFY_KICK;
     }
 
     uint32 clientLocale;
     buff >> clientLocale;
 
-    for (std::vector<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = verification.Checks.begin(); itr != verification.Checks.end(); ++itr)
     {
-        WardenCheck* rd = _wardenMgr->GetCheckDataById(*itr);
+        WardenCheck const* rd = _wardenMgr->GetCheckDataById(*itr);
 
         // remove whole packet if data array is corrupted or check in packet was disabled
         if (!rd || !rd->Enabled)
         {
-            buff.rfinish();
-            TC_LOG_DEBUG("warden","Warden check with Id %u has disabled or checkStorage has corrupted data for player %s (guid: %u, account: %u). Action: None", *itr, _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-            return;
+            TC_LOG_DEBUG("warden","Warden check with Id %u has disabled or checkStorage has corrupted data for account %s (Id: %u). Action: None", *itr, verification.AccountName.c_str(), verification.AccountId);
+            return WARDEN_VERIFY_NONE;
         }
 
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        WardenVerifyResult result = WARDEN_VERIFY_PASSED;
+
         uint8 mpqResult;
         buff >> mpqResult;
 
         if (mpqResult)
         {
-            buff.rfinish();
-            TC_LOG_DEBUG("warden","Function for MPQ_CHECK hasn't been called, CheckId %u account Id %u. Action: Kick", *itr, _session->GetAccountId());
-            _session->KickPlayer();
-            return;
+            TC_LOG_DEBUG("warden","Function for MPQ_CHECK hasn't been called, CheckId %u account Id %u. Action: Kick", *itr, verification.AccountId);
+            result = WARDEN_VERIFY_KICK;
         }
+        else
+        {
+            uint8 hash[20];
+            buff.read(hash, 20);
 
-        std::string result = rd->Result;
-        std::string packet_data = _wardenMgr->ByteArrayToString(buff.contents() + buff.rpos(), 20);
-
-        // handle custom MPQ data - mpq with locale strings and custom allowed patches
-        std::string customHash = GetCustomMPQData(rd->Str, packet_data, clientLocale);
-
-        if (customHash != "")
-            result = customHash;
+            if (!IsValidMPQHash(rd, hash, clientLocale, verification))
+            {
+                TC_LOG_DEBUG("warden","RESULT MPQ_CHECK fail, CheckId %u account Id %u, realData - %s, failedData - %s", *itr, verification.AccountId, rd->Result.c_str(), _wardenMgr->ByteArrayToString(hash, 20).c_str());
+                result = WARDEN_VERIFY_FAILED;
+            }
+        }
 
-        // debug
-        //TC_LOG_DEBUG("warden","RESULT MPQ_CHECK, CheckId %u account Id %u, realData - %s, packetData - %s, client locale - %u", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str(), clientLocale);
+        ++stats.Checks[MPQ_CHECK];
+        stats.CheckTime[MPQ_CHECK] += uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 
-        if (strcmp(result.c_str(), packet_data.c_str()))
+        if (result != WARDEN_VERIFY_PASSED)
         {
-            buff.rfinish();
-            TC_LOG_DEBUG("warden","RESULT MPQ_CHECK fail, CheckId %u account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), result.c_str(), packet_data.c_str());
-            TC_LOG_DEBUG("warden","Account %s (Id: %u) failed Warden check %u. Action: %s", _session->GetAccountName().c_str(), _session->GetAccountId(), *itr, Penalty(*itr).c_str());
-            _state = WARDEN_MODULE_SET_PLAYER_PENDING_LOCK;
-            return;
+            verification.FailedCheckId = *itr;
+            return result;
         }
-
-        buff.rpos(buff.rpos() + 20);
     }
 
-    _state = WARDEN_MODULE_WAIT_INITIALIZE;
-    _reInitTimer = 4 * IN_MILLISECONDS;
+    return WARDEN_VERIFY_PASSED;
 }
 
-void WardenWin::CommonChecksHandler(ByteBuffer &buff)
+WardenVerifyResult WardenWin::VerifyCommonChecks(WardenVerification& verification)
 {
-    WardenCheck *rd = nullptr;
+    ByteBuffer& buff = verification.Data;
+    WardenVerifyStats& stats = _wardenMgr->GetVerifyStats();
 
-    // TODO:
-    _state = WARDEN_MODULE_READY;
-    _checkTimer = 33 * IN_MILLISECONDS;
+    ACE_READ_GUARD_RETURN(ACE_RW_Mutex, g, _wardenMgr->_checkStoreLock, WARDEN_VERIFY_NONE);
 
-    ACE_READ_GUARD(ACE_RW_Mutex, g, _wardenMgr->_checkStoreLock);
-
-    for (std::vector<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = verification.Checks.begin(); itr != verification.Checks.end(); ++itr)
     {
-        rd = _wardenMgr->GetCheckDataById(*itr);
+        WardenCheck const* rd = _wardenMgr->GetCheckDataById(*itr);
 
         if (!rd)
             continue;
 
-        // remove whole packet if data array is corrupted or check in packet was disabled
-        if (!rd || !rd->Enabled)
+        // remove whole packet if check in packet was disabled
+        if (!rd->Enabled)
         {
-            buff.rfinish();
-            TC_LOG_DEBUG("warden","Warden check with Id %u has disabled or checkStorage has corrupted data for player %s (guid: %u, account: %u). Action: None", *itr, _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId());
-            return;
+            TC_LOG_DEBUG("warden","Warden check with Id %u has disabled or checkStorage has corrupted data for account %s (Id: %u). Action: None", *itr, verification.AccountName.c_str(), verification.AccountId);
+            return WARDEN_VERIFY_NONE;
         }
 
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        WardenVerifyResult result = WARDEN_VERIFY_PASSED;
         uint8 type = rd->Type;
 
         switch (type)
@@ -651,22 +693,19 @@ void WardenWin::CommonChecksHandler(ByteBuffer &buff)
 
                 if (memResult)
                 {
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","Function for MEM_CHECK hasn't been called, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    _session->KickPlayer();
-                    return;
+                    TC_LOG_DEBUG("warden","Function for MEM_CHECK hasn't been called, CheckId %u account Id %u", *itr, verification.AccountId);
+                    result = WARDEN_VERIFY_KICK;
+                    break;
                 }
 
-                std::string packet_data = _wardenMgr->ByteArrayToString(buff.contents() + buff.rpos(), rd->Length);
-                if (strcmp(rd->Result.c_str(), packet_data.c_str()))
+                uint8 memory[UINT8_MAX];
+                buff.read(memory, rd->Length);
+
+                if (rd->ResultBytes.size() != rd->Length || memcmp(memory, rd->ResultBytes.data(), rd->Length))
                 {
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","RESULT MEM_CHECK fail CheckId %u account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-                    TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed Warden check %u. Action: %s", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId(), *itr, Penalty(*itr).c_str());
-                    return;
+                    TC_LOG_DEBUG("warden","RESULT MEM_CHECK fail CheckId %u account Id %u, realData - %s, failedData - %s", *itr, verification.AccountId, rd->Result.c_str(), _wardenMgr->ByteArrayToString(memory, rd->Length).c_str());
+                    result = WARDEN_VERIFY_FAILED;
                 }
-
-                buff.rpos(buff.rpos() + rd->Length);
                 break;
             }
             case PAGE_CHECK_A:
@@ -675,57 +714,21 @@ void WardenWin::CommonChecksHandler(ByteBuffer &buff)
             case MODULE_CHECK:
             case PROC_CHECK:
             {
-                std::string packet_data = _wardenMgr->ByteArrayToString(buff.contents() + buff.rpos(), 1);
-                if (strcmp(rd->Result.c_str(), packet_data.c_str()))
+                uint8 checkResult;
+                buff >> checkResult;
+
+                if (rd->ResultBytes.size() != 1 || rd->ResultBytes[0] != checkResult)
                 {
-                    buff.rfinish();
-
-                    if (type == PAGE_CHECK_A || type == PAGE_CHECK_B)
-                        TC_LOG_DEBUG("warden","RESULT PAGE_CHECK fail, CheckId %u, account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-                    if (type == MODULE_CHECK)
-                        TC_LOG_DEBUG("warden","RESULT MODULE_CHECK fail, CheckId %u, account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-                    if (type == DRIVER_CHECK)
-                        TC_LOG_DEBUG("warden","RESULT DRIVER_CHECK fail, CheckId %u, account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-                    if (type == PROC_CHECK)
-                        TC_LOG_DEBUG("warden","RESULT PROC_CHECK fail, CheckId %u, account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-
-                    TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed Warden check %u. Action: %s", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId(), *itr, Penalty(*itr).c_str());
-                    return;
+                    TC_LOG_DEBUG("warden","RESULT %s fail, CheckId %u, account Id %u, realData - %s, failedData - %s", WardenMgr::GetCheckTypeName(type), *itr, verification.AccountId, rd->Result.c_str(), _wardenMgr->ByteArrayToString(&checkResult, 1).c_str());
+                    result = WARDEN_VERIFY_FAILED;
                 }
-
-                buff.rpos(buff.rpos() + 1);
                 break;
             }
             case MPQ_CHECK:
             {
+                // only the result byte, the file hashes are verified by the DBC checks
                 uint8 mpqResult;
                 buff >> mpqResult;
-
-                /*if (mpqResult)
-                {
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","Function for MPQ_CHECK hasn't been called, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    _session->KickPlayer();
-                    return;
-                }
-
-                std::string packet_data = _wardenMgr->ByteArrayToString(buff.contents() + buff.rpos(), 20);
-
-                // handle locales hash
-                std::string extResult = GetMPQHashForLocales(*itr);
-                if (extResult != "")
-                    rd->Result = extResult;
-
-                if (strcmp(rd->Result.c_str(), packet_data.c_str()))
-                {
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","RESULT MPQ_CHECK fail, CheckId %u account Id %u, realData - %s, failedData - %s", *itr, _session->GetAccountId(), rd->Result.c_str(), packet_data.c_str());
-                    TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed Warden check %u. Action: %s", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId(), *itr, Penalty(*itr).c_str());
-                    SetPlayerLocked(*itr, rd);
-                    return;
-                }
-
-                buff.rpos(buff.rpos() + 20);*/
                 break;
             }
             case LUA_STR_CHECK:
@@ -736,10 +739,9 @@ void WardenWin::CommonChecksHandler(ByteBuffer &buff)
 
                 if (luaResult)
                 {
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","Function for LUA_STR_CHECK hasn't been called, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    _session->KickPlayer();
-                    return;
+                    TC_LOG_DEBUG("warden","Function for LUA_STR_CHECK hasn't been called, CheckId %u account Id %u", *itr, verification.AccountId);
+                    result = WARDEN_VERIFY_KICK;
+                    break;
                 }
 
                 uint8 luaStrLen;
@@ -747,51 +749,64 @@ void WardenWin::CommonChecksHandler(ByteBuffer &buff)
 
                 if (luaStrLen)
                 {
-                    char *str = new char[luaStrLen + 1];
-                    memset(str, 0, luaStrLen + 1);
-                    memcpy(str, buff.contents() + buff.rpos(), luaStrLen);
-                    TC_LOG_DEBUG("warden","RESULT LUA_STR_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    TC_LOG_DEBUG("warden","Lua string found: %s", str);
-                    delete[] str;
-
-                    buff.rfinish();
-                    TC_LOG_DEBUG("warden","Player %s (guid: %u, account: %u) failed Warden check %u. Action: %s", _session->GetPlayerName().c_str(), _session->GetGuidLow(), _session->GetAccountId(), *itr, Penalty(*itr).c_str());
-                    return;
+                    std::string str(luaStrLen, '\0');
+                    buff.read((uint8*)&str[0], luaStrLen);
+                    TC_LOG_DEBUG("warden","RESULT LUA_STR_CHECK fail, CheckId %u account Id %u", *itr, verification.AccountId);
+                    TC_LOG_DEBUG("warden","Lua string found: %s", str.c_str());
+                    result = WARDEN_VERIFY_FAILED;
                 }
                 break;
             }
             default:
                 break;
         }
+
+        if (type < MAX_CHECK_TYPE)
+        {
+            ++stats.Checks[type];
+            stats.CheckTime[type] += uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        if (result != WARDEN_VERIFY_PASSED)
+        {
+            verification.FailedCheckId = *itr;
+            return result;
+        }
     }
 
-    // right place, but fucking returns in checks
-    //_state = WARDEN_MODULE_READY;
-    //_checkTimer = sWorld->getIntConfig(CONFIG_WARDEN_STATIC_CHECK_HOLDOFF);
+    return WARDEN_VERIFY_PASSED;
 }
 
-std::string WardenWin::GetCustomMPQData(std::string dbcName, std::string packet, uint32 clientLocale)
+bool WardenWin::IsValidMPQHash(WardenCheck const* check, uint8 const* hash, uint32 clientLocale, WardenVerification const& verification)
 {
-    std::string result = "";
-
-    // get normalize fileName
-    dbcName = dbcName.substr(14, dbcName.size());
-
-    // check locales
-    if (clientLocale != LOCALE_ruRU)
-        result = _wardenMgr->GetLocalesMPQHash(dbcName, clientLocale);
-
     // logged koKR, zhCN, zhTW and allowed it
     if (clientLocale == LOCALE_koKR || clientLocale == LOCALE_zhCN || clientLocale == LOCALE_zhTW)
     {
-        TC_LOG_DEBUG("warden","Detect rare locale %u, data from packet %s for future fixes", clientLocale, packet.c_str());
-        result = packet;
+        TC_LOG_DEBUG("warden","Detect rare locale %u, data from packet %s for future fixes", clientLocale, _wardenMgr->ByteArrayToString(hash, 20).c_str());
+        return true;
     }
 
-    // check custom patches
-    std::string comment = "";
-    if (_wardenMgr->CheckCustomMPQDataHash(dbcName, result, packet, comment))
-        TC_LOG_DEBUG("warden","Account %s (id: %u) have custom MPQ patch (%s). Action: None", _session->GetAccountName().c_str(), _session->GetAccountId(), comment.c_str());
+    uint8 const* expected = check->ResultBytes.size() == 20 ? check->ResultBytes.data() : NULL;
+    bool localeHash = false;
 
-    return result;
-}
\ No newline at end of file
+    for (std::vector<WardenMPQHash>::const_iterator itr = check->MPQHashes.begin(); itr != check->MPQHashes.end(); ++itr)
+    {
+        // allowed custom patches
+        if (itr->Locale == -1)
+        {
+            if (!memcmp(itr->Hash, hash, 20))
+            {
+                TC_LOG_DEBUG("warden","Account %s (id: %u) have custom MPQ patch (%s). Action: None", verification.AccountName.c_str(), verification.AccountId, itr->Comment.c_str());
+                return true;
+            }
+        }
+        // files of the other locales differ from the ruRU ones in Result
+        else if (!localeHash && clientLocale != LOCALE_ruRU && uint32(itr->Locale) == clientLocale)
+        {
+            expected = itr->Hash;
+            localeHash = true;
+        }
+    }
+
+    return expected && !memcmp(expected, hash, 20);
+}
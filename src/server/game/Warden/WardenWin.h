@@ -19,7 +19,9 @@
 #ifndef _WARDEN_WIN_H
 #define _WARDEN_WIN_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include "Cryptography/ARC4.h"
 #include "Cryptography/BigNumber.h"
 #include "ByteBuffer.h"
@@ -28,6 +30,30 @@
 class WorldSession;
 class Warden;
 
+enum WardenVerifyResult
+{
+    WARDEN_VERIFY_NONE    = 0,                              // truncated response or disabled check, nothing to do
+    WARDEN_VERIFY_PASSED  = 1,
+    WARDEN_VERIFY_KICK    = 2,                              // corrupted response or a check function the client didn't call
+    WARDEN_VERIFY_FAILED  = 3                               // FailedCheckId didn't match, its action applies
+};
+
+// a cheat checks response, copied from the session so the pool thread doesn't touch it
+struct WardenVerification
+{
+    WardenVerification() : State(WARDEN_NOT_INITIALIZED), AccountId(0), Done(false), Result(WARDEN_VERIFY_NONE), FailedCheckId(0) { }
+
+    ByteBuffer Data;
+    std::vector<uint16> Checks;
+    WardenState State;                                      // the request the response answers
+    uint32 AccountId;
+    std::string AccountName;
+
+    std::atomic<bool> Done;
+    WardenVerifyResult Result;
+    uint16 FailedCheckId;
+};
+
 class WardenWin : public Warden
 {
     public:
@@ -48,21 +74,25 @@ class WardenWin : public Warden
         void RequestBaseData();
 
         void HandleData(ByteBuffer &buff);
-        void HandleBaseChecksData(ByteBuffer &buff);
-        void HandleDbcChecksData(ByteBuffer &buff);
-        void CommonChecksHandler(ByteBuffer &buff);
         //void ExtendedChecksHandler(ByteBuffer &buff);
+        void ProcessVerifiedData();
+
+        // run on the thread pool
+        static void Verify(WardenVerification& verification);
+        static WardenVerifyResult VerifyBaseChecks(WardenVerification& verification);
+        static WardenVerifyResult VerifyDbcChecks(WardenVerification& verification);
+        static WardenVerifyResult VerifyCommonChecks(WardenVerification& verification);
+        static bool IsValidMPQHash(WardenCheck const* check, uint8 const* hash, uint32 clientLocale, WardenVerification const& verification);
 
         void BuildBaseChecksList(ByteBuffer &buff);
         void BuildMPQCHecksList(ByteBuffer &buff);
         uint16 BuildCheckData(WardenCheck* wd, ByteBuffer &buff, ByteBuffer &stringBuf, uint8 &index);
 
-        std::string GetCustomMPQData(std::string dbcName, std::string packet, uint32 clientLocale);
-
     private:
         uint32 _serverTicks;
         std::vector<uint16> _baseChecksList;
         std::vector<uint16> _currentChecks;
+        std::shared_ptr<WardenVerification> _verification;  // response being verified, kept by the pool task too
 };
 
 #endif
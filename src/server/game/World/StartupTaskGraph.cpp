@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupTaskGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "ThreadPoolMgr.hpp"
+#include "Timer.h"
+
+#include <algorithm>
+
+void StartupTaskGraph::AddTask(char const* name, TaskFunction function, std::initializer_list<char const*> dependencies)
+{
+    Task task;
+    task.Name = name;
+    task.Function = std::move(function);
+    task.PendingDependencies = 0;
+    task.StartTime = 0;
+    task.Duration = 0;
+
+    uint32 index = uint32(_tasks.size());
+    for (char const* dependency : dependencies)
+    {
+        std::vector<Task>::iterator itr = std::find_if(_tasks.begin(), _tasks.end(), [dependency](Task const& t) { return t.Name == dependency; });
+        if (itr == _tasks.end())
+        {
+            TC_LOG_ERROR("server", "Startup step '%s' of '%s' depends on unknown step '%s'", name, _name.c_str(), dependency);
+            ASSERT(false);
+        }
+
+        uint32 dependencyIndex = uint32(itr - _tasks.begin());
+        task.Dependencies.push_back(dependencyIndex);
+        itr->Dependents.push_back(index);
+        ++task.PendingDependencies;
+    }
+
+    _tasks.push_back(std::move(task));
+}
+
+void StartupTaskGraph::Run(bool parallel)
+{
+    _startTime = getMSTime();
+
+    if (parallel)
+    {
+        // the steps without dependencies start the graph, Execute() schedules the rest when they get ready.
+        // They are scheduled from inside the running steps, so the pool can't become idle before all are done.
+        // The roots are picked before any step runs, the counters drop while they are scheduled
+        std::vector<uint32> roots;
+        for (uint32 i = 0; i < _tasks.size(); ++i)
+            if (_tasks[i].Dependencies.empty())
+                roots.push_back(i);
+
+        for (uint32 root : roots)
+            Schedule(root);
+
+        sThreadPoolMgr->wait();
+    }
+    else
+    {
+        for (uint32 i = 0; i < _tasks.size(); ++i)
+            Execute(i);
+    }
+
+    LogTimings(GetMSTimeDiffToNow(_startTime));
+}
+
+void StartupTaskGraph::Schedule(uint32 index)
+{
+    sThreadPoolMgr->schedule([this, index]() { Execute(index); });
+}
+
+void StartupTaskGraph::Execute(uint32 index)
+{
+    Task& task = _tasks[index];
+    task.StartTime = GetMSTimeDiffToNow(_startTime);
+
+    uint32 oldMSTime = getMSTime();
+    task.Function();
+    task.Duration = GetMSTimeDiffToNow(oldMSTime);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    for (uint32 dependent : task.Dependents)
+        if (!--_tasks[dependent].PendingDependencies)
+            Schedule(dependent);
+}
+
+void StartupTaskGraph::LogTimings(uint32 totalTime) const
+{
+    if (_tasks.empty())
+        return;
+
+    // longest chain of durations ending at every step, the dependencies are always added first
+    std::vector<uint32> pathTime(_tasks.size(), 0);
+    std::vector<int32> pathPrev(_tasks.size(), -1);
+    uint32 last = 0;
+    for (uint32 i = 0; i < _tasks.size(); ++i)
+    {
+        for (uint32 dependency : _tasks[i].Dependencies)
+        {
+            if (pathTime[dependency] >= pathTime[i])
+            {
+                pathTime[i] = pathTime[dependency];
+                pathPrev[i] = int32(dependency);
+            }
+        }
+
+        pathTime[i] += _tasks[i].Duration;
+        if (pathTime[i] > pathTime[last])
+            last = i;
+
+        TC_LOG_DEBUG("server", "Startup step '%s' of '%s': started at %u ms, took %u ms", _tasks[i].Name.c_str(), _name.c_str(),
+            _tasks[i].StartTime, _tasks[i].Duration);
+    }
+
+    std::vector<uint32> criticalPath;
+    for (int32 i = int32(last); i >= 0; i = pathPrev[i])
+        criticalPath.push_back(uint32(i));
+
+    TC_LOG_INFO("server", ">> Loaded '%s' (%u steps) in %u ms, critical path %u ms:", _name.c_str(), uint32(_tasks.size()), totalTime, pathTime[last]);
+    for (std::vector<uint32>::const_reverse_iterator itr = criticalPath.rbegin(); itr != criticalPath.rend(); ++itr)
+        TC_LOG_INFO("server", ">>     %-28s %6u ms", _tasks[*itr].Name.c_str(), _tasks[*itr].Duration);
+}
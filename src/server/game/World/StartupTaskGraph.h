@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _STARTUP_TASK_GRAPH_H
+#define _STARTUP_TASK_GRAPH_H
+
+#include "Define.h"
+
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Loading steps of the world startup with the steps they must run after.
+ *
+ * Run(true) starts every step as soon as all its dependencies are done, on the
+ * sThreadPoolMgr threads, so independent loaders query the world database over
+ * several synch connections at once. Run(false) keeps the old behaviour and runs
+ * the steps one by one in the order they were added.
+ *
+ * Either way the time of every step and the critical path - the chain of
+ * dependent steps that bounds the parallel loading time - are logged afterwards.
+ */
+class StartupTaskGraph
+{
+    public:
+        typedef std::function<void()> TaskFunction;
+
+        explicit StartupTaskGraph(char const* name) : _name(name), _startTime(0) { }
+
+        // dependencies must be added before the step itself, so the graph can't have cycles
+        void AddTask(char const* name, TaskFunction function, std::initializer_list<char const*> dependencies = {});
+
+        void Run(bool parallel);
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            TaskFunction Function;
+            std::vector<uint32> Dependencies;
+            std::vector<uint32> Dependents;
+            uint32 PendingDependencies;
+            uint32 StartTime;           // milliseconds since Run()
+            uint32 Duration;
+        };
+
+        void Schedule(uint32 index);
+        void Execute(uint32 index);
+        void LogTimings(uint32 totalTime) const;
+
+        std::string _name;
+        std::vector<Task> _tasks;
+        std::mutex _lock;
+        uint32 _startTime;
+};
+
+#endif
@@ -77,6 +77,7 @@
 #include "WeatherMgr.h"
 #include "CreatureTextMgr.h"
 #include "SmartAI.h"
+#include "StartupTaskGraph.h"
 #include "Channel.h"
 #include "WardenMgr.h"
 #include "Warden.h"
@@ -87,6 +88,10 @@
 #include "ChallengeMgr.h"
 #include "ScenarioMgr.h"
 #include "ThreadPoolMgr.hpp"
+#include "Profiler.h"
+#include "BotMgr.h"
+#include "ReplayMgr.h"
+#include "MovementInterest.h"
 
 ACE_Atomic_Op<ACE_Thread_Mutex, bool> World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -144,6 +149,9 @@ World::World()
 
     m_zoneDiffTimer = 0;
 
+    for (uint8 i = 0; i < WUPDATE_COUNT; ++i)
+        m_timers[i] = 0;
+
     m_isClosed = false;
 
     m_CleaningFlags = 0;
@@ -267,6 +275,15 @@ void World::AddSession_(WorldSession* s)
         return;
     }
 
+    ///- the characters of a replayed account are in the world without a session in the list
+    if (sReplayMgr->IsReplayedAccount(s->GetAccountId()))
+    {
+        s->SendAuthResponse(AUTH_ALREADY_ONLINE);
+        s->KickPlayer();
+        delete s;
+        return;
+    }
+
     // decrease session counts only at not reconnection case
     bool decrease_session = true;
 
@@ -1031,10 +1048,7 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_UPTIME_UPDATE] = 10;
     }
     if (reload)
-    {
-        m_timers[WUPDATE_UPTIME].SetInterval(m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE*IN_MILLISECONDS);
-        m_timers[WUPDATE_UPTIME].Reset();
-    }
+        m_scheduler.SetInterval(m_timers[WUPDATE_UPTIME], m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE*IN_MILLISECONDS);
 
     // log db cleanup interval
     m_int_configs[CONFIG_LOGDB_CLEARINTERVAL] = ConfigMgr::GetIntDefault("LogDB.Opt.ClearInterval", 10);
@@ -1044,10 +1058,7 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_LOGDB_CLEARINTERVAL] = 10;
     }
     if (reload)
-    {
-        m_timers[WUPDATE_CLEANDB].SetInterval(m_int_configs[CONFIG_LOGDB_CLEARINTERVAL] * MINUTE * IN_MILLISECONDS);
-        m_timers[WUPDATE_CLEANDB].Reset();
-    }
+        m_scheduler.SetInterval(m_timers[WUPDATE_CLEANDB], m_int_configs[CONFIG_LOGDB_CLEARINTERVAL] * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_LOGDB_CLEARTIME] = ConfigMgr::GetIntDefault("LogDB.Opt.ClearTime", 1209600); // 14 days default
     TC_LOG_INFO("server", "Will clear `logs` table of entries older than %i seconds every %u minutes.",
         m_int_configs[CONFIG_LOGDB_CLEARTIME], m_int_configs[CONFIG_LOGDB_CLEARINTERVAL]);
@@ -1098,6 +1109,36 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_IPSET_ENABLE]             = ConfigMgr::GetBoolDefault("Ipset.Enable", false);
 
     m_int_configs[CONFIG_EVENT_ANNOUNCE] = ConfigMgr::GetIntDefault("Event.Announce", 0);
+    m_int_configs[CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE] = ConfigMgr::GetIntDefault("Event.SpawnsPerMapUpdate", 200);
+    if (!m_int_configs[CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE])
+    {
+        TC_LOG_ERROR("server", "Event.SpawnsPerMapUpdate (0) must be > 0. Using 200 instead.");
+        m_int_configs[CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE] = 200;
+    }
+
+    m_bool_configs[CONFIG_PROFILER_ENABLE] = ConfigMgr::GetBoolDefault("Profiler.Enable", false);
+    m_int_configs[CONFIG_PROFILER_EXPORT_INTERVAL] = ConfigMgr::GetIntDefault("Profiler.ExportInterval", 300);
+    m_int_configs[CONFIG_PROFILER_SPIKE_THRESHOLD] = ConfigMgr::GetIntDefault("Profiler.SpikeThreshold", 500);
+    sProfiler->SetSpikeThreshold(m_int_configs[CONFIG_PROFILER_SPIKE_THRESHOLD]);
+    if (reload)
+        m_scheduler.SetInterval(m_timers[WUPDATE_PROFILER], std::max<uint32>(m_int_configs[CONFIG_PROFILER_EXPORT_INTERVAL], 1) * IN_MILLISECONDS);
+    else if (m_bool_configs[CONFIG_PROFILER_ENABLE])
+        sProfiler->Start();
+
+    m_int_configs[CONFIG_BOTS_BENCHMARK_COUNT] = ConfigMgr::GetIntDefault("Bots.Benchmark.Count", 0);
+    m_int_configs[CONFIG_BOTS_BENCHMARK_DURATION] = ConfigMgr::GetIntDefault("Bots.Benchmark.Duration", 300);
+
+    m_bool_configs[CONFIG_MOVEMENT_INTEREST_ENABLE] = ConfigMgr::GetBoolDefault("Movement.Interest.Enable", true);
+    m_float_configs[CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE] = ConfigMgr::GetFloatDefault("Movement.Interest.NearDistance", 35.0f);
+    m_float_configs[CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE] = ConfigMgr::GetFloatDefault("Movement.Interest.FarDistance", 70.0f);
+    if (m_float_configs[CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE] < m_float_configs[CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE])
+    {
+        TC_LOG_ERROR("server", "Movement.Interest.FarDistance (%f) must be >= Movement.Interest.NearDistance (%f). Using %f instead.",
+            m_float_configs[CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE], m_float_configs[CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE], m_float_configs[CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE]);
+        m_float_configs[CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE] = m_float_configs[CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE];
+    }
+    m_int_configs[CONFIG_MOVEMENT_INTEREST_MID_INTERVAL] = ConfigMgr::GetIntDefault("Movement.Interest.MidInterval", 500);
+    m_int_configs[CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL] = ConfigMgr::GetIntDefault("Movement.Interest.FarInterval", 1000);
 
     m_float_configs[CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS] = ConfigMgr::GetFloatDefault("CreatureFamilyFleeAssistanceRadius", 30.0f);
     m_float_configs[CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS] = ConfigMgr::GetFloatDefault("CreatureFamilyAssistanceRadius", 10.0f);
@@ -1386,10 +1427,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_AUTOBROADCAST_INTERVAL] = ConfigMgr::GetIntDefault("AutoBroadcast.Timer", 60000);
 
     if (reload)
-    {
-        m_timers[WUPDATE_AUTOBROADCAST].SetInterval(m_int_configs[CONFIG_AUTOBROADCAST_INTERVAL]);
-        m_timers[WUPDATE_AUTOBROADCAST].Reset();
-    }
+        m_scheduler.SetInterval(m_timers[WUPDATE_AUTOBROADCAST], m_int_configs[CONFIG_AUTOBROADCAST_INTERVAL]);
 
     // MySQL ping time interval
     m_int_configs[CONFIG_DB_PING_INTERVAL] = ConfigMgr::GetIntDefault("MaxPingTime", 30);
@@ -1460,6 +1498,9 @@ void World::LoadConfigSettings(bool reload)
     // only for debugging
     m_bool_configs[CONFIG_FASTER_LOADING] = ConfigMgr::GetBoolDefault("FasterLoading.Enabled", false);
 
+    // Run independent loaders of the startup at the same time on the MapUpdate.Threads pool
+    m_bool_configs[CONFIG_PARALLEL_LOADING] = ConfigMgr::GetBoolDefault("ParallelLoading.Enabled", false);
+
     //m_bool_configs[CONFIG_ENABLE_FLYING_CHECK] = ConfigMgr::GetBoolDefault("MovementSync.FlyingCheckEnabled", false);
     //m_bool_configs[CONFIG_ENABLE_WATERWALK_CHECK] = ConfigMgr::GetBoolDefault("MovementSync.WaterwalkCheckEnabled", false);
     //m_bool_configs[CONFIG_ENABLE_HOVER_CHECK] = ConfigMgr::GetBoolDefault("MovementSync.HoverCheckEnabled", false);
@@ -1586,207 +1627,309 @@ void World::SetInitialWorldSettings()
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapIds);
 
-    TC_LOG_INFO("server", "Loading SpellInfo store...");
-    sSpellMgr->LoadSpellInfoStore();
+    bool const parallelLoading = getBoolConfig(CONFIG_PARALLEL_LOADING) && getIntConfig(CONFIG_NUMTHREADS) > 1;
+    bool const fasterLoading = getBoolConfig(CONFIG_FASTER_LOADING);
 
-    TC_LOG_INFO("server", "Loading TalentSpellInfo store....");
-    sSpellMgr->LoadTalentSpellInfo();
+    ///- Templates and spawns, every step lists the steps whose data it reads
+    StartupTaskGraph worldData("world data");
 
-    TC_LOG_INFO("server", "Loading SpellPowerInfo store....");
-    sSpellMgr->LoadSpellPowerInfo();
+    worldData.AddTask("SpellInfo", []()
+    {
+        TC_LOG_INFO("server", "Loading SpellInfo store...");
+        sSpellMgr->LoadSpellInfoStore();
 
-    TC_LOG_INFO("server", "Loading SkillLineAbilityMultiMap Data...");
-    sSpellMgr->LoadSkillLineAbilityMap();
+        TC_LOG_INFO("server", "Loading TalentSpellInfo store....");
+        sSpellMgr->LoadTalentSpellInfo();
 
-    TC_LOG_INFO("server", "Loading spell custom attributes...");
-    sSpellMgr->LoadSpellCustomAttr();
+        TC_LOG_INFO("server", "Loading SpellPowerInfo store....");
+        sSpellMgr->LoadSpellPowerInfo();
 
-    TC_LOG_INFO("server", "Loading GameObject models...");
-    LoadGameObjectModelList(m_dataPath);
+        TC_LOG_INFO("server", "Loading SkillLineAbilityMultiMap Data...");
+        sSpellMgr->LoadSkillLineAbilityMap();
 
-    TC_LOG_INFO("server", "Loading World Visible Distance...");
-    sObjectMgr->LoadWorldVisibleDistance();
+        TC_LOG_INFO("server", "Loading spell custom attributes...");
+        sSpellMgr->LoadSpellCustomAttr();
+    });
 
-    TC_LOG_INFO("server", "Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
+    worldData.AddTask("GameObjectModels", [this]()
+    {
+        TC_LOG_INFO("server", "Loading GameObject models...");
+        LoadGameObjectModelList(m_dataPath);
+    });
 
-    TC_LOG_INFO("server", "Loading Instance Template...");
-    sObjectMgr->LoadInstanceTemplate();
+    worldData.AddTask("WorldVisibleDistance", []()
+    {
+        TC_LOG_INFO("server", "Loading World Visible Distance...");
+        sObjectMgr->LoadWorldVisibleDistance();
+    });
 
-    // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    TC_LOG_INFO("server", "Loading instances...");
-    sInstanceSaveMgr->LoadInstances();
+    worldData.AddTask("ScriptNames", []()
+    {
+        TC_LOG_INFO("server", "Loading Script Names...");
+        sObjectMgr->LoadScriptNames();
+    });
 
-    TC_LOG_INFO("server", "Restructuring Creatures GUIDs...");
-    //sObjectMgr->RestructCreatureGUID(10000);
+    worldData.AddTask("Instances", []()
+    {
+        TC_LOG_INFO("server", "Loading Instance Template...");
+        sObjectMgr->LoadInstanceTemplate();
 
-    TC_LOG_INFO("server", "Restructuring Gameobjects GUIDs...");
-    //sObjectMgr->RestructGameObjectGUID(10000);
+        // Must be called before `creature_respawn`/`gameobject_respawn` tables
+        TC_LOG_INFO("server", "Loading instances...");
+        sInstanceSaveMgr->LoadInstances();
+    }, { "ScriptNames" });
 
-    TC_LOG_INFO("server", "Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    
-    if (!getBoolConfig(CONFIG_FASTER_LOADING))
+    worldData.AddTask("Locales", [fasterLoading]()
     {
-        sObjectMgr->LoadCreatureLocales();
-        sObjectMgr->LoadGameObjectLocales();
-        sObjectMgr->LoadItemLocales();
-        sObjectMgr->LoadQuestLocales();
-        sObjectMgr->LoadNpcTextLocales();
-        sObjectMgr->LoadPageTextLocales();
-        sObjectMgr->LoadGossipMenuItemsLocales();
-        sObjectMgr->LoadPointOfInterestLocales();
-    }
+        TC_LOG_INFO("server", "Loading Localization strings...");
+        uint32 oldMSTime = getMSTime();
 
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    TC_LOG_INFO("server", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+        if (!fasterLoading)
+        {
+            sObjectMgr->LoadCreatureLocales();
+            sObjectMgr->LoadGameObjectLocales();
+            sObjectMgr->LoadItemLocales();
+            sObjectMgr->LoadQuestLocales();
+            sObjectMgr->LoadNpcTextLocales();
+            sObjectMgr->LoadPageTextLocales();
+            sObjectMgr->LoadGossipMenuItemsLocales();
+            sObjectMgr->LoadPointOfInterestLocales();
+        }
 
-    TC_LOG_INFO("server","Loading Letter Analogs...");
-    sWordFilterMgr->LoadLetterAnalogs();
+        TC_LOG_INFO("server", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    });
 
-    TC_LOG_INFO("server","Loading Bad Words...");
-    sWordFilterMgr->LoadBadWords();
+    worldData.AddTask("WordFilter", []()
+    {
+        TC_LOG_INFO("server","Loading Letter Analogs...");
+        sWordFilterMgr->LoadLetterAnalogs();
+
+        TC_LOG_INFO("server","Loading Bad Words...");
+        sWordFilterMgr->LoadBadWords();
+    });
 
-    if (!getBoolConfig(CONFIG_FASTER_LOADING))
+    worldData.AddTask("PageTexts", [fasterLoading]()
     {
-        TC_LOG_INFO("server", "Loading Page Texts...");
-        sObjectMgr->LoadPageTexts();
-    }
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Page Texts...");
+            sObjectMgr->LoadPageTexts();
+        }
+    });
 
-    TC_LOG_INFO("server", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    worldData.AddTask("GameObjectTemplates", []()
+    {
+        TC_LOG_INFO("server", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    }, { "PageTexts", "ScriptNames", "SpellInfo" });
 
-    TC_LOG_INFO("server", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
+    worldData.AddTask("SpellData", []()
+    {
+        TC_LOG_INFO("server", "Loading Spell Rank Data...");
+        sSpellMgr->LoadSpellRanks();
 
-    TC_LOG_INFO("server", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+        TC_LOG_INFO("server", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
 
-    TC_LOG_INFO("server", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+        TC_LOG_INFO("server", "Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
 
-    TC_LOG_INFO("server", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+        TC_LOG_INFO("server", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
 
-    TC_LOG_INFO("server", "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
+        TC_LOG_INFO("server", "Loading Spell Learn Spells...");
+        sSpellMgr->LoadSpellLearnSpells();
 
-    TC_LOG_INFO("server", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+        TC_LOG_INFO("server", "Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
 
-    TC_LOG_INFO("server", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+        TC_LOG_INFO("server", "Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
 
-    TC_LOG_INFO("server", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+        TC_LOG_INFO("server", "Loading Spell Bonus Data...");
+        sSpellMgr->LoadSpellBonusess();
 
-    TC_LOG_INFO("server", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+        TC_LOG_INFO("server", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
 
-    TC_LOG_INFO("server", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+        TC_LOG_INFO("server", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
 
-    TC_LOG_INFO("server", "Loading forbidden spells...");
-    sSpellMgr->LoadForbiddenSpells();
+        TC_LOG_INFO("server", "Loading forbidden spells...");
+        sSpellMgr->LoadForbiddenSpells();
 
-    TC_LOG_INFO("server", "Loading Spell Phase Dbc Info...");
-    sObjectMgr->LoadSpellPhaseInfo();
+        TC_LOG_INFO("server", "Loading Spell Phase Dbc Info...");
+        sObjectMgr->LoadSpellPhaseInfo();
 
-    TC_LOG_INFO("server", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+        TC_LOG_INFO("server", "Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    }, { "SpellInfo" });
 
-    TC_LOG_INFO("server", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    worldData.AddTask("GossipText", []()
+    {
+        TC_LOG_INFO("server", "Loading NPC Texts...");
+        sObjectMgr->LoadGossipText();
+    });
 
-    TC_LOG_INFO("server", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    worldData.AddTask("RandomEnchantments", []()
+    {
+        TC_LOG_INFO("server", "Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    TC_LOG_INFO("server", "Loading Disables");
-    DisableMgr::LoadDisables();                                 // must be before loading quests and items
+    worldData.AddTask("Disables", []()
+    {
+        TC_LOG_INFO("server", "Loading Disables");
+        DisableMgr::LoadDisables();                                 // must be before loading quests and items
+    }, { "SpellInfo" });
 
-    TC_LOG_INFO("server", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
+    worldData.AddTask("Items", [fasterLoading]()
+    {
+        TC_LOG_INFO("server", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+        sObjectMgr->LoadItemTemplates();
 
-    if (!getBoolConfig(CONFIG_FASTER_LOADING))
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Item set names...");                // must be after LoadItemPrototypes
+            sObjectMgr->LoadItemTemplateAddon();
+        }
+
+        TC_LOG_INFO("server", "Loading Item Scripts...");                 // must be after LoadItemPrototypes
+        sObjectMgr->LoadItemScriptNames();
+    }, { "RandomEnchantments", "PageTexts", "Disables", "ScriptNames" });
+
+    worldData.AddTask("CreatureTemplates", [fasterLoading]()
     {
-        TC_LOG_INFO("server", "Loading Item set names...");                // must be after LoadItemPrototypes
-        sObjectMgr->LoadItemTemplateAddon();
-    }
+        TC_LOG_INFO("server", "Loading Creature Model Based Info Data...");
+        sObjectMgr->LoadCreatureModelInfo();
 
-    TC_LOG_INFO("server", "Loading Item Scripts...");                 // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemScriptNames();
+        TC_LOG_INFO("server", "Loading Equipment templates...");
+        sObjectMgr->LoadEquipmentTemplates();
 
-    TC_LOG_INFO("server", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
+        TC_LOG_INFO("server", "Loading Creature templates...");
+        sObjectMgr->LoadCreatureTemplates();
 
-    TC_LOG_INFO("server", "Loading Equipment templates...");
-    sObjectMgr->LoadEquipmentTemplates();
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Creature template addons...");
+            sObjectMgr->LoadCreatureTemplateAddons();
+        }
 
-    TC_LOG_INFO("server", "Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
+        TC_LOG_INFO("server", "Loading Creature difficulty stat...");
+        sObjectMgr->LoadCreatureDifficultyStat();
+    }, { "Items", "SpellData", "ScriptNames" });
 
-    if (!getBoolConfig(CONFIG_FASTER_LOADING))
+    worldData.AddTask("Reputation", []()
     {
-        TC_LOG_INFO("server", "Loading Creature template addons...");
-        sObjectMgr->LoadCreatureTemplateAddons();
-    }
+        TC_LOG_INFO("server", "Loading Reputation Reward Rates...");
+        sObjectMgr->LoadReputationRewardRate();
 
-    TC_LOG_INFO("server", "Loading Creature difficulty stat...");
-    sObjectMgr->LoadCreatureDifficultyStat();
+        TC_LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
+        sObjectMgr->LoadReputationOnKill();
 
-    TC_LOG_INFO("server", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
+        TC_LOG_INFO("server", "Loading Reputation Spillover Data...");
+        sObjectMgr->LoadReputationSpilloverTemplate();
+    }, { "CreatureTemplates" });
 
-    TC_LOG_INFO("server", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
+    worldData.AddTask("PointsOfInterest", []()
+    {
+        TC_LOG_INFO("server", "Loading Points Of Interest Data...");
+        sObjectMgr->LoadPointsOfInterest();
+    });
 
-    TC_LOG_INFO("server", "Loading Reputation Spillover Data...");
-    sObjectMgr->LoadReputationSpilloverTemplate();
+    worldData.AddTask("CreatureBaseStats", []()
+    {
+        TC_LOG_INFO("server", "Loading Creature Base Stats...");
+        sObjectMgr->LoadCreatureClassLevelStats();
+    });
 
-    TC_LOG_INFO("server", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
+    worldData.AddTask("Creatures", [fasterLoading]()
+    {
+        TC_LOG_INFO("server", "Loading Creature Data...");
+        sObjectMgr->LoadCreatures();
 
-    TC_LOG_INFO("server", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Creature Addon Data...");
+            sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+        }
+    }, { "CreatureTemplates", "CreatureBaseStats" });
 
-    TC_LOG_INFO("server", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
+    worldData.AddTask("PetSpells", []()
+    {
+        TC_LOG_INFO("server", "Loading pet levelup spells...");
+        sSpellMgr->LoadPetLevelupSpellMap();
 
-    TC_LOG_INFO("server", "Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
+        TC_LOG_INFO("server", "Loading pet default spells additional to levelup spells...");
+        sSpellMgr->LoadPetDefaultSpells();
+    }, { "SpellData", "CreatureTemplates" });
 
-    TC_LOG_INFO("server", "Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
+    worldData.AddTask("Treasures", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Treasure Data...");
+            sObjectMgr->LoadPersonalLootTemplate();
+        }
+    }, { "SpellInfo" });
 
-    if (!getBoolConfig(CONFIG_FASTER_LOADING))
+    // after the creatures: both create the base maps of their spawns through GetZoneAndAreaId,
+    // and the map manager only guards the creation, not the lookups of the other loader
+    worldData.AddTask("Gameobjects", [fasterLoading]()
     {
-        TC_LOG_INFO("server", "Loading Creature Addon Data...");
-        sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Gameobject Data...");
+            sObjectMgr->LoadGameobjects();
+        }
+    }, { "GameObjectTemplates", "Creatures" });
 
-        TC_LOG_INFO("server", "Loading Treasure Data...");
-        sObjectMgr->LoadPersonalLootTemplate();
+    worldData.AddTask("LinkedRespawn", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Creature Linked Respawn...");
+            sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+        }
+    }, { "Creatures", "Gameobjects" });
 
-        TC_LOG_INFO("server", "Loading Gameobject Data...");
-        sObjectMgr->LoadGameobjects();
+    worldData.AddTask("Weather", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Weather Data...");
+            WeatherMgr::LoadWeatherData();
+        }
+    });
 
-        TC_LOG_INFO("server", "Loading Creature Linked Respawn...");
-        sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
+    worldData.AddTask("Quests", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Quests...");
+            sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
 
-        TC_LOG_INFO("server", "Loading Weather Data...");
-        WeatherMgr::LoadWeatherData();
+            TC_LOG_INFO("server", "Checking Quest Disables");
+            DisableMgr::CheckQuestDisables();                           // must be after loading quests
 
-        TC_LOG_INFO("server", "Loading Quests...");
-        sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+            TC_LOG_INFO("server", "Loading Quest POI");
+            sObjectMgr->LoadQuestPOI();
 
-        TC_LOG_INFO("server", "Checking Quest Disables");
-        DisableMgr::CheckQuestDisables();                           // must be after loading quests
+            TC_LOG_INFO("server", "Loading Quests Relations...");
+            sObjectMgr->LoadQuestRelations();                            // must be after quest load
+        }
+    }, { "Items", "CreatureTemplates", "GameObjectTemplates", "Disables", "SpellData" });
 
-        TC_LOG_INFO("server", "Loading Quest POI");
-        sObjectMgr->LoadQuestPOI();
+    worldData.Run(parallelLoading);
+    sObjectMgr->LogCellObjectGuidsMemory();
 
-        TC_LOG_INFO("server", "Loading Quests Relations...");
-        sObjectMgr->LoadQuestRelations();                            // must be after quest load
-    }
+    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
+
+    TC_LOG_INFO("server", "Restructuring Creatures GUIDs...");
+    //sObjectMgr->RestructCreatureGUID(10000);
+
+    TC_LOG_INFO("server", "Restructuring Gameobjects GUIDs...");
+    //sObjectMgr->RestructGameObjectGUID(10000);
 
     TC_LOG_INFO("server", "Loading Scenario POI");
     sObjectMgr->LoadScenarioPOI();
@@ -1884,39 +2027,72 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server", "Loading pet level stats...");
     sObjectMgr->LoadPetStats();
 
-    if (!getBoolConfig(CONFIG_FASTER_LOADING)) 
+    ///- Loot, skill and achievement tables, read the templates and quests loaded above
+    StartupTaskGraph rewardData("reward data");
+
+    rewardData.AddTask("Corpses", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Player Corpses...");
+            sObjectMgr->LoadCorpses();
+        }
+    });
+
+    rewardData.AddTask("MailLevelRewards", [fasterLoading]()
     {
-        TC_LOG_INFO("server", "Loading Player Corpses...");
-        sObjectMgr->LoadCorpses();
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Player level dependent mail rewards...");
+            sObjectMgr->LoadMailLevelRewards();
+        }
+    });
+
+    rewardData.AddTask("LootTables", [fasterLoading]()
+    {
+        if (!fasterLoading && !LoadLootTables())
+        {
+            TC_LOG_ERROR("server", ">> Loot tables could not be read completely, aborting.");
+            exit(1);
+        }
+    });
 
-        TC_LOG_INFO("server", "Loading Player level dependent mail rewards...");
-        sObjectMgr->LoadMailLevelRewards();
+    rewardData.AddTask("SkillTables", [fasterLoading]()
+    {
+        if (!fasterLoading)
+        {
+            TC_LOG_INFO("server", "Loading Skill Discovery Table...");
+            LoadSkillDiscoveryTable();
 
-        // Loot tables
-        LoadLootTables();
+            TC_LOG_INFO("server", "Loading Skill Extra Item Table...");
+            LoadSkillExtraItemTable();
 
-        TC_LOG_INFO("server", "Loading Skill Discovery Table...");
-        LoadSkillDiscoveryTable();
+            TC_LOG_INFO("server", "Loading Skill Fishing base level requirements...");
+            sObjectMgr->LoadFishingBaseSkillLevel();
+        }
+    });
 
-        TC_LOG_INFO("server", "Loading Skill Extra Item Table...");
-        LoadSkillExtraItemTable();
+    rewardData.AddTask("Achievements", []()
+    {
+        TC_LOG_INFO("server", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+        TC_LOG_INFO("server", "Loading Criteria Lists...");
+        sAchievementMgr->LoadCriteriaList();
+        TC_LOG_INFO("server", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        TC_LOG_INFO("server", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        TC_LOG_INFO("server", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+    });
 
-        TC_LOG_INFO("server", "Loading Skill Fishing base level requirements...");
-        sObjectMgr->LoadFishingBaseSkillLevel();
-    }
+    rewardData.AddTask("CompletedAchievements", []()
+    {
+        TC_LOG_INFO("server", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    }, { "Achievements" });
 
-    TC_LOG_INFO("server", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server", "Loading Criteria Lists...");
-    sAchievementMgr->LoadCriteriaList();
-    TC_LOG_INFO("server", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    rewardData.Run(parallelLoading);
 
     // Delete expired auctions before loading
     TC_LOG_INFO("server", "Deleting expired auctions...");
@@ -2072,28 +2248,42 @@ void World::SetInitialWorldSettings()
     LoginDatabase.PExecute("INSERT INTO uptime (realmid, starttime, uptime, revision) VALUES(%u, %u, 0, '%s')",
                             realmID, uint32(m_startTime), GitRevision::GetFullVersion());       // One-time query
 
-    m_timers[WUPDATE_WEATHERS].SetInterval(1*IN_MILLISECONDS);
-    m_timers[WUPDATE_AUCTIONS].SetInterval(MINUTE*IN_MILLISECONDS);
-    m_timers[WUPDATE_UPTIME].SetInterval(m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE*IN_MILLISECONDS);
+    ScheduleWorldTimer(WUPDATE_WEATHERS, "weathers", 1*IN_MILLISECONDS, []() { WeatherMgr::Update(1*IN_MILLISECONDS); });
+    ScheduleWorldTimer(WUPDATE_AUCTIONS, "auctions", MINUTE*IN_MILLISECONDS, [this]() { UpdateAuctions(); });
+    ScheduleWorldTimer(WUPDATE_UPTIME, "uptime", m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE*IN_MILLISECONDS, [this]() { UpdateUptime(); });
                                                             //Update "uptime" table based on configuration entry in minutes.
-    m_timers[WUPDATE_CORPSES].SetInterval(20 * MINUTE * IN_MILLISECONDS);
+    ScheduleWorldTimer(WUPDATE_CORPSES, "corpses", 20 * MINUTE * IN_MILLISECONDS, []() { sObjectAccessor->RemoveOldCorpses(); });
                                                             //erase corpses every 20 minutes
-    m_timers[WUPDATE_CLEANDB].SetInterval(m_int_configs[CONFIG_LOGDB_CLEARINTERVAL]*MINUTE*IN_MILLISECONDS);
+    ScheduleWorldTimer(WUPDATE_CLEANDB, "clean logs", m_int_configs[CONFIG_LOGDB_CLEARINTERVAL]*MINUTE*IN_MILLISECONDS, [this]() { CleanOldLogs(); });
                                                             // clean logs table every 14 days by default
-    m_timers[WUPDATE_AUTOBROADCAST].SetInterval(getIntConfig(CONFIG_AUTOBROADCAST_INTERVAL));
-    m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
+    ScheduleWorldTimer(WUPDATE_AUTOBROADCAST, "autobroadcast", getIntConfig(CONFIG_AUTOBROADCAST_INTERVAL), [this]()
+    {
+        if (getBoolConfig(CONFIG_AUTOBROADCAST))
+            SendAutoBroadcast();
+    });
+    ScheduleWorldTimer(WUPDATE_DELETECHARS, "delete characters", DAY*IN_MILLISECONDS, []() { Player::DeleteOldCharacters(); }); // check for chars to delete every day
 
-    m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
+    ScheduleWorldTimer(WUPDATE_PINGDB, "ping databases", getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS, [this]() { PingDatabases(); });    // Mysql ping time in minutes
 
-    m_timers[WUPDATE_GUILDSAVE].SetInterval(getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS);
+    ScheduleWorldTimer(WUPDATE_GUILDSAVE, "guild save", getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS, []() { sGuildMgr->SaveGuilds(); });
+
+    // folded stacks of the scoped timers for flamegraphs, see Profiler.h
+    ScheduleWorldTimer(WUPDATE_PROFILER, "profiler export", std::max<uint32>(getIntConfig(CONFIG_PROFILER_EXPORT_INTERVAL), 1) * IN_MILLISECONDS, [this]()
+    {
+        if (Profiler::IsEnabled() && getIntConfig(CONFIG_PROFILER_EXPORT_INTERVAL))
+            sProfiler->Export();
+    });
+
+    // relays saved per second by the movement interest bands, see MovementInterest.h
+    ScheduleWorldTimer(WUPDATE_MOVEMENT_INTEREST, "movement interest rates", MOVEMENT_INTEREST_RATE_INTERVAL, []() { sMovementInterestMgr->UpdateRates(MOVEMENT_INTEREST_RATE_INTERVAL); });
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
     //one second is 1000 -(tested on win system)
     //TODO: Get rid of magic numbers
-    mail_timer = ((((localtime(&m_gameTime)->tm_hour + 20) % 24)* HOUR * IN_MILLISECONDS) / m_timers[WUPDATE_AUCTIONS].GetInterval());
+    mail_timer = ((((localtime(&m_gameTime)->tm_hour + 20) % 24)* HOUR * IN_MILLISECONDS) / (MINUTE*IN_MILLISECONDS));
                                                             //1440
-    mail_timer_expires = ((DAY * IN_MILLISECONDS) / (m_timers[WUPDATE_AUCTIONS].GetInterval()));
+    mail_timer_expires = ((DAY * IN_MILLISECONDS) / (MINUTE*IN_MILLISECONDS));
     TC_LOG_INFO("server", "Mail timer set to: " UI64FMTD ", mail return is called every " UI64FMTD " minutes", uint64(mail_timer), uint64(mail_timer_expires));
 
     ///- Initilize static helper structures
@@ -2105,7 +2295,10 @@ void World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server", "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
-    m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
+    ScheduleWorldTimer(WUPDATE_EVENTS, "game events", nextGameEvent, [this]()    //depend on next event
+    {
+        m_scheduler.SetInterval(m_timers[WUPDATE_EVENTS], sGameEventMgr->Update());
+    });
 
     // Delete all characters which have been deleted X days before
     Player::DeleteOldCharacters();
@@ -2119,7 +2312,12 @@ void World::SetInitialWorldSettings()
     sTicketMgr->Initialize();
 
     TC_LOG_INFO("server","Initializing Mailbox queue system...");
-    m_timers[WUPDATE_MAILBOXQUEUE].SetInterval( 2 * MINUTE * 1000 );
+    ScheduleWorldTimer(WUPDATE_MAILBOXQUEUE, "mailbox queue", 2 * MINUTE * IN_MILLISECONDS, [this]()
+    {
+        ProcessMailboxQueue();
+        Transfer();
+        GetPoolGuids();
+    });
 
     ///- Initialize Battlegrounds
     TC_LOG_INFO("server", "Starting Battleground System");
@@ -2203,6 +2401,18 @@ void World::SetInitialWorldSettings()
         m_zonesDiff[i][2] = m_int_configs[CONFIG_MAX_POSSIBLE_VISIBILITY_RANGE];
     }
 
+    if (m_int_configs[CONFIG_BOTS_BENCHMARK_COUNT])
+    {
+        TC_LOG_INFO("server", "Starting bot benchmark...");
+        sBotMgr->StartBenchmark();
+    }
+
+    if (!ConfigMgr::GetStringDefault("Replay.File", "").empty())
+    {
+        TC_LOG_INFO("server", "Starting packet replay...");
+        sReplayMgr->StartAtStartup();
+    }
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     TC_LOG_INFO("server", "World initialized in %u minutes %u seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
@@ -2350,15 +2560,6 @@ void World::Update(uint32 diff)
         m_zoneDiffTimer = 0;
     }
 
-    ///- Update the different timers
-    for (int i = 0; i < WUPDATE_COUNT; ++i)
-    {
-        if (m_timers[i].GetCurrent() >= 0)
-            m_timers[i].Update(diff);
-        else
-            m_timers[i].SetCurrent(0);
-    }
-
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
 
@@ -2397,71 +2598,23 @@ void World::Update(uint32 diff)
     if (m_gameTime > m_NextServerRestart)
         AutoRestartServer();
 
-    /// <ul><li> Handle auctions when the timer has passed
-    if (m_timers[WUPDATE_AUCTIONS].Passed())
-    {
-        m_timers[WUPDATE_AUCTIONS].Reset();
-
-        ///- Update mails (return old mails with item, or delete them)
-        //(tested... works on win)
-        if (++mail_timer > mail_timer_expires)
-        {
-            mail_timer = 0;
-            sObjectMgr->ReturnOrDeleteOldMails(true);
-        }
-
-        ///- Handle expired auctions
-        sAuctionMgr->Update();
-    }
+    /// <ul><li> Run the periodic work and the manager deadlines that are due (auctions, weathers, uptime, game events, instance resets, ...)
+    RecordTimeDiff(NULL);
+    sInstanceSaveMgr->UpdateResetWakeup();
+    m_scheduler.Update(diff);
+    RecordTimeDiff("UpdateScheduler");
 
     /// <li> Handle session updates when the timer has passed
     RecordTimeDiff(NULL);
     UpdateSessions(diff);
     RecordTimeDiff("UpdateSessions");
 
-    /// <li> Handle weather updates when the timer has passed
-    if (m_timers[WUPDATE_WEATHERS].Passed())
-    {
-        m_timers[WUPDATE_WEATHERS].Reset();
-        WeatherMgr::Update(uint32(m_timers[WUPDATE_WEATHERS].GetInterval()));
-    }
-
-    /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
-    {
-        uint32 tmpDiff = uint32(m_gameTime - m_startTime);
-        uint32 maxOnlinePlayers = GetMaxPlayerCount();
-
-        m_timers[WUPDATE_UPTIME].Reset();
-
-        PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
-
-        stmt->setUInt32(0, tmpDiff);
-        stmt->setUInt16(1, uint16(maxOnlinePlayers));
-        stmt->setUInt32(2, realmID);
-        stmt->setUInt32(3, uint32(m_startTime));
+    /// <li> Let the load generator bots act, their packets are handled with the other ones of their map
+    sBotMgr->Update(diff);
+    RecordTimeDiff("UpdateBots");
 
-        LoginDatabase.Execute(stmt);
-
-        if (!m_bool_configs[CONFIG_DISABLE_NEW_ONLINE])
-            LoginDatabase.PQuery("REPLACE INTO `online` (`realmID`, `online`, `diff`, `uptime`) VALUES ('%u', '%u', '%u', '%u')", realmID, GetActiveSessionCount(), GetUpdateTime(), GetUptime());
-    }
-
-    /// <li> Clean logs table
-    if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
-    {
-        if (m_timers[WUPDATE_CLEANDB].Passed())
-        {
-            m_timers[WUPDATE_CLEANDB].Reset();
-
-            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
-
-            stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
-            stmt->setUInt32(1, uint32(time(0)));
-
-            LoginDatabase.Execute(stmt);
-        }
-    }
+    sReplayMgr->Update(diff);
+    RecordTimeDiff("UpdateReplay");
 
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
@@ -2469,15 +2622,6 @@ void World::Update(uint32 diff)
     sMapMgr->Update(diff);
     RecordTimeDiff("UpdateMapMgr");
 
-    if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
-    {
-        if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
-        {
-            m_timers[WUPDATE_AUTOBROADCAST].Reset();
-            SendAutoBroadcast();
-        }
-    }
-
     sBattlegroundMgr->Update(diff);
     RecordTimeDiff("UpdateBattlegroundMgr");
 
@@ -2487,13 +2631,6 @@ void World::Update(uint32 diff)
     sBattlefieldMgr->Update(diff);
     RecordTimeDiff("BattlefieldMgr");
 
-    ///- Delete all characters which have been deleted X days before
-    if (m_timers[WUPDATE_DELETECHARS].Passed())
-    {
-        m_timers[WUPDATE_DELETECHARS].Reset();
-        Player::DeleteOldCharacters();
-    }
-
     sScenarioMgr->Update(diff);
     RecordTimeDiff("UpdateScenarioMgr");
 
@@ -2504,61 +2641,73 @@ void World::Update(uint32 diff)
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
 
-    ///- Erase corpses once every 20 minutes
-    if (m_timers[WUPDATE_CORPSES].Passed())
-    {
-        m_timers[WUPDATE_CORPSES].Reset();
-        sObjectAccessor->RemoveOldCorpses();
-    }
+    // And last, but not least handle the issued cli commands
+    ProcessCliCommands();
 
-    ///- Process Game events when necessary
-    if (m_timers[WUPDATE_EVENTS].Passed())
-    {
-        m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
-        uint32 nextGameEvent = sGameEventMgr->Update();
-        m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
-        m_timers[WUPDATE_EVENTS].Reset();
-    }
+    sScriptMgr->OnWorldUpdate(diff);
+}
 
-    if (m_timers[WUPDATE_MAILBOXQUEUE].Passed())
-    {
-        m_timers[WUPDATE_MAILBOXQUEUE].Reset();
-        ProcessMailboxQueue();
-        Transfer();
-        GetPoolGuids();
-    }
+void World::ForceGameEventUpdate()
+{
+    m_scheduler.SetInterval(m_timers[WUPDATE_EVENTS], sGameEventMgr->Update());
+}
 
-    ///- Ping to keep MySQL connections alive
-    if (m_timers[WUPDATE_PINGDB].Passed())
-    {
-        m_timers[WUPDATE_PINGDB].Reset();
-        TC_LOG_DEBUG("server", "Ping MySQL to keep connection alive");
-        CharacterDatabase.KeepAlive();
-        LoginDatabase.KeepAlive();
-        WorldDatabase.KeepAlive();
-    }
+void World::ScheduleWorldTimer(WorldTimers timer, char const* name, uint32 interval, TimerWheel::Callback&& callback)
+{
+    m_timers[timer] = m_scheduler.Schedule(name, interval, std::move(callback));
+}
 
-    if (m_timers[WUPDATE_GUILDSAVE].Passed())
+void World::UpdateAuctions()
+{
+    ///- Update mails (return old mails with item, or delete them)
+    //(tested... works on win)
+    if (++mail_timer > mail_timer_expires)
     {
-        m_timers[WUPDATE_GUILDSAVE].Reset();
-        sGuildMgr->SaveGuilds();
+        mail_timer = 0;
+        sObjectMgr->ReturnOrDeleteOldMails(true);
     }
 
-    // update the instance reset times
-    sInstanceSaveMgr->Update();
+    ///- Handle expired auctions
+    sAuctionMgr->Update();
+}
 
-    // And last, but not least handle the issued cli commands
-    ProcessCliCommands();
+void World::UpdateUptime()
+{
+    uint32 tmpDiff = uint32(m_gameTime - m_startTime);
+    uint32 maxOnlinePlayers = GetMaxPlayerCount();
 
-    sScriptMgr->OnWorldUpdate(diff);
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
+
+    stmt->setUInt32(0, tmpDiff);
+    stmt->setUInt16(1, uint16(maxOnlinePlayers));
+    stmt->setUInt32(2, realmID);
+    stmt->setUInt32(3, uint32(m_startTime));
+
+    LoginDatabase.Execute(stmt);
+
+    if (!m_bool_configs[CONFIG_DISABLE_NEW_ONLINE])
+        LoginDatabase.PQuery("REPLACE INTO `online` (`realmID`, `online`, `diff`, `uptime`) VALUES ('%u', '%u', '%u', '%u')", realmID, GetActiveSessionCount(), GetUpdateTime(), GetUptime());
 }
 
-void World::ForceGameEventUpdate()
+void World::CleanOldLogs()
 {
-    m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
-    uint32 nextGameEvent = sGameEventMgr->Update();
-    m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
-    m_timers[WUPDATE_EVENTS].Reset();
+    if (!getIntConfig(CONFIG_LOGDB_CLEARTIME)) // if not enabled, ignore the timer
+        return;
+
+    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
+
+    stmt->setUInt32(0, getIntConfig(CONFIG_LOGDB_CLEARTIME));
+    stmt->setUInt32(1, uint32(time(0)));
+
+    LoginDatabase.Execute(stmt);
+}
+
+void World::PingDatabases()
+{
+    TC_LOG_DEBUG("server", "Ping MySQL to keep connection alive");
+    CharacterDatabase.KeepAlive();
+    LoginDatabase.KeepAlive();
+    WorldDatabase.KeepAlive();
 }
 
 /// Send a packet to all players (except self if mentioned)
@@ -3054,6 +3203,8 @@ void World::SendServerMessage(ServerMessageType type, const char *text, Player*
 
 void World::UpdateSessions(uint32 diff)
 {
+    PROFILE_SCOPE("World::UpdateSessions");
+
     ///- Add new sessions
     WorldSession* sess = NULL;
     while (addSessQueue.next(sess))
@@ -25,6 +25,7 @@
 
 #include "Common.h"
 #include "Timer.h"
+#include "TimerWheel.h"
 #include <ace/Singleton.h>
 #include <ace/Atomic_Op.h>
 #include "SharedDefines.h"
@@ -93,6 +94,8 @@ enum WorldTimers
     WUPDATE_DELETECHARS,
     WUPDATE_PINGDB,
     WUPDATE_GUILDSAVE,
+    WUPDATE_PROFILER,
+    WUPDATE_MOVEMENT_INTEREST,
     WUPDATE_COUNT
 };
 
@@ -206,10 +209,13 @@ enum WorldBoolConfigs
     CONFIG_CUSTOM_CONTENT_ENABLED,
     CONFIG_DAMAGE_ENABLE_FROM_DBC,
     CONFIG_FASTER_LOADING,
+    CONFIG_PARALLEL_LOADING,
     CONFIG_CUSTOM_BATTLEGROUND,
     CONFIG_CUSTOM_X20,
     CONFIG_CUSTOM_FOOTBALL,
     CONFIG_ANTI_FLOOD_LFG,
+    CONFIG_PROFILER_ENABLE,
+    CONFIG_MOVEMENT_INTEREST_ENABLE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -230,6 +236,8 @@ enum WorldFloatConfigs
     CONFIG_ARCHAEOLOGY_RARE_MAXLEVEL_CHANCE,
     CONFIG_WARDEN_Z_AXIS_DELTA,
     CONFIG_WARDEN_MAX_TP_DIST,
+    CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE,
+    CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -316,6 +324,13 @@ enum WorldIntConfigs
     CONFIG_CHATFLOOD_MESSAGE_DELAY,
     CONFIG_CHATFLOOD_MUTE_TIME,
     CONFIG_EVENT_ANNOUNCE,
+    CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE,
+    CONFIG_PROFILER_EXPORT_INTERVAL,
+    CONFIG_PROFILER_SPIKE_THRESHOLD,
+    CONFIG_BOTS_BENCHMARK_COUNT,
+    CONFIG_BOTS_BENCHMARK_DURATION,
+    CONFIG_MOVEMENT_INTEREST_MID_INTERVAL,
+    CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL,
     CONFIG_CREATURE_FAMILY_ASSISTANCE_DELAY,
     CONFIG_CREATURE_FAMILY_FLEE_DELAY,
     CONFIG_WORLD_BOSS_LEVEL_DIFF,
@@ -657,6 +672,7 @@ class World
         const SessionMap& GetAllSessions() const { return m_sessions; }
         uint32 GetActiveAndQueuedSessionCount() const { return m_sessions.size() * getRate(RATE_ONLINE); }
         uint32 GetActiveSessionCount() const { return (m_sessions.size() - m_QueuedPlayer.size()) * getRate(RATE_ONLINE); }
+        uint32 GetSessionCount() const { return m_sessions.size(); }   // not scaled for the online rate
         uint32 GetQueuedSessionCount() const { return m_QueuedPlayer.size(); }
         /// Get the maximum number of parallel sessions on the server since last reboot
         uint32 GetMaxQueuedSessionCount() const { return m_maxQueuedSessionCount; }
@@ -860,6 +876,9 @@ class World
 
         void ForceGameEventUpdate();
 
+        // deadlines of the periodic world work and of the managers, run by Update()
+        TimerWheel& GetScheduler() { return m_scheduler; }
+
         void UpdateRealmCharCount(uint32 accid);
 
         LocaleConstant GetAvailableDbcLocale(LocaleConstant locale) const { if (m_availableDbcLocaleMask & (1 << locale)) return locale; else return m_defaultDbcLocale; }
@@ -915,6 +934,11 @@ class World
 
     protected:
         void _UpdateGameTime();
+        void ScheduleWorldTimer(WorldTimers timer, char const* name, uint32 interval, TimerWheel::Callback&& callback);
+        void UpdateAuctions();
+        void UpdateUptime();
+        void CleanOldLogs();
+        void PingDatabases();
         // callback for UpdateRealmCharacters
         void _UpdateRealmCharCount(PreparedQueryResult resultCharCount);
 
@@ -948,7 +972,8 @@ class World
 
         time_t m_startTime;
         time_t m_gameTime;
-        IntervalTimer m_timers[WUPDATE_COUNT];
+        TimerWheel m_scheduler;
+        TimerWheel::TaskId m_timers[WUPDATE_COUNT];
         time_t mail_timer;
         time_t mail_timer_expires;
         uint32 m_updateTime, m_updateTimeSum;
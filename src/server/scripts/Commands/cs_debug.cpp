@@ -34,6 +34,16 @@ EndScriptData */
 #include "MapManager.h"
 #include "Vehicle.h"
 #include "ObjectVisitors.hpp"
+#include "WardenMgr.h"
+#include "PacketLog.h"
+#include "AccountMgr.h"
+#include "Config.h"
+#include "PlayerSaveTask.h"
+#include "GameEventMgr.h"
+#include "Profiler.h"
+#include "BotMgr.h"
+#include "ReplayMgr.h"
+#include "MovementInterest.h"
 
 #include <fstream>
 
@@ -69,6 +79,41 @@ public:
             
             { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
         };
+        static ChatCommand debugPacketLogCommandTable[] =
+        {
+            { "start",          SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogStartCommand,     "", NULL },
+            { "stop",           SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogStopCommand,      "", NULL },
+            { "status",         SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogStatusCommand,    "", NULL },
+            { "addaccount",     SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogAddAccountCommand, "", NULL },
+            { "removeaccount",  SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogRemoveAccountCommand, "", NULL },
+            { "addopcode",      SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogAddOpcodeCommand, "", NULL },
+            { "removeopcode",   SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogRemoveOpcodeCommand, "", NULL },
+            { "clear",          SEC_ADMINISTRATOR,  true,  &HandleDebugPacketLogClearCommand,     "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+        };
+        static ChatCommand debugProfileCommandTable[] =
+        {
+            { "start",          SEC_ADMINISTRATOR,  true,  &HandleDebugProfileStartCommand,       "", NULL },
+            { "stop",           SEC_ADMINISTRATOR,  true,  &HandleDebugProfileStopCommand,        "", NULL },
+            { "status",         SEC_ADMINISTRATOR,  true,  &HandleDebugProfileStatusCommand,      "", NULL },
+            { "top",            SEC_ADMINISTRATOR,  true,  &HandleDebugProfileTopCommand,         "", NULL },
+            { "export",         SEC_ADMINISTRATOR,  true,  &HandleDebugProfileExportCommand,      "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+        };
+        static ChatCommand debugBotsCommandTable[] =
+        {
+            { "add",            SEC_ADMINISTRATOR,  false, &HandleDebugBotsAddCommand,            "", NULL },
+            { "remove",         SEC_ADMINISTRATOR,  true,  &HandleDebugBotsRemoveCommand,         "", NULL },
+            { "report",         SEC_ADMINISTRATOR,  true,  &HandleDebugBotsReportCommand,         "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+        };
+        static ChatCommand debugReplayCommandTable[] =
+        {
+            { "start",          SEC_ADMINISTRATOR,  true,  &HandleDebugReplayStartCommand,        "", NULL },
+            { "stop",           SEC_ADMINISTRATOR,  true,  &HandleDebugReplayStopCommand,         "", NULL },
+            { "status",         SEC_ADMINISTRATOR,  true,  &HandleDebugReplayStatusCommand,       "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+        };
         static ChatCommand debugCommandTable[] =
         {
             { "anim",           SEC_GAMEMASTER,     false, &HandleDebugAnimCommand,            "", NULL },
@@ -77,9 +122,12 @@ public:
             { "attackpower",    SEC_REALM_LEADER,   false, &HandleDebugModifyAttackpowerCommand,    "", NULL },
             { "backward",       SEC_REALM_LEADER,   false, &HandleDebugMoveBackward,           "", NULL },
             { "bg",             SEC_REALM_LEADER,   false, &HandleDebugBattlegroundCommand,    "", NULL },
+            { "bots",           SEC_ADMINISTRATOR,  true,  NULL,              "", debugBotsCommandTable },
+            { "replay",         SEC_ADMINISTRATOR,  true,  NULL,              "", debugReplayCommandTable },
             { "crit",           SEC_REALM_LEADER,   false, &HandleDebugModifyCritChanceCommand,     "", NULL },
             { "clientGUIDs",    SEC_GAMEMASTER,     false, &HandleDebugClientGUIDsCommand,     "", NULL },
             { "entervehicle",   SEC_ADMINISTRATOR,  false, &HandleDebugEnterVehicleCommand,    "", NULL },
+            { "eventspawns",    SEC_ADMINISTRATOR,  true,  &HandleDebugEventSpawnsCommand,     "", NULL },
             { "getdynamicvalue",SEC_ADMINISTRATOR,  false, &HandleDebugGetDynamicValueCommand, "", NULL },
             { "getitemstate",   SEC_ADMINISTRATOR,  false, &HandleDebugGetItemStateCommand,    "", NULL },
             { "getitemvalue",   SEC_ADMINISTRATOR,  false, &HandleDebugGetItemValueCommand,    "", NULL },
@@ -97,8 +145,18 @@ public:
             { "mastery",        SEC_REALM_LEADER,   false, &HandleDebugModifyMasteryCommand,        "", NULL },
             { "mod32value",     SEC_ADMINISTRATOR,  false, &HandleDebugMod32ValueCommand,      "", NULL },
             { "moveflags",      SEC_ADMINISTRATOR,  false, &HandleDebugMoveflagsCommand,       "", NULL },
+            { "moveinterest",   SEC_ADMINISTRATOR,  true,  &HandleDebugMoveInterestCommand,    "", NULL },
             { "phase",          SEC_MODERATOR,      false, &HandleDebugPhaseCommand,           "", NULL },
             { "play",           SEC_MODERATOR,      false, NULL,              "", debugPlayCommandTable },
+            { "procstats",      SEC_ADMINISTRATOR,  true,  &HandleDebugProcStatsCommand,       "", NULL },
+            { "pathcache",      SEC_ADMINISTRATOR,  false, &HandleDebugPathCacheCommand,       "", NULL },
+            { "opcodestats",    SEC_ADMINISTRATOR,  true,  &HandleDebugOpcodeStatsCommand,     "", NULL },
+            { "packetlog",      SEC_ADMINISTRATOR,  true,  NULL,              "", debugPacketLogCommandTable },
+            { "packetpool",     SEC_ADMINISTRATOR,  true,  &HandleDebugPacketPoolCommand,      "", NULL },
+            { "profile",        SEC_ADMINISTRATOR,  true,  NULL,              "", debugProfileCommandTable },
+            { "wardenstats",    SEC_ADMINISTRATOR,  true,  &HandleDebugWardenStatsCommand,     "", NULL },
+            { "savestats",      SEC_ADMINISTRATOR,  true,  &HandleDebugSaveStatsCommand,       "", NULL },
+            { "scheduler",      SEC_ADMINISTRATOR,  true,  &HandleDebugSchedulerCommand,       "", NULL },
             { "send",           SEC_ADMINISTRATOR,  false, NULL,              "", debugSendCommandTable },
             { "setaurastate",   SEC_ADMINISTRATOR,  false, &HandleDebugSetAuraStateCommand,    "", NULL },
             { "setbit",         SEC_ADMINISTRATOR,  false, &HandleDebugSet32BitCommand,        "", NULL },
@@ -914,6 +972,612 @@ public:
         return true;
     }
 
+    static bool HandleDebugProcStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug procstats [reset]
+        ProcEvaluationStats& stats = Unit::GetProcEvaluationStats();
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            stats.Reset();
+            handler->SendSysMessage("Proc evaluation counters reset.");
+            return true;
+        }
+
+        uint64 events = stats.Events;
+        uint64 appliedAuras = stats.AppliedAuras;
+        uint64 candidates = stats.Candidates;
+        uint64 triggered = stats.Triggered;
+
+        handler->PSendSysMessage("Proc events: " UI64FMTD, events);
+        handler->PSendSysMessage("Applied auras (full scan): " UI64FMTD " (%.2f per event)", appliedAuras, events ? float(appliedAuras) / events : 0.0f);
+        handler->PSendSysMessage("Indexed candidates: " UI64FMTD " (%.2f per event)", candidates, events ? float(candidates) / events : 0.0f);
+        handler->PSendSysMessage("Triggered: " UI64FMTD " (%.2f per event)", triggered, events ? float(triggered) / events : 0.0f);
+        return true;
+    }
+
+    static bool HandleDebugPathCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        // USAGE: .debug pathcache
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        PathCache const& cache = map->GetPathCache();
+        PathCacheStats const& stats = cache.GetStats();
+
+        uint64 lookups = stats.Hits + stats.Misses;
+        handler->PSendSysMessage("Path cache of map %u instance %u: %u paths", map->GetId(), map->GetInstanceId(), cache.GetSize());
+        handler->PSendSysMessage("Hits: " UI64FMTD " Misses: " UI64FMTD " (%.2f%% hit rate)", stats.Hits, stats.Misses, lookups ? float(stats.Hits) * 100.0f / lookups : 0.0f);
+        handler->PSendSysMessage("Stored: " UI64FMTD " Expired: " UI64FMTD " Invalidated: " UI64FMTD " Flushes: " UI64FMTD, stats.Stored, stats.Expired, stats.Invalidated, stats.Flushes);
+        handler->PSendSysMessage("Non-urgent paths granted: " UI64FMTD " deferred: " UI64FMTD, stats.Granted, stats.Deferred);
+        handler->PSendSysMessage("Deferred wait: avg %u ms, max %u ms", stats.DeferredServed ? uint32(stats.DeferredWaitTotal / stats.DeferredServed) : 0, stats.DeferredWaitMax);
+        return true;
+    }
+
+    static bool HandleDebugOpcodeStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug opcodestats [count|reset]
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            for (uint32 i = 0; i < NUM_OPCODE_HANDLERS; ++i)
+                if (OpcodeHandler const* opHandle = opcodeTable[CMSG][i])
+                    opHandle->timeStats.Reset();
+
+            handler->SendSysMessage("Opcode handling times reset.");
+            return true;
+        }
+
+        uint32 count = *args ? uint32(atoi(args)) : 10;
+        if (!count)
+            count = 10;
+
+        // the map threads keep counting, the sort and the lines work on a copy taken once
+        struct OpcodeSnapshot
+        {
+            OpcodeHandler const* Handler;
+            uint64 Calls;
+            uint64 Time;
+        };
+
+        std::vector<OpcodeSnapshot> handlers;
+        uint64 totalTime = 0;
+        for (uint32 i = 0; i < NUM_OPCODE_HANDLERS; ++i)
+        {
+            if (OpcodeHandler const* opHandle = opcodeTable[CMSG][i])
+            {
+                OpcodeSnapshot snapshot;
+                snapshot.Handler = opHandle;
+                snapshot.Calls = opHandle->timeStats.Count;
+                snapshot.Time = opHandle->timeStats.TotalTime;
+                if (snapshot.Calls)
+                {
+                    handlers.push_back(snapshot);
+                    totalTime += snapshot.Time;
+                }
+            }
+        }
+
+        std::sort(handlers.begin(), handlers.end(), [](OpcodeSnapshot const& left, OpcodeSnapshot const& right)
+        {
+            return left.Time > right.Time;
+        });
+
+        if (handlers.size() > count)
+            handlers.resize(count);
+
+        handler->PSendSysMessage("Opcode handlers by total time (" UI64FMTD " ms spent in handlers):", totalTime / IN_MILLISECONDS);
+        for (OpcodeSnapshot const& snapshot : handlers)
+        {
+            OpcodeTimeStats const& stats = snapshot.Handler->timeStats;
+            handler->PSendSysMessage("%s: " UI64FMTD " calls, " UI64FMTD " ms (%.1f%%), avg " UI64FMTD " us, p50 < %u us, p99 < %u us, max %u us",
+                snapshot.Handler->name, snapshot.Calls, snapshot.Time / IN_MILLISECONDS, totalTime ? float(snapshot.Time) * 100.0f / totalTime : 0.0f,
+                snapshot.Time / snapshot.Calls, stats.GetPercentile(0.5f), stats.GetPercentile(0.99f), uint32(stats.MaxTime));
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugPacketLogStartCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetlog start [file]
+        std::string fileName = *args ? args : ConfigMgr::GetStringDefault("PacketLogFile", "");
+        if (fileName.empty())
+            fileName = "World.pkt";
+
+        if (sPacketLog->CanLogPacket())
+        {
+            handler->PSendSysMessage("Packets are already captured to %s.", sPacketLog->GetFileName().c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!sPacketLog->Start(fileName))
+        {
+            handler->PSendSysMessage("Can't open %s for the packet capture.", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Capturing packets to %s.", fileName.c_str());
+        return true;
+    }
+
+    static bool HandleDebugPacketLogStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (!sPacketLog->CanLogPacket())
+        {
+            handler->SendSysMessage("Packets aren't captured.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        sPacketLog->Stop();
+        handler->PSendSysMessage("Packet capture stopped, " UI64FMTD " packets written, " UI64FMTD " dropped.", sPacketLog->GetWrittenPackets(), sPacketLog->GetDroppedPackets());
+        return true;
+    }
+
+    static bool HandleDebugPacketPoolCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetpool [threads]
+        PacketPoolStats total = sPacketPool->GetStats();
+        handler->PSendSysMessage("Packet pool: %u threads, " UI64FMTD " allocations (" UI64FMTD " MB), %.1f%% from the free lists of the threads, " UI64FMTD " from the heap",
+            total.Thread, total.Allocations, total.Bytes / (1024 * 1024), total.Allocations ? total.ThreadHits * 100.0 / total.Allocations : 0.0, total.HeapAllocations);
+        handler->PSendSysMessage("Frees: " UI64FMTD ", " UI64FMTD " batches given to the depot, " UI64FMTD " taken from it, " UI64FMTD " blocks back to the heap, " UI64FMTD " KB free in the depot",
+            total.Frees, total.DepotReturns, total.DepotHits, total.HeapFrees, sPacketPool->GetDepotBytes() / 1024);
+
+        if (!*args || strncmp(args, "threads", 7) != 0)
+            return true;
+
+        for (PacketPoolStats const& thread : sPacketPool->GetThreadStats())
+        {
+            if (!thread.Allocations && !thread.Frees)
+                continue;
+
+            handler->PSendSysMessage("Thread %u: " UI64FMTD " allocations, %.1f%% from its free lists, " UI64FMTD " from the heap, " UI64FMTD " frees, " UI64FMTD " back to the heap",
+                thread.Thread, thread.Allocations, thread.Allocations ? thread.ThreadHits * 100.0 / thread.Allocations : 0.0, thread.HeapAllocations, thread.Frees, thread.HeapFrees);
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugMoveInterestCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (sWorld->getBoolConfig(CONFIG_MOVEMENT_INTEREST_ENABLE))
+            handler->PSendSysMessage("Movement relays: every one closer than %.1f yards, one per %u ms up to %.1f yards, one per %u ms further away",
+                sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE), sWorld->getIntConfig(CONFIG_MOVEMENT_INTEREST_MID_INTERVAL),
+                sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE), sWorld->getIntConfig(CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL));
+        else
+            handler->SendSysMessage("Movement relays: all sent, Movement.Interest.Enable is off");
+
+        MovementInterestStats stats = sMovementInterestMgr->GetStats();
+        handler->PSendSysMessage("Since the start: " UI64FMTD " relays sent (" UI64FMTD " KB), " UI64FMTD " held back, " UI64FMTD " of them sent later, " UI64FMTD " replaced by newer ones (" UI64FMTD " KB saved)",
+            stats.Relayed + stats.Flushed, stats.RelayedBytes / 1024, stats.Held, stats.Flushed, stats.Superseded, stats.SavedBytes / 1024);
+        handler->PSendSysMessage("Last %u seconds: %.0f relays and %.0f bytes saved per second, %.0f bytes sent per second",
+            MOVEMENT_INTEREST_RATE_INTERVAL / IN_MILLISECONDS, stats.SavedPerSecond, stats.SavedBytesPerSecond, stats.RelayedBytesPerSecond);
+        return true;
+    }
+
+    static bool HandleDebugPacketLogStatusCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (sPacketLog->CanLogPacket())
+            handler->PSendSysMessage("Capturing packets to %s: " UI64FMTD " packets (" UI64FMTD " KB) written, " UI64FMTD " dropped.", sPacketLog->GetFileName().c_str(),
+                sPacketLog->GetWrittenPackets(), sPacketLog->GetWrittenBytes() / 1024, sPacketLog->GetDroppedPackets());
+        else
+            handler->SendSysMessage("Packets aren't captured.");
+
+        std::vector<uint32> accounts = sPacketLog->GetAccountFilter();
+        if (accounts.empty())
+            handler->SendSysMessage("Accounts: all");
+        else
+        {
+            std::ostringstream ss;
+            for (uint32 accountId : accounts)
+                ss << ' ' << accountId;
+            handler->PSendSysMessage("Accounts:%s", ss.str().c_str());
+        }
+
+        std::vector<uint32> opcodes = sPacketLog->GetOpcodeFilter();
+        if (opcodes.empty())
+            handler->SendSysMessage("Opcodes: all");
+        else
+        {
+            handler->SendSysMessage("Opcodes:");
+            for (uint32 opcode : opcodes)
+                handler->PSendSysMessage("  0x%04X %s", opcode, GetOpcodeNameForLogging(Opcodes(opcode)).c_str());
+        }
+
+        return true;
+    }
+
+    // account name, or the account of the selected player
+    static uint32 ExtractPacketLogAccount(ChatHandler* handler, char const* args)
+    {
+        if (!*args)
+        {
+            Player* player = handler->getSelectedPlayer();
+            if (!player)
+            {
+                handler->SendSysMessage(LANG_PLAYER_NOT_FOUND);
+                handler->SetSentErrorMessage(true);
+                return 0;
+            }
+
+            return player->GetSession()->GetAccountId();
+        }
+
+        std::string accountName = args;
+        uint32 accountId = AccountMgr::normalizeString(accountName) ? AccountMgr::GetId(accountName) : 0;
+        if (!accountId)
+        {
+            handler->PSendSysMessage(LANG_ACCOUNT_NOT_EXIST, accountName.c_str());
+            handler->SetSentErrorMessage(true);
+        }
+
+        return accountId;
+    }
+
+    static bool HandleDebugPacketLogAddAccountCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetlog addaccount [account]
+        uint32 accountId = ExtractPacketLogAccount(handler, args);
+        if (!accountId)
+            return false;
+
+        sPacketLog->AddAccountFilter(accountId);
+        handler->PSendSysMessage("Packets of account %u are captured.", accountId);
+        return true;
+    }
+
+    static bool HandleDebugPacketLogRemoveAccountCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetlog removeaccount [account]
+        uint32 accountId = ExtractPacketLogAccount(handler, args);
+        if (!accountId)
+            return false;
+
+        sPacketLog->RemoveAccountFilter(accountId);
+        handler->PSendSysMessage("Packets of account %u aren't captured anymore.", accountId);
+        return true;
+    }
+
+    static bool HandleDebugPacketLogAddOpcodeCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetlog addopcode #opcode (decimal or 0x hex)
+        if (!*args)
+            return false;
+
+        uint32 opcode = uint32(strtoul(args, NULL, 0));
+        if (opcode >= NUM_OPCODE_HANDLERS)
+            return false;
+
+        sPacketLog->AddOpcodeFilter(opcode);
+        handler->PSendSysMessage("Opcode 0x%04X %s is captured.", opcode, GetOpcodeNameForLogging(Opcodes(opcode)).c_str());
+        return true;
+    }
+
+    static bool HandleDebugPacketLogRemoveOpcodeCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug packetlog removeopcode #opcode (decimal or 0x hex)
+        if (!*args)
+            return false;
+
+        uint32 opcode = uint32(strtoul(args, NULL, 0));
+        if (opcode >= NUM_OPCODE_HANDLERS)
+            return false;
+
+        sPacketLog->RemoveOpcodeFilter(opcode);
+        handler->PSendSysMessage("Opcode 0x%04X %s isn't captured anymore.", opcode, GetOpcodeNameForLogging(Opcodes(opcode)).c_str());
+        return true;
+    }
+
+    static bool HandleDebugPacketLogClearCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sPacketLog->ClearFilters();
+        handler->SendSysMessage("Packets of all accounts and opcodes are captured.");
+        return true;
+    }
+
+    static bool HandleDebugEventSpawnsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        GameEventSpawnStats& stats = sGameEventMgr->GetSpawnStats();
+        uint64 queued = stats.Queued;
+        uint64 applied = stats.Applied;
+        uint64 skipped = stats.Skipped;
+
+        handler->PSendSysMessage("Game event spawns and despawns queued to the maps: " UI64FMTD ", applied " UI64FMTD ", skipped " UI64FMTD ", pending " UI64FMTD " (%u per map update)",
+            queued, applied, skipped, queued - applied - skipped, sWorld->getIntConfig(CONFIG_EVENT_SPAWNS_PER_MAP_UPDATE));
+        return true;
+    }
+
+    static bool HandleDebugSaveStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug savestats [reset]
+        PlayerSaveStats& stats = PlayerSaveTask::Stats;
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            stats.Reset();
+            handler->SendSysMessage("Player save times reset.");
+            return true;
+        }
+
+        uint64 saves = stats.Saves;
+        uint64 mapThreadTime = stats.MapThreadTime;
+        uint64 serialized = stats.Serialized;
+        uint64 serializeTime = stats.SerializeTime;
+        handler->PSendSysMessage("Player saves: " UI64FMTD ", map thread " UI64FMTD " ms, avg " UI64FMTD " us, max %u us", saves, mapThreadTime / IN_MILLISECONDS,
+            saves ? mapThreadTime / saves : 0, uint32(stats.MaxMapThreadTime));
+        handler->PSendSysMessage("Character rows built and committed: " UI64FMTD ", avg " UI64FMTD " us", serialized, serialized ? serializeTime / serialized : 0);
+        handler->PSendSysMessage("Autosaves delayed to a later map update: " UI64FMTD, uint64(stats.DelayedAutosaves));
+        return true;
+    }
+
+    static bool HandleDebugSchedulerCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug scheduler [reset]
+        TimerWheel& scheduler = sWorld->GetScheduler();
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            scheduler.ResetCosts();
+            handler->SendSysMessage("Scheduled task run times reset.");
+            return true;
+        }
+
+        std::vector<TimerWheelTaskInfo> tasks = scheduler.GetTasks();
+        handler->PSendSysMessage("Scheduled tasks: " SIZEFMTD, tasks.size());
+
+        for (TimerWheelTaskInfo const& task : tasks)
+        {
+            std::ostringstream history;
+            for (uint32 time : task.History)
+                history << ' ' << time;
+
+            handler->PSendSysMessage("%s: in " UI64FMTD " s, every %u s, runs " UI64FMTD ", avg " UI64FMTD " us, max %u us, last runs (us):%s",
+                task.Name.c_str(), task.DueIn / IN_MILLISECONDS, task.Interval / IN_MILLISECONDS, task.Runs,
+                task.Runs ? task.TotalTime / task.Runs : 0, task.MaxTime, history.str().c_str());
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugProfileStartCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sProfiler->Start();
+        handler->SendSysMessage("Profiler started.");
+        return true;
+    }
+
+    static bool HandleDebugProfileStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sProfiler->Stop();
+        handler->SendSysMessage("Profiler stopped, the counters are kept until the next start or export.");
+        return true;
+    }
+
+    static bool HandleDebugProfileStatusCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        handler->PSendSysMessage("Profiler %s, spike threshold %u ms, " UI64FMTD " spikes, last export: %s", Profiler::IsEnabled() ? "running" : "stopped",
+            sProfiler->GetSpikeThreshold(), sProfiler->GetSpikes(), sProfiler->GetLastExport().empty() ? "none" : sProfiler->GetLastExport().c_str());
+
+        // self time since the last export
+        std::vector<std::pair<std::string, uint64>> stacks = sProfiler->GetStacks();
+        for (size_t i = 0; i < stacks.size() && i < 10; ++i)
+            handler->PSendSysMessage("  " UI64FMTD " ms %s", stacks[i].second / IN_MILLISECONDS, stacks[i].first.c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugProfileTopCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug profile top map|creature|spell|opcode [count]
+        char* categoryStr = strtok((char*)args, " ");
+        if (!categoryStr)
+            return false;
+
+        ProfileCategory category = PROFILE_NONE;
+        for (uint8 i = PROFILE_MAP; i < MAX_PROFILE_CATEGORY; ++i)
+            if (strcmp(categoryStr, Profiler::GetCategoryName(ProfileCategory(i))) == 0)
+                category = ProfileCategory(i);
+
+        if (category == PROFILE_NONE)
+            return false;
+
+        char* countStr = strtok(NULL, " ");
+        uint32 count = countStr ? uint32(atoi(countStr)) : 10;
+
+        std::vector<ProfileKeyStats> keys = sProfiler->GetKeyStats(category);
+        for (size_t i = 0; i < keys.size() && i < count; ++i)
+        {
+            ProfileKeyStats const& stats = keys[i];
+
+            std::string name;
+            switch (category)
+            {
+                case PROFILE_MAP:
+                    if (MapEntry const* map = sMapStore.LookupEntry(stats.Key))
+                        name = map->name;
+                    break;
+                case PROFILE_CREATURE:
+                    if (CreatureTemplate const* creature = sObjectMgr->GetCreatureTemplate(stats.Key))
+                        name = creature->Name;
+                    break;
+                case PROFILE_SPELL:
+                    if (SpellInfo const* spell = sSpellMgr->GetSpellInfo(stats.Key))
+                        name = spell->SpellName;
+                    break;
+                case PROFILE_OPCODE:
+                    name = GetOpcodeNameForLogging(Opcodes(stats.Key));
+                    break;
+                default:
+                    break;
+            }
+
+            handler->PSendSysMessage("%s %u %s: " UI64FMTD " ms, " UI64FMTD " calls, avg " UI64FMTD " us, max %u us", categoryStr, stats.Key, name.c_str(),
+                stats.Time / IN_MILLISECONDS, stats.Calls, stats.Calls ? stats.Time / stats.Calls : 0, stats.MaxTime);
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugProfileExportCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        std::string fileName = sProfiler->Export();
+        if (fileName.empty())
+            handler->SendSysMessage("Profiler counters couldn't be written, see the server log.");
+        else
+            handler->PSendSysMessage("Profiler counters written to %s and the .txt next to it.", fileName.c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugBotsAddCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug bots add <count> [idle|move|cast|aoe|chat|auction|mixed]
+        char* countStr = strtok((char*)args, " ");
+        if (!countStr)
+            return false;
+
+        uint32 count = uint32(atoi(countStr));
+        if (!count)
+            return false;
+
+        BotBehaviour behaviour = BOT_BEHAVIOUR_MIXED;
+        if (char* behaviourStr = strtok(NULL, " "))
+        {
+            behaviour = BotMgr::GetBehaviourByName(behaviourStr);
+            if (behaviour == MAX_BOT_BEHAVIOUR)
+                return false;
+        }
+
+        Player* player = handler->GetSession()->GetPlayer();
+        if (player->GetMap()->Instanceable())
+        {
+            handler->SendSysMessage("Bots can only log in on continents.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        WorldLocation location(player->GetMapId(), player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
+        sBotMgr->AddBots(count, behaviour, location, player->GetPhaseMask(), player->GetTeam());
+
+        handler->PSendSysMessage("%u %s bots will log in here, %u per world update.", count, BotMgr::GetBehaviourName(behaviour), uint32(BOT_LOGINS_PER_UPDATE));
+        return true;
+    }
+
+    static bool HandleDebugBotsRemoveCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug bots remove [count], all of them without count
+        uint32 count = *args ? uint32(atoi(args)) : 0;
+        uint32 before = sBotMgr->GetBotCount() + sBotMgr->GetPendingCount();
+
+        sBotMgr->RemoveBots(count);
+
+        handler->PSendSysMessage("%u bots removed, %u left.", before - sBotMgr->GetBotCount() - sBotMgr->GetPendingCount(), sBotMgr->GetBotCount() + sBotMgr->GetPendingCount());
+        return true;
+    }
+
+    static bool HandleDebugBotsReportCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug bots report [reset]
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            sBotMgr->ResetStats();
+            handler->SendSysMessage("Bot statistics and world update times reset.");
+            return true;
+        }
+
+        for (std::string const& line : sBotMgr->GetReport())
+            handler->SendSysMessage(line.c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugReplayStartCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug replay start <capture> [speed] [baseline report]
+        char* fileStr = strtok((char*)args, " ");
+        if (!fileStr)
+            return false;
+
+        float speed = 1.0f;
+        if (char* speedStr = strtok(NULL, " "))
+            speed = float(atof(speedStr));
+
+        char* baselineStr = strtok(NULL, " ");
+
+        if (sReplayMgr->IsRunning())
+        {
+            handler->SendSysMessage("A replay is already running, stop it first.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (sWorld->GetSessionCount())
+        {
+            handler->SendSysMessage("A replay only starts while nobody is online, start it from the console.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!sReplayMgr->Start(fileStr, speed, baselineStr ? baselineStr : ""))
+        {
+            handler->PSendSysMessage("The replay of %s couldn't start, see the server log.", fileStr);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        for (std::string const& line : sReplayMgr->GetStatus())
+            handler->SendSysMessage(line.c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugReplayStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (!sReplayMgr->IsRunning())
+        {
+            handler->SendSysMessage("No replay is running.");
+            return true;
+        }
+
+        sReplayMgr->Stop();
+        handler->SendSysMessage("Replay stopped, the sessions logged out without a report.");
+        return true;
+    }
+
+    static bool HandleDebugReplayStatusCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (std::string const& line : sReplayMgr->GetStatus())
+            handler->SendSysMessage(line.c_str());
+
+        return true;
+    }
+
+    static bool HandleDebugWardenStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug wardenstats [reset]
+        WardenVerifyStats& stats = _wardenMgr->GetVerifyStats();
+        if (*args && strncmp(args, "reset", 5) == 0)
+        {
+            stats.Reset();
+            handler->SendSysMessage("Warden verification times reset.");
+            return true;
+        }
+
+        uint64 responses = stats.Responses;
+        uint64 responseTime = stats.ResponseTime;
+        handler->PSendSysMessage("Warden responses verified: " UI64FMTD ", " UI64FMTD " ms, avg " UI64FMTD " us", responses, responseTime / IN_MILLISECONDS,
+            responses ? responseTime / responses : 0);
+
+        for (uint8 type = 0; type < MAX_CHECK_TYPE; ++type)
+        {
+            uint64 checks = stats.Checks[type];
+            if (!checks)
+                continue;
+
+            uint64 time = stats.CheckTime[type];
+            handler->PSendSysMessage("%s: " UI64FMTD " checks, " UI64FMTD " ms, avg " UI64FMTD " us", WardenMgr::GetCheckTypeName(type), checks, time / IN_MILLISECONDS, time / checks);
+        }
+
+        return true;
+    }
+
     static bool HandleDebugHostileRefListCommand(ChatHandler* handler, char const* /*args*/)
     {
         Unit* target = handler->getSelectedUnit();
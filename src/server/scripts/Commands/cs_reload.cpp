@@ -229,9 +229,16 @@ public:
     static bool HandleReloadAllLootCommand(ChatHandler* handler, const char* /*args*/)
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables...");
-        LoadLootTables();
+        bool loaded = LoadLootTables();
+        sConditionMgr->LoadConditions(true);                // the tables read completely lost their conditions
+        if (!loaded)
+        {
+            handler->SendSysMessage("Some DB tables `*_loot_template` could not be read completely, the loot loaded before is kept for them.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         handler->SendGlobalGMSysMessage("DB tables `*_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
         return true;
     }
 
@@ -616,6 +623,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`creature_loot_template`)");
         LoadLootTemplates_Creature();
+        if (LootTemplates_Creature.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Creature.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Creature.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `creature_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -626,6 +640,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`disenchant_loot_template`)");
         LoadLootTemplates_Disenchant();
+        if (LootTemplates_Disenchant.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Disenchant.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Disenchant.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `disenchant_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -636,6 +657,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`fishing_loot_template`)");
         LoadLootTemplates_Fishing();
+        if (LootTemplates_Fishing.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Fishing.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Fishing.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `fishing_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -646,6 +674,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`gameobject_loot_template`)");
         LoadLootTemplates_Gameobject();
+        if (LootTemplates_Gameobject.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Gameobject.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Gameobject.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `gameobject_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -656,6 +691,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`item_loot_template`)");
         LoadLootTemplates_Item();
+        if (LootTemplates_Item.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Item.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Item.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `item_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -666,6 +708,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`milling_loot_template`)");
         LoadLootTemplates_Milling();
+        if (LootTemplates_Milling.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Milling.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Milling.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `milling_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -676,6 +725,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`pickpocketing_loot_template`)");
         LoadLootTemplates_Pickpocketing();
+        if (LootTemplates_Pickpocketing.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Pickpocketing.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Pickpocketing.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `pickpocketing_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -686,6 +742,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`prospecting_loot_template`)");
         LoadLootTemplates_Prospecting();
+        if (LootTemplates_Prospecting.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Prospecting.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Prospecting.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `prospecting_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -696,6 +759,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`mail_loot_template`)");
         LoadLootTemplates_Mail();
+        if (LootTemplates_Mail.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Mail.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Mail.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `mail_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -706,6 +776,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`reference_loot_template`)");
         LoadLootTemplates_Reference();
+        if (LootTemplates_Reference.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Reference.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         handler->SendGlobalGMSysMessage("DB table `reference_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
         return true;
@@ -715,6 +792,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`skinning_loot_template`)");
         LoadLootTemplates_Skinning();
+        if (LootTemplates_Skinning.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Skinning.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Skinning.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `skinning_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -725,6 +809,13 @@ public:
     {
         TC_LOG_INFO("server", "Re-Loading Loot Tables... (`spell_loot_template`)");
         LoadLootTemplates_Spell();
+        if (LootTemplates_Spell.HasLoadFailed())
+        {
+            handler->PSendSysMessage("DB table `%s` could not be read completely, the loot loaded before is kept.", LootTemplates_Spell.GetName());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
         LootTemplates_Spell.CheckLootRefs();
         handler->SendGlobalGMSysMessage("DB table `spell_loot_template` reloaded.");
         sConditionMgr->LoadConditions(true);
@@ -22,131 +22,87 @@
 #include <string.h>
 #include "DB2FileLoader.h"
 
+#include <ace/Mem_Map.h>
+
 DB2FileLoader::DB2FileLoader()
 {
     data = NULL;
+    stringTable = NULL;
     fieldsOffset = NULL;
+    mappedFile = NULL;
 }
 
-bool DB2FileLoader::Load(const char *filename, const char *fmt)
+template<class T>
+static bool ReadHeaderField(unsigned char const*& pos, unsigned char const* end, T& value)
 {
-    uint32 header = 48;
-    if (data)
-    {
-        delete [] data;
-        data=NULL;
-    }
-
-    FILE * f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Signature
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(header);
-
-    if (header != 0x32424457)
-    {
-        fclose(f);
-        return false;                                       //'WDB2'
-    }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                 // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                 // Number of fields
-    {
-        fclose(f);
+    if (pos + sizeof(T) > end)
         return false;
-    }
 
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                 // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                 // String size
-    {
-        fclose(f);
-        return false;
-    }
+    memcpy(&value, pos, sizeof(T));
+    EndianConvert(value);
+    pos += sizeof(T);
+    return true;
+}
 
-    EndianConvert(stringSize);
+// Same as DBCFileLoader, records are read straight from the read only mapping
+bool DB2FileLoader::Load(const char *filename, const char *fmt)
+{
+    Unload();
 
-    /* NEW WDB2 FIELDS*/
-    if (fread(&tableHash, 4, 1, f) != 1)                  // Table hash
+    mappedFile = new ACE_Mem_Map();
+    if (mappedFile->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(tableHash);
+    unsigned char const* pos = static_cast<unsigned char const*>(mappedFile->addr());
+    unsigned char const* end = pos + mappedFile->size();
 
-    if (fread(&build, 4, 1, f) != 1)                     // Build
+    uint32 header;
+    if (!ReadHeaderField(pos, end, header) || header != 0x32424457)     //'WDB2'
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(build);
-
-    if (fread(&unk1, 4, 1, f) != 1)                     // Unknown WDB2
+    if (!ReadHeaderField(pos, end, recordCount) ||           // Number of records
+        !ReadHeaderField(pos, end, fieldCount) ||            // Number of fields
+        !ReadHeaderField(pos, end, recordSize) ||            // Size of a record
+        !ReadHeaderField(pos, end, stringSize) ||            // String size
+        /* NEW WDB2 FIELDS*/
+        !ReadHeaderField(pos, end, tableHash) ||             // Table hash
+        !ReadHeaderField(pos, end, build) ||                 // Build
+        !ReadHeaderField(pos, end, unk1))                    // Unknown WDB2
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(unk1);
-
+    unk2 = 0;
+    maxIndex = 0;
     if (build > 12880)
     {
-        if (fread(&unk2, 4, 1, f) != 1)                // Unknown WDB2
+        if (!ReadHeaderField(pos, end, unk2) ||              // Unknown WDB2
+            !ReadHeaderField(pos, end, maxIndex) ||          // MaxIndex WDB2
+            !ReadHeaderField(pos, end, locale) ||            // Locales
+            !ReadHeaderField(pos, end, unk5))                // Unknown WDB2
         {
-            fclose(f);
+            Unload();
             return false;
         }
-        EndianConvert(unk2);
-
-        if (fread(&maxIndex, 4, 1, f) != 1)                           // MaxIndex WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(maxIndex);
-
-        if (fread(&locale, 4, 1, f) != 1)                             // Locales
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(locale);
-
-        if (fread(&unk5, 4, 1, f) != 1)                               // Unknown WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(unk5);
     }
 
     if (maxIndex != 0)
     {
         int32 diff = maxIndex - unk2 + 1;
-        fseek(f, diff * 4 + diff * 2, SEEK_CUR);    // diff * 4: an index for rows, diff * 2: a memory allocation bank
+        pos += diff * 4 + diff * 2;                         // diff * 4: an index for rows, diff * 2: a memory allocation bank
+    }
+
+    if (pos > end || size_t(end - pos) < size_t(recordSize) * recordCount + stringSize)
+    {
+        Unload();
+        return false;
     }
 
     fieldsOffset = new uint32[fieldCount];
@@ -160,25 +116,34 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
+    data = const_cast<unsigned char*>(pos);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
+    return true;
+}
+
+void DB2FileLoader::Unload()
+{
+    if (mappedFile)
     {
-        fclose(f);
-        return false;
+        mappedFile->close();
+        delete mappedFile;
+        mappedFile = NULL;
     }
 
-    fclose(f);
-    return true;
+    if (fieldsOffset)
+    {
+        delete [] fieldsOffset;
+        fieldsOffset = NULL;
+    }
+
+    data = NULL;
+    stringTable = NULL;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if (data)
-        delete [] data;
-    if (fieldsOffset)
-        delete [] fieldsOffset;
+    Unload();
 }
 
 DB2FileLoader::Record DB2FileLoader::getRecord(size_t id)
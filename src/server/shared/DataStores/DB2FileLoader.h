@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 class DB2FileLoader
 {
     public:
@@ -29,6 +31,7 @@ class DB2FileLoader
         ~DB2FileLoader();
 
     bool Load(const char *filename, const char *fmt);
+    void Unload();
 
     class Record
     {
@@ -89,8 +92,9 @@ private:
     uint32 fieldCount;
     uint32 stringSize;
     uint32 *fieldsOffset;
-    unsigned char *data;
+    unsigned char *data;                                    // points into mappedFile, read only
     unsigned char *stringTable;
+    ACE_Mem_Map *mappedFile;
 
     // WDB2 / WCH2 fields
     uint32 tableHash;    // WDB2
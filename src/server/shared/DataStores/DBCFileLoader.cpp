@@ -23,70 +23,62 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : fieldsOffset(NULL), data(NULL), stringTable(NULL)
+#include <ace/Mem_Map.h>
+
+DBCFileLoader::DBCFileLoader() : fieldsOffset(NULL), data(NULL), stringTable(NULL), mappedFile(NULL)
 {
 }
 
-bool DBCFileLoader::Load(const char* filename, const char* fmt)
+template<class T>
+static bool ReadHeaderField(unsigned char const*& pos, unsigned char const* end, T& value)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
+    if (pos + sizeof(T) > end)
         return false;
-    }
-
 
-    EndianConvert(header);
+    memcpy(&value, pos, sizeof(T));
+    EndianConvert(value);
+    pos += sizeof(T);
+    return true;
+}
 
-    if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
-        return false;
-    }
+// The file is mapped read only instead of read into a heap buffer: records are only read
+// while producing the storage tables and pages stay shared in the system file cache
+bool DBCFileLoader::Load(const char* filename, const char* fmt)
+{
+    Unload();
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    mappedFile = new ACE_Mem_Map();
+    if (mappedFile->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(recordCount);
+    unsigned char const* pos = static_cast<unsigned char const*>(mappedFile->addr());
+    unsigned char const* end = pos + mappedFile->size();
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
+    uint32 header;
+    if (!ReadHeaderField(pos, end, header) || header != 0x43424457)     //'WDBC'
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
+    if (!ReadHeaderField(pos, end, recordCount) ||           // Number of records
+        !ReadHeaderField(pos, end, fieldCount) ||            // Number of fields
+        !ReadHeaderField(pos, end, recordSize) ||            // Size of a record
+        !ReadHeaderField(pos, end, stringSize))              // String size
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
+    if (size_t(end - pos) < size_t(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(stringSize);
-
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -98,27 +90,34 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = const_cast<unsigned char*>(pos);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
+    return true;
+}
+
+void DBCFileLoader::Unload()
+{
+    if (mappedFile)
     {
-        fclose(f);
-        return false;
+        mappedFile->close();
+        delete mappedFile;
+        mappedFile = NULL;
     }
 
-    fclose(f);
+    if (fieldsOffset)
+    {
+        delete [] fieldsOffset;
+        fieldsOffset = NULL;
+    }
 
-    return true;
+    data = NULL;
+    stringTable = NULL;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
-
-    if (fieldsOffset)
-        delete [] fieldsOffset;
+    Unload();
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 class DBCFileLoader
 {
     public:
@@ -29,6 +31,7 @@ class DBCFileLoader
         ~DBCFileLoader();
 
         bool Load(const char *filename, const char *fmt);
+        void Unload();
 
         class Record
         {
@@ -89,7 +92,8 @@ class DBCFileLoader
         uint32 fieldCount;
         uint32 stringSize;
         uint32 *fieldsOffset;
-        unsigned char *data;
+        unsigned char *data;                                // points into mappedFile, read only
         unsigned char *stringTable;
+        ACE_Mem_Map *mappedFile;
 };
 #endif
@@ -265,6 +265,44 @@ class DatabaseWorkerPool
             return Query(szQuery);
         }
 
+        //! Executes an SQL query in string format and reads its rows from the server one at a time while they are iterated,
+        //! instead of buffering the whole result set first. Meant for the bulk loaders of big tables.
+        //! The connection stays locked until the last row is read, no other synch query may run on this thread meanwhile.
+        //! name is only used in the throughput report logged at the end.
+        StreamedQueryResult StreamQuery(char const* name, const char* sql)
+        {
+            T* t = GetFreeConnection();
+            StreamedResultSet* result = t->StreamQuery(sql, name);
+            if (!result)
+            {
+                t->Unlock();
+                return StreamedQueryResult(NULL);
+            }
+
+            //! An empty result releases the connection in NextRow()
+            if (!result->NextRow())
+            {
+                delete result;
+                return StreamedQueryResult(NULL);
+            }
+            return StreamedQueryResult(result);
+        }
+
+        //! Streaming version of PQuery, see StreamQuery.
+        StreamedQueryResult PStreamQuery(char const* name, const char* sql, ...)
+        {
+            if (!sql)
+                return StreamedQueryResult(NULL);
+
+            va_list ap;
+            char szQuery[MAX_QUERY_LEN];
+            va_start(ap, sql);
+            vsnprintf(szQuery, MAX_QUERY_LEN, sql, ap);
+            va_end(ap);
+
+            return StreamQuery(name, szQuery);
+        }
+
         //! Directly executes an SQL query in prepared format that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         //! Statement must be prepared with CONNECTION_SYNCH flag.
@@ -22,6 +22,7 @@ Field::Field()
     data.value = NULL;
     data.type = MYSQL_TYPE_NULL;
     data.length = 0;
+    data.owned = true;
 }
 
 Field::~Field()
@@ -68,3 +69,16 @@ void Field::SetStructuredValue(char* newValue, enum_field_types newType, uint32
     data.type = newType;
     data.raw = false;
 }
+
+void Field::SetStreamedValue(char* newValue, enum_field_types newType, uint32 length)
+{
+    if (data.value)
+        CleanUp();
+
+    // mysql_fetch_row() values are null terminated and stay valid until the next row is fetched, no need to copy them
+    data.value = newValue;
+    data.length = length;
+    data.type = newType;
+    data.raw = false;
+    data.owned = false;
+}
@@ -27,6 +27,7 @@ class Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class StreamedResultSet;
 
     public:
 
@@ -271,6 +272,7 @@ class Field
             void* value;            // Actual data in memory
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
+            bool owned;             // value is our own copy, streamed fields point into the client library's row
          } data;
         #if defined(__GNUC__)
         #pragma pack()
@@ -280,11 +282,14 @@ class Field
 
         void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
         void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length, bool isBinary);
+        void SetStreamedValue(char* newValue, enum_field_types newType, uint32 length);
 
         void CleanUp()
         {
-            delete[] ((char*)data.value);
+            if (data.owned)
+                delete[] ((char*)data.value);
             data.value = NULL;
+            data.owned = true;
         }
 
         static size_t SizeForType(MYSQL_FIELD* field)
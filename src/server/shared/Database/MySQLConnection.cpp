@@ -308,6 +308,31 @@ ResultSet* MySQLConnection::Query(const char* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
+StreamedResultSet* MySQLConnection::StreamQuery(const char* sql, char const* name)
+{
+    if (!m_Mysql || !sql)
+        return NULL;
+
+    if (mysql_query(m_Mysql, sql))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_INFO("sql", "SQL: %s", sql);
+        TC_LOG_ERROR("sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql, name);  // We try again
+
+        return NULL;
+    }
+
+    // unlike mysql_store_result() nothing is read yet, the rows are fetched from the socket one by one
+    MYSQL_RES* result = mysql_use_result(m_Mysql);
+    if (!result)
+        return NULL;
+
+    return new StreamedResultSet(this, result, mysql_fetch_fields(result), mysql_field_count(m_Mysql), name);
+}
+
 bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
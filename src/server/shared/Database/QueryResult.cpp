@@ -234,3 +234,85 @@ void PreparedResultSet::FreeBindBuffer()
     for (uint32 i = 0; i < m_fieldCount; ++i)
         free (m_rBind[i].buffer);
 }
+
+StreamedResultSet::StreamedResultSet(MySQLConnection* connection, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, char const* name) :
+_connection(connection),
+_result(result),
+_fields(fields),
+_fieldCount(fieldCount),
+_name(name),
+_rowCount(0),
+_totalSize(0),
+_maxRowSize(0),
+_startTime(getMSTime()),
+_error(false)
+{
+    _currentRow = new Field[_fieldCount];
+}
+
+StreamedResultSet::~StreamedResultSet()
+{
+    CleanUp();
+    delete [] _currentRow;
+}
+
+bool StreamedResultSet::NextRow()
+{
+    if (!_result)
+        return false;
+
+    MYSQL_ROW row = mysql_fetch_row(_result);
+    if (!row)
+    {
+        if (uint32 lErrno = mysql_errno(_connection->GetHandle()))
+        {
+            TC_LOG_ERROR("sql", "[%u] %s while streaming '%s', only " UI64FMTD " rows read", lErrno, mysql_error(_connection->GetHandle()), _name.c_str(), _rowCount);
+            _error = true;
+        }
+
+        CleanUp();
+        return false;
+    }
+
+    unsigned long* lengths = mysql_fetch_lengths(_result);
+    if (!lengths)
+    {
+        TC_LOG_WARN("sql", "%s:mysql_fetch_lengths, cannot retrieve value lengths. Error %s.", __FUNCTION__, mysql_error(_connection->GetHandle()));
+        _error = true;
+        CleanUp();
+        return false;
+    }
+
+    uint32 rowSize = 0;
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        _currentRow[i].SetStreamedValue(row[i], _fields[i].type, lengths[i]);
+        rowSize += lengths[i];
+    }
+
+    ++_rowCount;
+    _totalSize += rowSize;
+    if (rowSize > _maxRowSize)
+        _maxRowSize = rowSize;
+
+    return true;
+}
+
+void StreamedResultSet::CleanUp()
+{
+    if (!_result)
+        return;
+
+    // the fields point into the row freed here
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].CleanUp();
+
+    // also reads and drops the rows left when the caller stops early
+    mysql_free_result(_result);
+    _result = NULL;
+    _connection->Unlock();
+
+    uint32 duration = GetMSTimeDiffToNow(_startTime);
+    TC_LOG_INFO("sql", ">> Streamed " UI64FMTD " rows of %s in %u ms (" UI64FMTD " rows/s), " UI64FMTD " KB read, at most %u bytes held at once",
+        _rowCount, _name.c_str(), duration, duration ? _rowCount * IN_MILLISECONDS / duration : _rowCount, _totalSize / 1024, _maxRowSize);
+}
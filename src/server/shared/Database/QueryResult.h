@@ -30,6 +30,8 @@
 #endif
 #include <mysql.h>
 
+class MySQLConnection;
+
 class ResultSet
 {
     public:
@@ -105,5 +107,51 @@ class PreparedResultSet
 
 typedef Trinity::AutoPtr<PreparedResultSet, ACE_Thread_Mutex> PreparedQueryResult;
 
+/*
+ * Result of a string query read from the server row by row (mysql_use_result) instead of
+ * being buffered whole first, for the bulk loaders of big tables. The fields point into the
+ * client library's current row and are only valid until the next NextRow() call.
+ *
+ * The connection stays locked until the last row is read or the result is destroyed, the
+ * thread reading it must not run synch queries on the same database meanwhile.
+ */
+class StreamedResultSet
+{
+    public:
+        StreamedResultSet(MySQLConnection* connection, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, char const* name);
+        ~StreamedResultSet();
+
+        bool NextRow();
+        uint64 GetRowCount() const { return _rowCount; }    // rows read so far, the total is unknown until the end
+        // the stream broke before its last row, the rows read are only a part of the table
+        bool HasError() const { return _error; }
+        uint32 GetFieldCount() const { return _fieldCount; }
+
+        Field* Fetch() const { return _currentRow; }
+        const Field & operator [] (uint32 index) const
+        {
+            ASSERT(index < _fieldCount);
+            return _currentRow[index];
+        }
+
+    private:
+        void CleanUp();
+
+        MySQLConnection* _connection;
+        MYSQL_RES* _result;
+        MYSQL_FIELD* _fields;
+        Field* _currentRow;
+        uint32 _fieldCount;
+        std::string _name;
+
+        uint64 _rowCount;
+        uint64 _totalSize;      // bytes a buffered ResultSet would have held
+        uint32 _maxRowSize;     // bytes held at once while streaming
+        uint32 _startTime;
+        bool _error;
+};
+
+typedef Trinity::AutoPtr<StreamedResultSet, ACE_Thread_Mutex> StreamedQueryResult;
+
 #endif
 
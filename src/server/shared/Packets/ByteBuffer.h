@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Debugging/Errors.h"
 #include "Log.h"
+#include "PacketPool.h"
 #include "Utilities/ByteConverter.h"
 #include <ace/OS_NS_time.h>
 #include <time.h>
@@ -839,7 +840,7 @@ class ByteBuffer
             return _bitpos;
         }
 
-        std::vector<uint8>& _GetStorage() { return _storage; }
+        PacketStorage& _GetStorage() { return _storage; }
 
         DEFINE_READGUIDMASK(BITS_1, BIT_VALS_1)
         DEFINE_READGUIDMASK(BITS_2, BIT_VALS_2)
@@ -880,7 +881,7 @@ class ByteBuffer
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
-        std::vector<uint8> _storage;
+        PacketStorage _storage;
 };
 
 template <typename T>
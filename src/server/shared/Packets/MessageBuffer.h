@@ -19,11 +19,12 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include "PacketPool.h"
 #include <vector>
 
 class MessageBuffer
 {
-    typedef std::vector<uint8>::size_type size_type;
+    typedef PacketStorage::size_type size_type;
 
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
@@ -90,7 +91,7 @@ public:
         }
     }
 
-    std::vector<uint8>&& Move()
+    PacketStorage&& Move()
     {
         _wpos = 0;
         _rpos = 0;
@@ -124,7 +125,7 @@ public:
 private:
     size_type _wpos;
     size_type _rpos;
-    std::vector<uint8> _storage;
+    PacketStorage _storage;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
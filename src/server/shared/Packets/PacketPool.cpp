@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketPool.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+    // the first bytes of a free block point to the next one
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    inline uint32 GetSizeClass(std::size_t size)
+    {
+        uint32 sizeClass = 0;
+        for (std::size_t classSize = PACKET_POOL_MIN_SIZE; classSize < size; classSize <<= 1)
+            ++sizeClass;
+
+        return sizeClass;
+    }
+
+    inline std::size_t GetClassSize(uint32 sizeClass)
+    {
+        return std::size_t(PACKET_POOL_MIN_SIZE) << sizeClass;
+    }
+
+    inline void FreeChain(FreeBlock* block)
+    {
+        while (block)
+        {
+            FreeBlock* next = block->Next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    // set once the cache of the thread is destroyed, packets freed after that go to the heap
+    thread_local bool threadCacheGone = false;
+}
+
+struct PacketPoolThreadCache
+{
+    PacketPoolThreadCache() : Counters(sPacketPool->RegisterThread())
+    {
+        for (uint32 i = 0; i < PACKET_POOL_CLASSES; ++i)
+        {
+            Lists[i] = NULL;
+            Counts[i] = 0;
+        }
+    }
+
+    ~PacketPoolThreadCache()
+    {
+        for (uint32 i = 0; i < PACKET_POOL_CLASSES; ++i)
+            FreeChain(Lists[i]);
+
+        threadCacheGone = true;
+    }
+
+    void* Allocate(uint32 sizeClass)
+    {
+        if (!Lists[sizeClass])
+        {
+            void* batch = sPacketPool->PopBatch(sizeClass);
+            if (!batch)
+            {
+                Counters->HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(GetClassSize(sizeClass));
+            }
+
+            Lists[sizeClass] = static_cast<FreeBlock*>(batch);
+            Counts[sizeClass] = PACKET_POOL_BATCH;
+            Counters->DepotHits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        FreeBlock* block = Lists[sizeClass];
+        Lists[sizeClass] = block->Next;
+        --Counts[sizeClass];
+        Counters->ThreadHits.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    void Free(void* freed, uint32 sizeClass)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(freed);
+        block->Next = Lists[sizeClass];
+        Lists[sizeClass] = block;
+
+        if (++Counts[sizeClass] < PACKET_POOL_THREAD_BLOCKS)
+            return;
+
+        // the blocks freed last are still in the cpu cache and stay, the older ones go
+        FreeBlock* last = block;
+        for (uint32 i = 1; i < PACKET_POOL_THREAD_BLOCKS - PACKET_POOL_BATCH; ++i)
+            last = last->Next;
+
+        FreeBlock* batch = last->Next;
+        last->Next = NULL;
+        Counts[sizeClass] -= PACKET_POOL_BATCH;
+
+        if (sPacketPool->PushBatch(sizeClass, batch))
+            Counters->DepotReturns.fetch_add(1, std::memory_order_relaxed);
+        else
+        {
+            FreeChain(batch);
+            Counters->HeapFrees.fetch_add(PACKET_POOL_BATCH, std::memory_order_relaxed);
+        }
+    }
+
+    FreeBlock* Lists[PACKET_POOL_CLASSES];
+    uint32 Counts[PACKET_POOL_CLASSES];
+    PacketPoolCounters* Counters;
+};
+
+static PacketPoolThreadCache* GetThreadCache()
+{
+    static thread_local PacketPoolThreadCache cache;
+    return &cache;
+}
+
+PacketPool::PacketPool()
+{
+    // the depots never allocate under their lock
+    for (uint32 i = 0; i < PACKET_POOL_CLASSES; ++i)
+        _depots[i].Batches.reserve(PACKET_POOL_DEPOT_BYTES / (PACKET_POOL_BATCH * GetClassSize(i)) + 1);
+}
+
+PacketPool* PacketPool::instance()
+{
+    static PacketPool* pool = new PacketPool();
+    return pool;
+}
+
+void* PacketPool::Allocate(std::size_t size)
+{
+    // the block may still be freed into a size class by another thread, it has to be as large as the class
+    if (threadCacheGone)
+        return ::operator new(size <= PACKET_POOL_MAX_SIZE ? GetClassSize(GetSizeClass(size)) : size);
+
+    PacketPoolThreadCache* cache = GetThreadCache();
+    cache->Counters->Allocations.fetch_add(1, std::memory_order_relaxed);
+    cache->Counters->Bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (size > PACKET_POOL_MAX_SIZE)
+    {
+        cache->Counters->HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    return cache->Allocate(GetSizeClass(size));
+}
+
+void PacketPool::Free(void* block, std::size_t size)
+{
+    if (!block)
+        return;
+
+    if (threadCacheGone)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    PacketPoolThreadCache* cache = GetThreadCache();
+    cache->Counters->Frees.fetch_add(1, std::memory_order_relaxed);
+
+    if (size > PACKET_POOL_MAX_SIZE)
+    {
+        cache->Counters->HeapFrees.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(block);
+        return;
+    }
+
+    cache->Free(block, GetSizeClass(size));
+}
+
+PacketPoolCounters* PacketPool::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    _threads.push_back(std::unique_ptr<PacketPoolCounters>(new PacketPoolCounters()));
+    return _threads.back().get();
+}
+
+bool PacketPool::PushBatch(uint32 sizeClass, void* batch)
+{
+    Depot& depot = _depots[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.Lock);
+
+    if ((depot.Batches.size() + 1) * PACKET_POOL_BATCH * GetClassSize(sizeClass) > PACKET_POOL_DEPOT_BYTES)
+        return false;
+
+    depot.Batches.push_back(batch);
+    return true;
+}
+
+void* PacketPool::PopBatch(uint32 sizeClass)
+{
+    Depot& depot = _depots[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.Lock);
+
+    if (depot.Batches.empty())
+        return NULL;
+
+    void* batch = depot.Batches.back();
+    depot.Batches.pop_back();
+    return batch;
+}
+
+std::vector<PacketPoolStats> PacketPool::GetThreadStats() const
+{
+    std::vector<PacketPoolStats> stats;
+
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    stats.reserve(_threads.size());
+    for (size_t i = 0; i < _threads.size(); ++i)
+    {
+        PacketPoolCounters const& counters = *_threads[i];
+
+        PacketPoolStats thread;
+        thread.Thread = uint32(i);
+        thread.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+        thread.Bytes = counters.Bytes.load(std::memory_order_relaxed);
+        thread.ThreadHits = counters.ThreadHits.load(std::memory_order_relaxed);
+        thread.DepotHits = counters.DepotHits.load(std::memory_order_relaxed);
+        thread.HeapAllocations = counters.HeapAllocations.load(std::memory_order_relaxed);
+        thread.Frees = counters.Frees.load(std::memory_order_relaxed);
+        thread.DepotReturns = counters.DepotReturns.load(std::memory_order_relaxed);
+        thread.HeapFrees = counters.HeapFrees.load(std::memory_order_relaxed);
+        stats.push_back(thread);
+    }
+
+    return stats;
+}
+
+PacketPoolStats PacketPool::GetStats() const
+{
+    PacketPoolStats total;
+    memset(&total, 0, sizeof(total));
+
+    std::vector<PacketPoolStats> threads = GetThreadStats();
+    total.Thread = uint32(threads.size());
+    for (PacketPoolStats const& thread : threads)
+    {
+        total.Allocations += thread.Allocations;
+        total.Bytes += thread.Bytes;
+        total.ThreadHits += thread.ThreadHits;
+        total.DepotHits += thread.DepotHits;
+        total.HeapAllocations += thread.HeapAllocations;
+        total.Frees += thread.Frees;
+        total.DepotReturns += thread.DepotReturns;
+        total.HeapFrees += thread.HeapFrees;
+    }
+
+    return total;
+}
+
+uint64 PacketPool::GetDepotBytes() const
+{
+    uint64 bytes = 0;
+    for (uint32 i = 0; i < PACKET_POOL_CLASSES; ++i)
+    {
+        std::lock_guard<std::mutex> lock(_depots[i].Lock);
+        bytes += uint64(_depots[i].Batches.size()) * PACKET_POOL_BATCH * GetClassSize(i);
+    }
+
+    return bytes;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PACKETPOOL_H
+#define TRINITY_PACKETPOOL_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define PACKET_POOL_MIN_SIZE            64                  // bytes of the smallest size class
+#define PACKET_POOL_CLASSES             9                   // 64 bytes to 16 KB, doubling
+#define PACKET_POOL_MAX_SIZE            (PACKET_POOL_MIN_SIZE << (PACKET_POOL_CLASSES - 1))
+#define PACKET_POOL_BATCH               32                  // blocks moved between a thread and the depot at once
+#define PACKET_POOL_THREAD_BLOCKS       64                  // free blocks of a class a thread keeps, a batch goes to the depot above
+#define PACKET_POOL_DEPOT_BYTES         (4 * 1024 * 1024)   // free bytes of a class kept in the depot, the rest goes back to the heap
+
+struct PacketPoolCounters
+{
+    PacketPoolCounters() : Allocations(0), Bytes(0), ThreadHits(0), DepotHits(0), HeapAllocations(0), Frees(0), DepotReturns(0), HeapFrees(0) { }
+
+    std::atomic<uint64> Allocations;
+    std::atomic<uint64> Bytes;                              // requested
+    std::atomic<uint64> ThreadHits;                         // taken from the free list of the thread
+    std::atomic<uint64> DepotHits;                          // batches taken from the depot
+    std::atomic<uint64> HeapAllocations;                    // pools empty or too big for a class
+    std::atomic<uint64> Frees;
+    std::atomic<uint64> DepotReturns;                       // batches given to the depot
+    std::atomic<uint64> HeapFrees;                          // pools full or too big for a class
+};
+
+struct PacketPoolStats
+{
+    uint32 Thread;                                          // in the order the threads first allocated
+    uint64 Allocations;
+    uint64 Bytes;
+    uint64 ThreadHits;
+    uint64 DepotHits;
+    uint64 HeapAllocations;
+    uint64 Frees;
+    uint64 DepotReturns;
+    uint64 HeapFrees;
+};
+
+/*
+ * Size-classed block pool behind the storage of ByteBuffer and WorldPacket.
+ *
+ * Every thread keeps free lists of the blocks it freed and takes from them
+ * without a lock. Packets are mostly built on the map threads and freed on
+ * the network threads, or the other way around for the client packets, so
+ * a thread with too many free blocks gives a batch of them to the shared
+ * depot and a thread without any takes a batch back: one lock per batch.
+ * Blocks bigger than the largest class come from the heap.
+ *
+ * Never destroyed, packets are still freed by static destructors at exit.
+ */
+class PacketPool
+{
+    friend struct PacketPoolThreadCache;
+
+    private:
+        PacketPool();
+        ~PacketPool() { }
+
+    public:
+        static PacketPool* instance();
+
+        static void* Allocate(std::size_t size);
+        static void Free(void* block, std::size_t size);
+
+        PacketPoolStats GetStats() const;                   // all threads, Thread is their count
+        std::vector<PacketPoolStats> GetThreadStats() const;
+        uint64 GetDepotBytes() const;
+
+    private:
+        PacketPoolCounters* RegisterThread();
+
+        // a chain of PACKET_POOL_BATCH free blocks, false when the depot is full
+        bool PushBatch(uint32 sizeClass, void* batch);
+        void* PopBatch(uint32 sizeClass);
+
+        struct Depot
+        {
+            std::vector<void*> Batches;                     // chains of PACKET_POOL_BATCH blocks
+            mutable std::mutex Lock;
+        };
+
+        Depot _depots[PACKET_POOL_CLASSES];
+
+        std::vector<std::unique_ptr<PacketPoolCounters>> _threads;  // never shrinks, counters outlive their thread
+        mutable std::mutex _threadsLock;
+};
+
+#define sPacketPool PacketPool::instance()
+
+// std allocator over the pool, for the storage vectors of the packet buffers
+template <typename T>
+class PacketAllocator
+{
+    public:
+        typedef T value_type;
+
+        PacketAllocator() { }
+        template <typename U> PacketAllocator(PacketAllocator<U> const&) { }
+
+        T* allocate(std::size_t count) { return static_cast<T*>(PacketPool::Allocate(count * sizeof(T))); }
+        void deallocate(T* block, std::size_t count) { PacketPool::Free(block, count * sizeof(T)); }
+};
+
+template <typename T, typename U>
+inline bool operator==(PacketAllocator<T> const&, PacketAllocator<U> const&) { return true; }
+
+template <typename T, typename U>
+inline bool operator!=(PacketAllocator<T> const&, PacketAllocator<U> const&) { return false; }
+
+typedef std::vector<uint8, PacketAllocator<uint8>> PacketStorage;
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SPSC_QUEUE_H
+#define _SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/*
+ * Bounded lock-free queue for one producer thread and one consumer thread.
+ *
+ * Push() must only be called by the producer, Peek()/Pop() only by the consumer.
+ * Several threads may take the consumer role one after another, as long as
+ * something else (a lock, a thread join) orders their accesses.
+ */
+template <typename T, std::size_t Capacity>
+class SPSCQueue
+{
+    static_assert(Capacity && !(Capacity & (Capacity - 1)), "SPSCQueue capacity must be a power of two");
+
+    public:
+        SPSCQueue() : _head(0), _tail(0) { }
+
+        // returns false if the queue is full
+        bool Push(T const& value)
+        {
+            std::size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) == Capacity)
+                return false;
+
+            _items[tail & (Capacity - 1)] = value;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // the oldest value, nullptr if the queue is empty
+        T* Peek()
+        {
+            std::size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire))
+                return nullptr;
+
+            return &_items[head & (Capacity - 1)];
+        }
+
+        bool Pop(T& value)
+        {
+            T* front = Peek();
+            if (!front)
+                return false;
+
+            value = *front;
+            _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+        // exact only when called by the consumer or the producer
+        std::size_t Size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+
+    private:
+        // producer and consumer indexes on their own cache lines
+        std::atomic<std::size_t> _head;
+        char _headPadding[64 - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> _tail;
+        char _tailPadding[64 - sizeof(std::atomic<std::size_t>)];
+        T _items[Capacity];
+};
+
+#endif
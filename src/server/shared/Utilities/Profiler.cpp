@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+#include "Config.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+std::atomic<bool> Profiler::_enabled(false);
+
+void ProfileCounter::Add(uint32 time)
+{
+    Time.fetch_add(time, std::memory_order_relaxed);
+    TickTime.fetch_add(time, std::memory_order_relaxed);
+    Calls.fetch_add(1, std::memory_order_relaxed);
+    TickCalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (time > MaxTime.load(std::memory_order_relaxed))
+        MaxTime.store(time, std::memory_order_relaxed);     // only the owner thread adds
+}
+
+void ProfileCounter::Reset()
+{
+    Time = 0;
+    Calls = 0;
+    MaxTime = 0;
+}
+
+void ProfileScope::Enter(char const* name, ProfileCategory category, uint32 key)
+{
+    _thread = Profiler::GetThreadData();
+    _parent = _thread->Current;
+    _key = category != PROFILE_NONE ? (uint64(category) << 32) | key : 0;
+
+    // only this thread adds children, it can look them up without the lock
+    std::vector<std::pair<char const*, uint32>>& children = _thread->Nodes[_parent].Children;
+    _node = 0;
+    for (std::pair<char const*, uint32> const& child : children)
+    {
+        if (child.first == name)
+        {
+            _node = child.second;
+            break;
+        }
+    }
+
+    if (!_node)
+    {
+        std::lock_guard<std::mutex> lock(_thread->Lock);
+        _node = uint32(_thread->Nodes.size());
+        _thread->Nodes.emplace_back(name, _parent);
+        children.push_back(std::make_pair(name, _node));
+    }
+
+    _thread->Current = _node;
+    _start = getUSTime();
+}
+
+void ProfileScope::Exit()
+{
+    uint32 time = uint32(getUSTime() - _start);
+
+    _thread->Nodes[_node].Counter.Add(time);
+    _thread->Current = _parent;
+
+    if (!_key)
+        return;
+
+    std::unordered_map<uint64, ProfileCounter>::iterator itr = _thread->Keys.find(_key);
+    if (itr == _thread->Keys.end())
+    {
+        std::lock_guard<std::mutex> lock(_thread->Lock);
+        itr = _thread->Keys.emplace(std::piecewise_construct, std::forward_as_tuple(_key), std::forward_as_tuple()).first;
+    }
+
+    itr->second.Add(time);
+}
+
+Profiler::Profiler() : _spikeThreshold(0), _lastSpikeExport(0), _spikes(0)
+{
+    _logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!_logsDir.empty())
+        if ((_logsDir.at(_logsDir.length() - 1) != '/') && (_logsDir.at(_logsDir.length() - 1) != '\\'))
+            _logsDir.push_back('/');
+}
+
+void Profiler::Start()
+{
+    if (_enabled.exchange(true))
+        return;
+
+    Reset();
+    TC_LOG_INFO("server", "Profiler: started, spike threshold %u ms", uint32(_spikeThreshold));
+}
+
+void Profiler::Stop()
+{
+    if (_enabled.exchange(false))
+        TC_LOG_INFO("server", "Profiler: stopped");
+}
+
+ProfileThreadData* Profiler::GetThreadData()
+{
+    static thread_local ProfileThreadData* threadData = NULL;
+    if (!threadData)
+    {
+        Profiler* profiler = sProfiler;
+        std::lock_guard<std::mutex> lock(profiler->_threadsLock);
+        profiler->_threads.push_back(std::unique_ptr<ProfileThreadData>(new ProfileThreadData()));
+        threadData = profiler->_threads.back().get();
+    }
+
+    return threadData;
+}
+
+void Profiler::EndTick(uint32 tickTime)
+{
+    if (!IsEnabled())
+        return;
+
+    uint32 threshold = _spikeThreshold;
+    if (threshold && tickTime >= threshold)
+    {
+        ++_spikes;
+
+        time_t now = time(NULL);
+        if (now >= _lastSpikeExport + PROFILER_SPIKE_EXPORT_GAP)
+        {
+            _lastSpikeExport = now;
+
+            std::ostringstream name;
+            name << "profile_spike_" << uint64(now) << "_" << tickTime << "ms";
+            if (WriteFiles(name.str(), true))
+                TC_LOG_INFO("server", "Profiler: tick of %u ms exported to %s%s.folded", tickTime, _logsDir.c_str(), name.str().c_str());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    for (std::unique_ptr<ProfileThreadData> const& thread : _threads)
+    {
+        std::lock_guard<std::mutex> threadLock(thread->Lock);
+        for (ProfileNode& node : thread->Nodes)
+        {
+            node.Counter.TickTime.store(0, std::memory_order_relaxed);
+            node.Counter.TickCalls.store(0, std::memory_order_relaxed);
+        }
+        for (std::pair<uint64 const, ProfileCounter>& key : thread->Keys)
+        {
+            key.second.TickTime.store(0, std::memory_order_relaxed);
+            key.second.TickCalls.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::string Profiler::Export()
+{
+    std::ostringstream name;
+    name << "profile_" << uint64(time(NULL));
+
+    if (!WriteFiles(name.str(), false))
+        return "";
+
+    Reset();
+    _lastExport = _logsDir + name.str() + ".folded";
+    return _lastExport;
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    for (std::unique_ptr<ProfileThreadData> const& thread : _threads)
+    {
+        std::lock_guard<std::mutex> threadLock(thread->Lock);
+        for (ProfileNode& node : thread->Nodes)
+            node.Counter.Reset();
+        for (std::pair<uint64 const, ProfileCounter>& key : thread->Keys)
+            key.second.Reset();
+    }
+}
+
+std::vector<std::pair<std::string, uint64>> Profiler::GetStacks(bool tick)
+{
+    // the same stack on several threads is merged, map updates run on any pool thread
+    std::map<std::string, uint64> stacks;
+
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    for (std::unique_ptr<ProfileThreadData> const& thread : _threads)
+    {
+        std::lock_guard<std::mutex> threadLock(thread->Lock);
+        for (uint32 i = 1; i < thread->Nodes.size(); ++i)
+        {
+            ProfileNode const& node = thread->Nodes[i];
+
+            // folded stacks hold the time spent in a frame itself, the tools add the children
+            uint64 time = tick ? node.Counter.TickTime.load() : node.Counter.Time.load();
+            for (std::pair<char const*, uint32> const& child : node.Children)
+            {
+                ProfileCounter const& counter = thread->Nodes[child.second].Counter;
+                time -= std::min<uint64>(time, tick ? counter.TickTime.load() : counter.Time.load());
+            }
+
+            if (!time)
+                continue;
+
+            std::string stack = node.Name;
+            for (uint32 parent = node.Parent; parent; parent = thread->Nodes[parent].Parent)
+                stack = std::string(thread->Nodes[parent].Name) + ";" + stack;
+
+            stacks[stack] += time;
+        }
+    }
+
+    std::vector<std::pair<std::string, uint64>> sorted(stacks.begin(), stacks.end());
+    std::sort(sorted.begin(), sorted.end(), [](std::pair<std::string, uint64> const& left, std::pair<std::string, uint64> const& right)
+    {
+        return left.second > right.second;
+    });
+
+    return sorted;
+}
+
+std::vector<ProfileKeyStats> Profiler::GetKeyStats(ProfileCategory category, bool tick)
+{
+    std::unordered_map<uint32, ProfileKeyStats> keys;
+
+    std::lock_guard<std::mutex> lock(_threadsLock);
+    for (std::unique_ptr<ProfileThreadData> const& thread : _threads)
+    {
+        std::lock_guard<std::mutex> threadLock(thread->Lock);
+        for (std::pair<uint64 const, ProfileCounter> const& itr : thread->Keys)
+        {
+            if (ProfileCategory(itr.first >> 32) != category)
+                continue;
+
+            uint64 time = tick ? itr.second.TickTime.load() : itr.second.Time.load();
+            if (!time)
+                continue;
+
+            ProfileKeyStats& stats = keys[uint32(itr.first)];
+            stats.Key = uint32(itr.first);
+            stats.Time += time;
+            stats.Calls += tick ? itr.second.TickCalls.load() : itr.second.Calls.load();
+            stats.MaxTime = std::max<uint32>(stats.MaxTime, itr.second.MaxTime);
+        }
+    }
+
+    std::vector<ProfileKeyStats> sorted;
+    sorted.reserve(keys.size());
+    for (std::pair<uint32 const, ProfileKeyStats> const& itr : keys)
+        sorted.push_back(itr.second);
+
+    std::sort(sorted.begin(), sorted.end(), [](ProfileKeyStats const& left, ProfileKeyStats const& right)
+    {
+        return left.Time > right.Time;
+    });
+
+    return sorted;
+}
+
+char const* Profiler::GetCategoryName(ProfileCategory category)
+{
+    switch (category)
+    {
+        case PROFILE_MAP:       return "map";
+        case PROFILE_CREATURE:  return "creature";
+        case PROFILE_SPELL:     return "spell";
+        case PROFILE_OPCODE:    return "opcode";
+        default:                return "none";
+    }
+}
+
+bool Profiler::WriteFiles(std::string const& name, bool tick)
+{
+    std::string foldedName = _logsDir + name + ".folded";
+    FILE* folded = fopen(foldedName.c_str(), "w");
+    if (!folded)
+    {
+        TC_LOG_ERROR("server", "Profiler: can't open %s for writing", foldedName.c_str());
+        return false;
+    }
+
+    for (std::pair<std::string, uint64> const& stack : GetStacks(tick))
+        fprintf(folded, "%s " UI64FMTD "\n", stack.first.c_str(), stack.second);
+
+    fclose(folded);
+
+    std::string keysName = _logsDir + name + ".txt";
+    FILE* keys = fopen(keysName.c_str(), "w");
+    if (!keys)
+    {
+        TC_LOG_ERROR("server", "Profiler: can't open %s for writing", keysName.c_str());
+        return false;
+    }
+
+    for (uint8 category = PROFILE_MAP; category < MAX_PROFILE_CATEGORY; ++category)
+    {
+        fprintf(keys, "%s                 time (us)      calls   max (us)\n", GetCategoryName(ProfileCategory(category)));
+        for (ProfileKeyStats const& stats : GetKeyStats(ProfileCategory(category), tick))
+            fprintf(keys, "%-10u %16" PRIu64 " %10" PRIu64 " %10u\n", stats.Key, stats.Time, stats.Calls, stats.MaxTime);
+        fprintf(keys, "\n");
+    }
+
+    fclose(keys);
+    return true;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PROFILER_H
+#define TRINITY_PROFILER_H
+
+#include "Define.h"
+#include <ace/Singleton.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define PROFILER_SPIKE_EXPORT_GAP       60                  // seconds between two exports of lag spikes
+
+// what the key of a keyed scope stands for
+enum ProfileCategory
+{
+    PROFILE_NONE,
+    PROFILE_MAP,                                            // map id
+    PROFILE_CREATURE,                                       // creature entry
+    PROFILE_SPELL,                                          // spell id
+    PROFILE_OPCODE,                                         // opcode
+    MAX_PROFILE_CATEGORY
+};
+
+struct ProfileCounter
+{
+    ProfileCounter() : Time(0), TickTime(0), Calls(0), TickCalls(0), MaxTime(0) { }
+
+    std::atomic<uint64> Time;                               // microseconds since the last export
+    std::atomic<uint64> TickTime;                           // microseconds since the last tick ended
+    std::atomic<uint64> Calls;
+    std::atomic<uint64> TickCalls;
+    std::atomic<uint32> MaxTime;
+
+    void Add(uint32 time);
+    void Reset();
+};
+
+struct ProfileNode
+{
+    ProfileNode(char const* name, uint32 parent) : Name(name), Parent(parent) { }
+
+    char const* Name;
+    uint32 Parent;
+    std::vector<std::pair<char const*, uint32>> Children;
+    ProfileCounter Counter;
+};
+
+// the scopes entered by one thread, only that thread adds to them
+struct ProfileThreadData
+{
+    ProfileThreadData() : Current(0) { Nodes.emplace_back("", 0); }
+
+    std::deque<ProfileNode> Nodes;                          // node 0 is the root, nodes are never removed
+    uint32 Current;
+    std::unordered_map<uint64, ProfileCounter> Keys;        // category << 32 | key
+    std::mutex Lock;                                        // adding nodes and keys, and reading them from another thread
+};
+
+struct ProfileKeyStats
+{
+    uint32 Key;
+    uint64 Time;
+    uint64 Calls;
+    uint32 MaxTime;
+};
+
+/*
+ * Hierarchical scoped timers for the world and map threads.
+ *
+ * A PROFILE_SCOPE adds its run time to a node of the calling thread's tree,
+ * found by the names of the scopes around it, so the counters need no lock.
+ * A keyed scope also adds it to the total of its key (a map id, a creature
+ * entry, ...) for the per-map and per-entry aggregates. With the profiler
+ * stopped a scope reads one atomic flag.
+ *
+ * The counters are exported as folded stacks ("a;b;c <microseconds>") that
+ * flamegraph.pl and speedscope read, next to a text file with the keyed
+ * aggregates. EndTick() is called by the world thread after every tick and
+ * exports the tick alone when it took longer than the spike threshold.
+ */
+class Profiler
+{
+    friend class ACE_Singleton<Profiler, ACE_Thread_Mutex>;
+
+    private:
+        Profiler();
+        ~Profiler() { }
+
+    public:
+        void Start();
+        void Stop();
+        static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+        void SetSpikeThreshold(uint32 threshold) { _spikeThreshold = threshold; }
+        uint32 GetSpikeThreshold() const { return _spikeThreshold; }
+
+        // the world thread, between two ticks
+        void EndTick(uint32 tickTime);
+        // writes the counters since the last export and resets them, returns the folded file or "" on failure
+        std::string Export();
+        void Reset();
+
+        std::string const& GetLastExport() const { return _lastExport; }
+        uint64 GetSpikes() const { return _spikes; }
+
+        // self time of every stack, the longest first
+        std::vector<std::pair<std::string, uint64>> GetStacks(bool tick = false);
+        std::vector<ProfileKeyStats> GetKeyStats(ProfileCategory category, bool tick = false);
+        static char const* GetCategoryName(ProfileCategory category);
+
+        static ProfileThreadData* GetThreadData();
+
+    private:
+        bool WriteFiles(std::string const& name, bool tick);
+
+        static std::atomic<bool> _enabled;
+
+        std::vector<std::unique_ptr<ProfileThreadData>> _threads;   // never shrinks, the data stays with its thread
+        std::mutex _threadsLock;
+
+        std::atomic<uint32> _spikeThreshold;                // milliseconds, 0 for none
+        time_t _lastSpikeExport;
+        uint64 _spikes;
+        std::string _lastExport;
+        std::string _logsDir;
+};
+
+#define sProfiler ACE_Singleton<Profiler, ACE_Thread_Mutex>::instance()
+
+class ProfileScope
+{
+    public:
+        explicit ProfileScope(char const* name, ProfileCategory category = PROFILE_NONE, uint32 key = 0) : _thread(NULL)
+        {
+            if (Profiler::IsEnabled())
+                Enter(name, category, key);
+        }
+
+        ~ProfileScope()
+        {
+            if (_thread)
+                Exit();
+        }
+
+    private:
+        void Enter(char const* name, ProfileCategory category, uint32 key);
+        void Exit();
+
+        ProfileThreadData* _thread;
+        uint32 _node;
+        uint32 _parent;
+        uint64 _key;
+        uint64 _start;
+};
+
+#define PROFILE_SCOPE_NAME(line) _profileScope##line
+#define PROFILE_SCOPE_LINE(line, ...) ProfileScope PROFILE_SCOPE_NAME(line)(__VA_ARGS__)
+// times the rest of the block: PROFILE_SCOPE("Map::Update") or PROFILE_SCOPE("Map::Update", PROFILE_MAP, GetId())
+#define PROFILE_SCOPE(...) PROFILE_SCOPE_LINE(__LINE__, __VA_ARGS__)
+
+#endif
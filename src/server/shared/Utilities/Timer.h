@@ -37,6 +37,15 @@ inline uint32 getMSTime()
     return uint32(duration_cast<milliseconds>(steady_clock::now() - ApplicationStartTime).count());
 }
 
+inline uint64 getUSTime()
+{
+    using namespace std::chrono;
+
+    static const steady_clock::time_point ApplicationStartTime = steady_clock::now();
+
+    return uint64(duration_cast<microseconds>(steady_clock::now() - ApplicationStartTime).count());
+}
+
 inline uint32 getMSTime_X()
 {
     static const SystemClock::time_point ApplicationStartTime = SystemClock::now();
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+TimerWheel::TimerWheel() : _now(0), _nextId(0), _running(0)
+{
+}
+
+TimerWheel::TaskId TimerWheel::Schedule(std::string const& name, uint32 interval, Callback&& callback)
+{
+    return AddTask(name, interval, interval, true, std::move(callback));
+}
+
+TimerWheel::TaskId TimerWheel::ScheduleOnce(std::string const& name, uint32 delay, Callback&& callback)
+{
+    return AddTask(name, delay, 0, false, std::move(callback));
+}
+
+TimerWheel::TaskId TimerWheel::AddTask(std::string const& name, uint32 delay, uint32 interval, bool repeating, Callback&& callback)
+{
+    // 0 is never handed out, callers use it for "no task"
+    if (!++_nextId)
+        ++_nextId;
+
+    Task& task = _tasks[_nextId];
+    task.Name = name;
+    task.Func = std::move(callback);
+    task.Due = _now + delay;
+    task.Interval = std::max<uint32>(interval, 1);
+    task.Repeating = repeating;
+    task.Cancelled = false;
+    task.Slot = -1;
+    task.Runs = 0;
+    task.TotalTime = 0;
+    task.MaxTime = 0;
+    memset(task.History, 0, sizeof(task.History));
+
+    Insert(_nextId, task);
+    return _nextId;
+}
+
+void TimerWheel::Reschedule(TaskId id, uint32 delay)
+{
+    std::unordered_map<TaskId, Task>::iterator itr = _tasks.find(id);
+    if (itr == _tasks.end() || itr->second.Cancelled)
+        return;
+
+    Remove(id, itr->second);
+    itr->second.Due = _now + delay;
+    Insert(id, itr->second);
+}
+
+void TimerWheel::SetInterval(TaskId id, uint32 interval)
+{
+    std::unordered_map<TaskId, Task>::iterator itr = _tasks.find(id);
+    if (itr == _tasks.end() || !itr->second.Repeating)
+        return;
+
+    itr->second.Interval = std::max<uint32>(interval, 1);
+    Reschedule(id, itr->second.Interval);
+}
+
+void TimerWheel::Cancel(TaskId id)
+{
+    std::unordered_map<TaskId, Task>::iterator itr = _tasks.find(id);
+    if (itr == _tasks.end())
+        return;
+
+    Remove(id, itr->second);
+
+    // the callback of a task that cancels itself is still running, Run() erases it
+    if (id == _running)
+        itr->second.Cancelled = true;
+    else
+        _tasks.erase(itr);
+}
+
+void TimerWheel::Update(uint32 diff)
+{
+    uint64 firstTick = _now / TIMER_WHEEL_RESOLUTION + 1;
+    _now += diff;
+    uint64 lastTick = _now / TIMER_WHEEL_RESOLUTION;
+
+    if (lastTick < firstTick)
+        return;
+
+    // a long diff turned the wheel more than once, every slot is looked at once
+    if (lastTick - firstTick >= TIMER_WHEEL_SLOTS)
+        lastTick = firstTick + TIMER_WHEEL_SLOTS - 1;
+
+    // the due tasks are taken out of the wheel first, so callbacks can add and move tasks freely
+    std::vector<std::pair<uint64, TaskId>> due;
+    for (uint64 tick = firstTick; tick <= lastTick; ++tick)
+    {
+        std::vector<TaskId>& slot = _slots[tick % TIMER_WHEEL_SLOTS];
+        for (size_t i = 0; i < slot.size();)
+        {
+            Task& task = _tasks[slot[i]];
+            if (task.Due > _now)                            // due in a later turn of the wheel
+            {
+                ++i;
+                continue;
+            }
+
+            due.push_back(std::make_pair(task.Due, slot[i]));
+            task.Slot = -1;
+            slot[i] = slot.back();
+            slot.pop_back();
+        }
+    }
+
+    std::sort(due.begin(), due.end());
+
+    for (std::pair<uint64, TaskId> const& entry : due)
+    {
+        std::unordered_map<TaskId, Task>::iterator itr = _tasks.find(entry.second);
+        // cancelled or moved by the callback of a task run before it
+        if (itr == _tasks.end() || itr->second.Slot >= 0)
+            continue;
+
+        Run(entry.second, itr->second);
+    }
+}
+
+void TimerWheel::Run(TaskId id, Task& task)
+{
+    _running = id;
+    uint64 start = getUSTime();
+
+    task.Func();
+
+    uint32 time = uint32(getUSTime() - start);
+    _running = 0;
+
+    task.History[task.Runs % TIMER_WHEEL_COST_HISTORY] = time;
+    ++task.Runs;
+    task.TotalTime += time;
+    task.MaxTime = std::max(task.MaxTime, time);
+
+    if (task.Cancelled || !task.Repeating)
+    {
+        // a task run once may have been moved to a later time by its callback
+        if (task.Cancelled || task.Slot < 0)
+            _tasks.erase(id);
+        return;
+    }
+
+    // moved by its callback
+    if (task.Slot >= 0)
+        return;
+
+    // keeps the phase of the interval, runs missed by a long diff are skipped
+    task.Due += task.Interval;
+    if (task.Due <= _now)
+        task.Due += ((_now - task.Due) / task.Interval + 1) * task.Interval;
+
+    Insert(id, task);
+}
+
+void TimerWheel::Insert(TaskId id, Task& task)
+{
+    // a slot is looked at once the clock passed its end, the tasks in it are all due then
+    uint64 tick = std::max((task.Due + TIMER_WHEEL_RESOLUTION - 1) / TIMER_WHEEL_RESOLUTION, _now / TIMER_WHEEL_RESOLUTION + 1);
+
+    task.Slot = int32(tick % TIMER_WHEEL_SLOTS);
+    _slots[task.Slot].push_back(id);
+}
+
+void TimerWheel::Remove(TaskId id, Task& task)
+{
+    if (task.Slot < 0)
+        return;
+
+    std::vector<TaskId>& slot = _slots[task.Slot];
+    std::vector<TaskId>::iterator itr = std::find(slot.begin(), slot.end(), id);
+    if (itr != slot.end())
+    {
+        *itr = slot.back();
+        slot.pop_back();
+    }
+
+    task.Slot = -1;
+}
+
+std::vector<TimerWheelTaskInfo> TimerWheel::GetTasks() const
+{
+    std::vector<TimerWheelTaskInfo> tasks;
+    tasks.reserve(_tasks.size());
+
+    for (std::pair<TaskId const, Task> const& itr : _tasks)
+    {
+        Task const& task = itr.second;
+        if (task.Cancelled)
+            continue;
+
+        TimerWheelTaskInfo info;
+        info.Id = itr.first;
+        info.Name = task.Name;
+        info.DueIn = task.Due > _now ? task.Due - _now : 0;
+        info.Interval = task.Repeating ? task.Interval : 0;
+        info.Runs = task.Runs;
+        info.TotalTime = task.TotalTime;
+        info.MaxTime = task.MaxTime;
+
+        for (uint64 run = task.Runs - std::min<uint64>(task.Runs, TIMER_WHEEL_COST_HISTORY); run < task.Runs; ++run)
+            info.History.push_back(task.History[run % TIMER_WHEEL_COST_HISTORY]);
+
+        tasks.push_back(info);
+    }
+
+    std::sort(tasks.begin(), tasks.end(), [](TimerWheelTaskInfo const& left, TimerWheelTaskInfo const& right)
+    {
+        return left.DueIn != right.DueIn ? left.DueIn < right.DueIn : left.Id < right.Id;
+    });
+
+    return tasks;
+}
+
+void TimerWheel::ResetCosts()
+{
+    for (std::pair<TaskId const, Task>& itr : _tasks)
+    {
+        itr.second.Runs = 0;
+        itr.second.TotalTime = 0;
+        itr.second.MaxTime = 0;
+        memset(itr.second.History, 0, sizeof(itr.second.History));
+    }
+}
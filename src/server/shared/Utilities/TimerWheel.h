@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TIMERWHEEL_H
+#define TRINITY_TIMERWHEEL_H
+
+#include "Define.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define TIMER_WHEEL_SLOTS               512                 // slots of one turn of the wheel
+#define TIMER_WHEEL_RESOLUTION          10                  // milliseconds covered by one slot
+#define TIMER_WHEEL_COST_HISTORY        8                   // last run times kept for every task
+
+struct TimerWheelTaskInfo
+{
+    uint32 Id;
+    std::string Name;
+    uint64 DueIn;                                           // milliseconds
+    uint32 Interval;                                        // 0 for tasks run once
+    uint64 Runs;
+    uint64 TotalTime;                                       // microseconds
+    uint32 MaxTime;
+    std::vector<uint32> History;                            // the last run times, oldest first
+};
+
+/*
+ * Hashed timer wheel for work due at a known time.
+ *
+ * Every task sits in the slot of its deadline, so Update() only looks at the
+ * slots the clock moved over and runs the tasks in them that are due, instead
+ * of polling every timer. A deadline further away than one turn of the wheel
+ * stays in its slot until a later turn reaches it.
+ *
+ * Tasks are named and the run time of each one is recorded, for the overview
+ * of the scheduled work. Not thread safe, tasks are added and run by the
+ * thread that calls Update().
+ */
+class TimerWheel
+{
+    public:
+        typedef uint32 TaskId;
+        typedef std::function<void()> Callback;
+
+        TimerWheel();
+
+        // runs the callback every interval milliseconds, the first time after one interval
+        TaskId Schedule(std::string const& name, uint32 interval, Callback&& callback);
+        // runs the callback once after delay milliseconds
+        TaskId ScheduleOnce(std::string const& name, uint32 delay, Callback&& callback);
+
+        // moves the next run of the task delay milliseconds from now
+        void Reschedule(TaskId id, uint32 delay);
+        // changes the interval of a repeating task, the next run is one interval from now
+        void SetInterval(TaskId id, uint32 interval);
+        void Cancel(TaskId id);
+        bool IsScheduled(TaskId id) const { return _tasks.find(id) != _tasks.end(); }
+
+        void Update(uint32 diff);
+
+        uint64 GetTime() const { return _now; }
+        std::vector<TimerWheelTaskInfo> GetTasks() const;   // ordered by deadline
+        void ResetCosts();
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            Callback Func;
+            uint64 Due;
+            uint32 Interval;
+            bool Repeating;
+            bool Cancelled;
+            int32 Slot;                                     // -1 while the task is out of the wheel to be run
+
+            uint64 Runs;
+            uint64 TotalTime;
+            uint32 MaxTime;
+            uint32 History[TIMER_WHEEL_COST_HISTORY];
+        };
+
+        TaskId AddTask(std::string const& name, uint32 delay, uint32 interval, bool repeating, Callback&& callback);
+        void Insert(TaskId id, Task& task);
+        void Remove(TaskId id, Task& task);
+        void Run(TaskId id, Task& task);
+
+        uint64 _now;
+        TaskId _nextId;
+        TaskId _running;
+        std::unordered_map<TaskId, Task> _tasks;
+        std::vector<TaskId> _slots[TIMER_WHEEL_SLOTS];
+};
+
+#endif
@@ -32,6 +32,9 @@
 #include "WorldRunnable.h"
 #include "OutdoorPvPMgr.h"
 #include "ThreadPoolMgr.hpp"
+#include "Profiler.h"
+#include "BotMgr.h"
+#include "ReplayMgr.h"
 
 #define WORLD_SLEEP_CONST 10
 
@@ -58,7 +61,14 @@ void WorldRunnable::run()
 
         uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
 
-        sWorld->Update( diff );
+        {
+            PROFILE_SCOPE("World::Update");
+            sWorld->Update( diff );
+        }
+        uint32 tickTime = getMSTimeDiff(realCurrTime, getMSTime());
+        sProfiler->EndTick(tickTime);
+        sBotMgr->RecordTick(tickTime);
+        sReplayMgr->RecordTick(tickTime);
         realPrevTime = realCurrTime;
 
         // diff (D0) include time of previous sleep (d0) + tick time (t0)
@@ -86,6 +96,8 @@ void WorldRunnable::run()
 
     sWorld->KickAll();                                       // save and kick all players
     sWorld->UpdateSessions( 1 );                             // real players unload required UpdateSessions call
+    sBotMgr->RemoveBots(0);                                  // bots are never saved
+    sReplayMgr->Stop();                                      // neither are the replayed characters
 
     // unload battleground templates before different singletons destroyed
     sBattlegroundMgr->DeleteAllBattlegrounds();
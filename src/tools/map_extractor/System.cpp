@@ -1,9 +1,15 @@
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <list>
 #include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #ifdef _WIN32
@@ -80,6 +86,9 @@ float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - l
 
 uint32 CONF_TargetBuild = 18273;              // 5.4.8 18273
 
+// Number of threads converting ADT files, 0 - use all hardware threads
+uint32 CONF_threads = 1;
+
 // List MPQ for extract maps from
 char const* CONF_mpq_list[] =
 {
@@ -151,6 +160,7 @@ void Usage(char const* prg)
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
         "-b target build (default %u)\n"\
+        "-t number of threads converting map files, 0 - all cores (default 1)\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, CONF_TargetBuild, prg);
     exit(1);
 }
@@ -165,6 +175,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - number of threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -204,6 +215,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                    CONF_threads = atoi(arg[c++ + 1]);
+                else
+                    Usage(arg[0]);
+                break;
             default:
                 break;
         }
@@ -426,27 +443,33 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+// StormLib archive handles are not thread safe, ADT files are read one at a time and only converted in parallel
+std::mutex MpqLock;
 
 bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/, uint32 build, HANDLE hTMP)
 {
     ADT_file adt;
 
-    if (!adt.loadFile(hTMP, filename))
-        return false;
+    {
+        std::lock_guard<std::mutex> lock(MpqLock);
+        if (!adt.loadFile(hTMP, filename))
+            return false;
+    }
 
     memset(liquid_show, 0, sizeof(liquid_show));
     memset(liquid_flags, 0, sizeof(liquid_flags));
@@ -989,6 +1012,16 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
     return true;
 }
 
+struct ADTJob
+{
+    ADTJob(std::string const& _mpqName, std::string const& _outputName, uint32 _y, uint32 _x) : mpqName(_mpqName), outputName(_outputName), y(_y), x(_x) { }
+
+    std::string mpqName;
+    std::string outputName;
+    uint32 y;
+    uint32 x;
+};
+
 void ExtractMapsFromMpq(uint32 build)
 {
     char mpq_filename[1024];
@@ -1005,7 +1038,8 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // every ADT is converted into its own .map file, so the order they are processed in does not change the output
+    std::vector<ADTJob> jobs;
     for (uint32 z = 0; z < map_ids.size(); ++z)
     {
         printf("Extract %s:%u (%d/%u)                  \n", map_ids[z].name.c_str(), map_ids[z].id, z+1, map_ids.size());
@@ -1025,15 +1059,54 @@ void ExtractMapsFromMpq(uint32 build)
 
                 sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name.c_str(), map_ids[z].name.c_str(), x, y);
                 sprintf(output_filename, "%s/maps/%04u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build, WorldMpq);
+                jobs.push_back(ADTJob(mpq_filename, output_filename, y, x));
             }
+        }
+    }
+
+    uint32 threads = CONF_threads ? CONF_threads : std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
+    if (threads > jobs.size())
+        threads = std::max<uint32>(1, jobs.size());
+
+    printf("Convert map files (%u ADT files, %u threads)\n", uint32(jobs.size()), threads);
+
+    std::atomic<uint32> nextJob(0);
+    std::atomic<uint32> doneJobs(0);
+    std::atomic<uint32> convertedJobs(0);
+    auto convert = [&jobs, &nextJob, &doneJobs, &convertedJobs, build](bool drawProgress)
+    {
+        for (uint32 i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+            ADTJob& job = jobs[i];
+            if (ConvertADT(&job.mpqName[0], &job.outputName[0], job.y, job.x, build, WorldMpq))
+                ++convertedJobs;
+            ++doneJobs;
 
             // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
+            if (drawProgress)
+                printf("Processing........................%u%%\r", (100 * doneJobs) / uint32(jobs.size()));
         }
-    }
+    };
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+        workers.push_back(std::thread(convert, false));
+
+    // the calling thread converts too and draws the progress bar
+    convert(true);
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    printf("Processing........................100%%\n");
+    printf("Converted %u of %u ADT files in %.1f s using %u threads (%.1f files/s)\n", uint32(convertedJobs), uint32(jobs.size()),
+        elapsed, threads, elapsed > 0.0 ? convertedJobs / elapsed : 0.0);
 
-    printf("\n");
     delete [] areas;
 }
 
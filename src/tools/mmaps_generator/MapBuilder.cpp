@@ -26,6 +26,9 @@
 #include "DetourNavMeshBuilder.h"
 #include "DetourCommon.h"
 
+#include "ThreadPoolMgr.hpp"
+#include "Timer.h"
+
 // These make the linker happy.
 LoginDatabaseWorkerPool LoginDatabase;
 uint32 GetLiquidFlags(uint32 liquidType)
@@ -46,9 +49,44 @@ using namespace VMAP;
 
 namespace MMAP
 {
+    // FNV-1a, good enough to notice changed input files
+    static const uint64 HASH_OFFSET_BASIS = UI64LIT(14695981039346656037);
+    static const uint64 HASH_PRIME = UI64LIT(1099511628211);
+
+    static uint64 hashData(uint64 hash, void const* data, size_t size)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= HASH_PRIME;
+        }
+        return hash;
+    }
+
+    static uint64 hashFile(uint64 hash, char const* fileName)
+    {
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+        {
+            // a file that appears or disappears changes the hash as well
+            unsigned char missing = 0xFF;
+            return hashData(hash, &missing, 1);
+        }
+
+        unsigned char buffer[64 * 1024];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hash = hashData(hash, buffer, count);
+
+        fclose(file);
+        return hash;
+    }
+
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath,
+        uint32 threads, bool incremental) :
     m_terrainBuilder(NULL),
         m_debugOutput        (debugOutput),
         m_skipContinents     (skipContinents),
@@ -57,12 +95,27 @@ namespace MMAP
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
         m_rcContext          (NULL),
-        m_offMeshFilePath    (offMeshFilePath)
+        m_offMeshFilePath    (offMeshFilePath),
+        m_threads            (threads),
+        m_incremental        (incremental),
+        m_settingsHash       (HASH_OFFSET_BASIS),
+        m_startTime          (0)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
+        // rcContext with logging and timers disabled keeps no state, the tile jobs can share it
         m_rcContext = new rcContext(false);
 
+        // anything changing the output of every tile
+        uint32 version = MMAP_VERSION;
+        bool usesLiquids = m_terrainBuilder->usesLiquids();
+        m_settingsHash = hashData(m_settingsHash, &version, sizeof(version));
+        m_settingsHash = hashData(m_settingsHash, &m_maxWalkableAngle, sizeof(m_maxWalkableAngle));
+        m_settingsHash = hashData(m_settingsHash, &m_bigBaseUnit, sizeof(m_bigBaseUnit));
+        m_settingsHash = hashData(m_settingsHash, &usesLiquids, sizeof(usesLiquids));
+        if (m_offMeshFilePath)
+            m_settingsHash = hashFile(m_settingsHash, m_offMeshFilePath);
+
         discoverTiles();
     }
 
@@ -159,12 +212,44 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildAllMaps()
     {
+        startWorkers();
+
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
-                buildMap(mapID);
+                queueMap(mapID);
         }
+
+        stopWorkers();
+    }
+
+    /**************************************************************************/
+    void MapBuilder::startWorkers()
+    {
+        m_startTime = getMSTime();
+        m_reports.clear();
+
+        if (m_threads > 1)
+        {
+            printf("Using %u threads\n", m_threads);
+            sThreadPoolMgr->start(m_threads);
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::stopWorkers()
+    {
+        if (m_threads > 1)
+        {
+            sThreadPoolMgr->wait();
+            sThreadPoolMgr->stop();
+        }
+
+        printf("\nBuild report:\n");
+        for (vector<string>::const_iterator itr = m_reports.begin(); itr != m_reports.end(); ++itr)
+            printf("%s\n", itr->c_str());
+        printf("Total time: %u ms\n\n", GetMSTimeDiffToNow(m_startTime));
     }
 
     /**************************************************************************/
@@ -224,6 +309,14 @@ namespace MMAP
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
+    {
+        startWorkers();
+        queueMap(mapID);
+        stopWorkers();
+    }
+
+    /**************************************************************************/
+    void MapBuilder::queueMap(uint32 mapID)
     {
         printf("Building map %04u:\n", mapID);
 
@@ -256,26 +349,153 @@ namespace MMAP
 
         // now start building mmtiles for each tile
         printf("We have %u tiles.                          \n", (unsigned int)tiles->size());
-        for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+
+        // the set may still grow for other maps, take a copy before the jobs start
+        vector<uint32> tileIds(tiles->begin(), tiles->end());
+        MapBuildContext* context = new MapBuildContext(mapID, navMesh, uint32(tileIds.size()));
+        context->startTime = getMSTime();
+
+        for (vector<uint32>::const_iterator it = tileIds.begin(); it != tileIds.end(); ++it)
         {
             uint32 tileX, tileY;
 
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
-                continue;
+            if (m_threads > 1)
+                sThreadPoolMgr->schedule([this, context, tileX, tileY] { buildTileJob(context, tileX, tileY); });
+            else
+                buildTileJob(context, tileX, tileY);
+        }
+    }
 
-            buildTile(mapID, tileX, tileY, navMesh);
+    /**************************************************************************/
+    void MapBuilder::buildTileJob(MapBuildContext* context, uint32 tileX, uint32 tileY)
+    {
+        uint32 mapID = context->mapID;
+        uint64 hash = 0;
+        bool skip;
+
+        if (m_incremental)
+        {
+            uint64 oldHash;
+            bool hasFile;
+            hash = getTileInputHash(mapID, tileX, tileY);
+            skip = readTileHash(mapID, tileX, tileY, oldHash, hasFile) && oldHash == hash;
+
+            // a tile file deleted since is built again
+            if (skip && hasFile)
+                skip = shouldSkipTile(mapID, tileX, tileY);
         }
+        else
+            skip = shouldSkipTile(mapID, tileX, tileY);
 
-        dtFreeNavMesh(navMesh);
+        if (skip)
+            ++context->tilesSkipped;
+        else
+        {
+            uint32 tileStart = getMSTime();
+
+            if (buildTile(mapID, tileX, tileY, context->navMesh))
+            {
+                // written for empty tiles as well, so they are not loaded again until their inputs change,
+                // with whether a valid tile file is there to check for the next run
+                if (m_incremental)
+                    writeTileHash(mapID, tileX, tileY, hash, shouldSkipTile(mapID, tileX, tileY));
+
+                ++context->tilesBuilt;
+            }
+            else
+                ++context->tilesFailed;     // no hash, built again by the next run
+
+            context->tileTime += GetMSTimeDiffToNow(tileStart);
+        }
+
+        if (--context->tilesLeft == 0)
+            finishMap(context);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::finishMap(MapBuildContext* context)
+    {
+        char report[256];
+        sprintf(report, "Map %04u: %u tiles built, %u skipped, %u failed, %u ms elapsed, " UI64FMTD " ms tile build time",
+            context->mapID, context->tilesBuilt.load(), context->tilesSkipped.load(), context->tilesFailed.load(),
+            GetMSTimeDiffToNow(context->startTime), context->tileTime.load());
+
+        printf("%s\n", report);
+
+        {
+            std::lock_guard<std::mutex> guard(m_reportLock);
+            m_reports.push_back(report);
+        }
+
+        dtFreeNavMesh(context->navMesh);
+        delete context;
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        char fileName[255];
+        uint64 hash = m_settingsHash;
+
+        // TerrainBuilder::loadMap reads the tile and the borders of its neighbours
+        int const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (int i = 0; i < 5; ++i)
+        {
+            sprintf(fileName, "maps/%04u%02u%02u.map", mapID, tileY + neighbours[i][1], tileX + neighbours[i][0]);
+            hash = hashFile(hash, fileName);
+        }
 
-        printf("Complete!                               \n\n");
+        // TerrainBuilder::loadVMap gets the tile coords swapped
+        sprintf(fileName, "vmaps/%04u.vmtree", mapID);
+        hash = hashFile(hash, fileName);
+        hash = hashFile(hash, ("vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX)).c_str());
+
+        return hash;
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    bool MapBuilder::readTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 &hash, bool &hasFile)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        uint8 fileFlag = 0;
+        bool result = fread(&hash, sizeof(hash), 1, file) == 1 && fread(&fileFlag, sizeof(fileFlag), 1, file) == 1;
+        fclose(file);
+
+        hasFile = fileFlag != 0;
+        return result;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::writeTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 hash, bool hasFile)
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "Failed to open %s for writing!\n", fileName);
+            perror(message);
+            return;
+        }
+
+        // whether the build wrote a tile file, empty tiles have none
+        uint8 fileFlag = hasFile ? 1 : 0;
+        fwrite(&hash, sizeof(hash), 1, file);
+        fwrite(&fileFlag, sizeof(fileFlag), 1, file);
+        fclose(file);
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         printf("Building map %04u, tile [%02u,%02u]\n", mapID, tileX, tileY);
 
@@ -289,7 +509,7 @@ namespace MMAP
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-            return;
+            return true;
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -301,7 +521,7 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-            return;
+            return true;
 
         // get bounds of current tile
         float bmin[3], bmax[3];
@@ -310,7 +530,7 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        return buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
     }
 
     /**************************************************************************/
@@ -390,7 +610,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    bool MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -400,6 +620,7 @@ namespace MMAP
         printf("%s Building movemap tiles...                        \r", tileString);
 
         IntermediateValues iv;
+        bool failed = false;                // the empty tiles aren't failures
 
         float* tVerts = meshData.solidVerts.getCArray();
         int tVertCount = meshData.solidVerts.size() / 3;
@@ -480,6 +701,7 @@ namespace MMAP
                 if (!tile.solid || !rcCreateHeightfield(m_rcContext, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
                 {
                     printf("%sFailed building heightfield!            \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -501,6 +723,7 @@ namespace MMAP
                 if (!tile.chf || !rcBuildCompactHeightfield(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
                 {
                     printf("%sFailed compacting heightfield!            \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -508,18 +731,21 @@ namespace MMAP
                 if (!rcErodeWalkableArea(m_rcContext, config.walkableRadius, *tile.chf))
                 {
                     printf("%sFailed eroding area!                    \n", tileString);
+                    failed = true;
                     continue;
                 }
 
                 if (!rcBuildDistanceField(m_rcContext, *tile.chf))
                 {
                     printf("%sFailed building distance field!         \n", tileString);
+                    failed = true;
                     continue;
                 }
 
                 if (!rcBuildRegions(m_rcContext, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
                 {
                     printf("%sFailed building regions!                \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -527,6 +753,7 @@ namespace MMAP
                 if (!tile.cset || !rcBuildContours(m_rcContext, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
                 {
                     printf("%sFailed building contours!               \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -535,6 +762,7 @@ namespace MMAP
                 if (!tile.pmesh || !rcBuildPolyMesh(m_rcContext, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
                 {
                     printf("%sFailed building polymesh!               \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -542,6 +770,7 @@ namespace MMAP
                 if (!tile.dmesh || !rcBuildPolyMeshDetail(m_rcContext, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg    .detailSampleMaxError, *tile.dmesh))
                 {
                     printf("%sFailed building polymesh detail!        \n", tileString);
+                    failed = true;
                     continue;
                 }
 
@@ -562,14 +791,14 @@ namespace MMAP
         if (!pmmerge)
         {
             printf("%s alloc pmmerge FIALED!          \r", tileString);
-            return;
+            return false;
         }
 
         rcPolyMeshDetail** dmmerge = new rcPolyMeshDetail*[TILES_PER_MAP * TILES_PER_MAP];
         if (!dmmerge)
         {
             printf("%s alloc dmmerge FIALED!          \r", tileString);
-            return;
+            return false;
         }
 
         int nmerge = 0;
@@ -591,7 +820,7 @@ namespace MMAP
         if (!iv.polyMesh)
         {
             printf("%s alloc iv.polyMesh FIALED!          \r", tileString);
-            return;
+            return false;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -599,7 +828,7 @@ namespace MMAP
         if (!iv.polyMeshDetail)
         {
             printf("%s alloc m_dmesh FIALED!          \r", tileString);
-            return;
+            return false;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -668,11 +897,13 @@ namespace MMAP
             if (params.nvp > DT_VERTS_PER_POLYGON)
             {
                 printf("%s Invalid verts-per-polygon value!        \n", tileString);
+                failed = true;
                 continue;
             }
             if (params.vertCount >= 0xffff)
             {
                 printf("%s Too many vertices!                      \n", tileString);
+                failed = true;
                 continue;
             }
             if (!params.vertCount || !params.verts)
@@ -703,6 +934,7 @@ namespace MMAP
             if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
             {
                 printf("%s Failed building navmesh tile!           \n", tileString);
+                failed = true;
                 continue;
             }
 
@@ -710,10 +942,15 @@ namespace MMAP
             printf("%s Adding tile to navmesh...                \r", tileString);
             // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
             // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+            dtStatus dtResult;
+            {
+                std::lock_guard<std::mutex> guard(m_navMeshLock);
+                dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+            }
             if (!tileRef || dtResult != DT_SUCCESS)
             {
                 printf("%s Failed adding tile to navmesh!           \n", tileString);
+                failed = true;
                 continue;
             }
 
@@ -726,6 +963,8 @@ namespace MMAP
                 char message[1024];
                 sprintf(message, "Failed to open %s for writing!\n", fileName);
                 perror(message);
+                failed = true;
+                std::lock_guard<std::mutex> guard(m_navMeshLock);
                 navMesh->removeTile(tileRef, NULL, NULL);
                 continue;
             }
@@ -743,6 +982,7 @@ namespace MMAP
             fclose(file);
 
             // now that tile is written to disk, we can unload it
+            std::lock_guard<std::mutex> guard(m_navMeshLock);
             navMesh->removeTile(tileRef, NULL, NULL);
         }
         while (0);
@@ -760,6 +1000,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return !failed;
     }
 
     /**************************************************************************/
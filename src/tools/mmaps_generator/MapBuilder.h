@@ -22,6 +22,8 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <atomic>
+#include <mutex>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -58,6 +60,22 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    // shared by the tile jobs of one map, the last finished job prints the report and frees it
+    struct MapBuildContext
+    {
+        MapBuildContext(uint32 id, dtNavMesh* mesh, uint32 tiles) : mapID(id), navMesh(mesh), tilesLeft(tiles),
+            tilesBuilt(0), tilesSkipped(0), tilesFailed(0), tileTime(0), startTime(0) {}
+
+        uint32 mapID;
+        dtNavMesh* navMesh;
+        std::atomic<uint32> tilesLeft;
+        std::atomic<uint32> tilesBuilt;
+        std::atomic<uint32> tilesSkipped;
+        std::atomic<uint32> tilesFailed;
+        std::atomic<uint64> tileTime;       // summed build time of the tiles, in ms
+        uint32 startTime;
+    };
+
     class MapBuilder
     {
         public:
@@ -68,7 +86,9 @@ namespace MMAP
                 bool skipBattlegrounds   = false,
                 bool debugOutput         = false,
                 bool bigBaseUnit         = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                uint32 threads           = 1,
+                bool incremental         = false);
 
             ~MapBuilder();
 
@@ -88,10 +108,23 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            // tile jobs run on sThreadPoolMgr when more than one thread is used
+            void startWorkers();
+            void stopWorkers();
+            void queueMap(uint32 mapID);
+            void buildTileJob(MapBuildContext* context, uint32 tileX, uint32 tileY);
+            void finishMap(MapBuildContext* context);
+
+            // false when the tile failed, an empty tile is built without a file
+            bool buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+
+            // incremental mode, a tile is rebuilt only when the hash of its inputs changed or its file is gone
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            bool readTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 &hash, bool &hasFile);
+            void writeTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 hash, bool hasFile);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            bool buildMoveMapTile(uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -121,6 +154,14 @@ namespace MMAP
             float m_maxWalkableAngle;
             bool m_bigBaseUnit;
 
+            uint32 m_threads;
+            bool m_incremental;
+            uint64 m_settingsHash;          // build settings and off mesh input, part of every tile hash
+            std::mutex m_navMeshLock;       // dtNavMesh::addTile/removeTile are not thread safe
+            std::mutex m_reportLock;
+            vector<string> m_reports;
+            uint32 m_startTime;
+
             // build performance - not really used for now
             rcContext* m_rcContext;
     };